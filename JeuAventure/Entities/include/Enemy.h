@@ -96,6 +96,7 @@ private:
     void updateWanderBehavior(float dt);
 
     void checkForTarget(float dt);
+    bool canSee(const Entity* target) const;
     void moveTowards(const sf::Vector2f& target, float speed);
     void moveAway(const sf::Vector2f& target, float speed);
     float distanceTo(const sf::Vector2f& point) const;
@@ -4,11 +4,13 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
 #include "Collider.h"
 #include "PhysicsEngine.h"
 #include "DamageSystem.h"
 
 class Animation;
+class SpriteBatch;
 
 enum class EntityType {
     None,
@@ -56,12 +58,19 @@ protected:
     float m_jumpForce;
     bool m_canJump;
     bool m_isGrounded;
+    // Platform colliders currently supporting the entity. Merged terrain is
+    // made of adjacent rectangles, so walking over a seam enters the next
+    // one before leaving the previous one.
+    std::vector<const Collider*> m_groundContacts;
 
     std::unique_ptr<PhysicsBody> m_physicsBody;
     std::unique_ptr<Collider> m_collider;
+    // False for static trigger entities: they get no physics body or
+    // collider and are driven by the level's TriggerVolumeSystem instead.
+    bool m_usesPhysics;
 
     sf::Sprite m_sprite;
-    std::unique_ptr<sf::Texture> m_texture;
+    const sf::Texture* m_texture;
     std::map<std::string, std::unique_ptr<Animation>> m_animations;
     std::string m_currentAnimation;
 
@@ -78,6 +87,7 @@ public:
 
     virtual void update(float dt);
     virtual void render(sf::RenderWindow& window);
+    virtual void render(SpriteBatch& batch);
     virtual void handleEvents(const sf::Event& event);
     virtual void initialize();
 
@@ -141,6 +151,9 @@ public:
     virtual void onCollisionEnter(Collider* other);
     virtual void onCollisionExit(Collider* other);
 
+    virtual void onTriggerEnter(Entity* activator);
+    virtual void onTriggerExit(Entity* activator);
+
     virtual bool takeDamage(const DamageInfo& damageInfo);
     virtual void heal(int amount);
     virtual void kill();
@@ -184,4 +197,6 @@ protected:
     virtual void updatePhysics(float dt);
     virtual void updateAnimation(float dt);
     virtual void updateInvulnerability(float dt);
+
+    bool loadSpriteTexture(const std::string& textureKey, const std::string& filename);
 };
@@ -22,6 +22,14 @@ protected:
 
     std::function<void(Entity*)> m_onInteractCallback;
 
+    // The level trigger volume covering getBounds(), if one was registered.
+    // update() moves it along when the object moves or resizes.
+    int m_triggerVolume;
+    sf::FloatRect m_triggerBounds;
+
+    void registerTriggerVolume();
+    void syncTriggerVolume();
+
 public:
     GameplayObject(ObjectType type = ObjectType::Decoration);
 
@@ -138,7 +146,7 @@ public:
     void setToggling(bool toggling, float interval = 2.0f);
     bool isToggling() const;
 
-    void onCollisionEnter(Collider* other) override;
+    void onTriggerEnter(Entity* activator) override;
 };
 
 class Trigger : public GameplayObject {
@@ -166,5 +174,5 @@ public:
 
     void setTriggerCallback(const std::function<void(Entity*)>& callback);
 
-    void onCollisionEnter(Collider* other) override;
+    void onTriggerEnter(Entity* activator) override;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Entity.h"
+#include "Animation.h"
 #include <unordered_map>
 #include <SFML/Graphics.hpp>
 
@@ -22,6 +23,7 @@ public:
     void initialize() override;
     void update(float dt) override;
     void render(sf::RenderWindow& window) override;
+    void render(SpriteBatch& batch) override;
     void handleEvents(const sf::Event& event) override;
 
     void move(float x, float y);
@@ -29,6 +31,7 @@ public:
     void attack();
     void dash();
     void interact();
+    void dig();
 
     void setAction(PlayerAction action, bool active);
     bool isActionActive(PlayerAction action) const;
@@ -75,6 +78,9 @@ private:
 
     std::unordered_map<PlayerAction, bool> m_actions;
     sf::RectangleShape m_playerRect;
+    // Drawn from the player_idle atlas region; the rectangle stands in when
+    // the sheet is missing.
+    Animation m_idleAnimation;
 
     int m_coins;
     int m_score;
@@ -3,6 +3,8 @@
 #include "EventSystem.h"
 #include "RessourceManager.h"
 #include "Player.h"
+#include "Level.h"
+#include "Tilemap.h"
 #include <iostream>
 #include <cmath>
 
@@ -383,7 +385,7 @@ void Enemy::onDeath() {
     if (rand() % 100 < dropChance) {
         EventSystem::getInstance()->triggerEvent("CreatePickup", {
             {"position", m_position},
-            {"type", (rand() % 2 == 0) ? "health" : "coin"}
+            {"type", (rand() % 2 == 0) ? "health" : "Bitcoin"}
             });
     }
 
@@ -492,7 +494,7 @@ void Enemy::checkForTarget(float dt) {
     if (m_target && m_target->getType() == EntityType::Player) {
         float distance = distanceTo(m_target->getPosition());
 
-        if (distance < m_detectionRange) {
+        if (distance < m_detectionRange && canSee(m_target)) {
             if (m_behavior != EnemyBehavior::Chase && m_behavior != EnemyBehavior::Attack) {
                 m_behavior = EnemyBehavior::Chase;
 
@@ -505,6 +507,20 @@ void Enemy::checkForTarget(float dt) {
     }
 }
 
+// Terrain between the two bounds centres blocks sight; without a tilemap
+// every target in range is visible.
+bool Enemy::canSee(const Entity* target) const {
+    Level* level = getLevel();
+    Tilemap* tilemap = level ? level->getTilemap() : nullptr;
+    if (!tilemap) return true;
+
+    sf::FloatRect own = getBounds();
+    sf::FloatRect other = target->getBounds();
+    return tilemap->hasLineOfSight(
+        sf::Vector2f(own.left + own.width / 2.0f, own.top + own.height / 2.0f),
+        sf::Vector2f(other.left + other.width / 2.0f, other.top + other.height / 2.0f));
+}
+
 void Enemy::moveTowards(const sf::Vector2f& target, float speed) {
     sf::Vector2f direction = target - m_position;
     float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
@@ -618,8 +634,6 @@ void Enemy::updateAnimationState() {
 }
 
 void Enemy::loadAnimations() {
-    RessourceManager* resourceManager = RessourceManager::getInstance();
-
     std::string textureKey = "enemy_basic_idle";
     switch (m_enemyType) {
     case EnemyType::Flying:
@@ -639,9 +653,5 @@ void Enemy::loadAnimations() {
         break;
     }
 
-    if (resourceManager->loadTexture(textureKey, "Assets/Textures/" + textureKey + ".png")) {
-        m_texture = std::make_unique<sf::Texture>(*resourceManager->getTexture(textureKey));
-        m_sprite.setTexture(*m_texture);
-        m_sprite.setOrigin(m_texture->getSize().x / 2.0f, m_texture->getSize().y / 2.0f);
-    }
+    loadSpriteTexture(textureKey, "Assets/Textures/" + textureKey + ".png");
 }
@@ -3,6 +3,8 @@
 #include "DamageSystem.h"
 #include "EventSystem.h"
 #include "RessourceManager.h"
+#include "SpriteBatch.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -39,6 +41,8 @@ Entity::Entity(EntityType type)
     m_jumpForce(500.0f),
     m_canJump(true),
     m_isGrounded(false),
+    m_usesPhysics(true),
+    m_texture(nullptr),
     m_health(100),
     m_maxHealth(100),
     m_invulnerable(false),
@@ -83,10 +87,30 @@ void Entity::render(sf::RenderWindow& window) {
     }
 }
 
+void Entity::render(SpriteBatch& batch) {
+    if (!m_visible) return;
+
+    if (m_texture) {
+        batch.draw(m_sprite);
+    }
+    else {
+        sf::Transform transform;
+        transform.translate(m_position);
+        transform.rotate(m_rotation);
+        transform.translate(-m_size.x / 2.0f, -m_size.y / 2.0f);
+        batch.drawRect(m_size, transform, m_color);
+    }
+}
+
 void Entity::handleEvents(const sf::Event& event) {
 }
 
 void Entity::initialize() {
+    if (!m_usesPhysics) {
+        onSpawn();
+        return;
+    }
+
     if (!m_physicsBody) {
         m_physicsBody = std::make_unique<PhysicsBody>(this);
         PhysicsEngine::getInstance()->registerBody(m_physicsBody.get());
@@ -406,8 +430,9 @@ Collider* Entity::getCollider() const {
     return m_collider.get();
 }
 
+// Platform contacts don't need an owner: static terrain colliders have none.
 void Entity::onCollisionEnter(Collider* other) {
-    if (!other || !other->getOwner()) return;
+    if (!other) return;
 
     if (other->getCollisionLayer() & static_cast<int>(CollisionLayer::Platform)) {
         sf::FloatRect thisBounds = getBounds();
@@ -416,8 +441,13 @@ void Entity::onCollisionEnter(Collider* other) {
         float thisBottom = thisBounds.top + thisBounds.height;
         float thisHorizontalCenter = thisBounds.left + thisBounds.width / 2.0f;
 
-        if (std::abs(thisBottom - otherBounds.top) < 10.0f &&
-            thisHorizontalCenter >= otherBounds.left &&
+        if (std::abs(thisBottom - otherBounds.top) >= 10.0f) return;
+
+        // Counted as a contact even before the centre is over it, so walking
+        // onto the next collider keeps the entity grounded.
+        m_groundContacts.push_back(other);
+
+        if (thisHorizontalCenter >= otherBounds.left &&
             thisHorizontalCenter <= otherBounds.left + otherBounds.width) {
 
             m_isGrounded = true;
@@ -435,9 +465,12 @@ void Entity::onCollisionEnter(Collider* other) {
 }
 
 void Entity::onCollisionExit(Collider* other) {
-    if (!other || !other->getOwner()) return;
+    if (!other) return;
 
     if (other->getCollisionLayer() & static_cast<int>(CollisionLayer::Platform)) {
+        m_groundContacts.erase(std::remove(m_groundContacts.begin(), m_groundContacts.end(), other), m_groundContacts.end());
+        if (!m_groundContacts.empty()) return;
+
         m_isGrounded = false;
 
         if (m_physicsBody) {
@@ -450,6 +483,12 @@ void Entity::onCollisionExit(Collider* other) {
     }
 }
 
+void Entity::onTriggerEnter(Entity*) {
+}
+
+void Entity::onTriggerExit(Entity*) {
+}
+
 bool Entity::takeDamage(const DamageInfo& damageInfo) {
     if (m_invulnerable || m_state == EntityState::Dead) return false;
 
@@ -658,6 +697,7 @@ void Entity::updatePhysics(float dt) {
         sf::Vector2f vel = m_physicsBody->getVelocity();
         if (vel.y > 50.0f) {
             m_isGrounded = false;
+            m_groundContacts.clear();
             setState(EntityState::Falling);
         }
     }
@@ -698,3 +738,25 @@ void Entity::updateInvulnerability(float dt) {
         }
     }
 }
+
+bool Entity::loadSpriteTexture(const std::string& textureKey, const std::string& filename) {
+    RessourceManager* resourceManager = RessourceManager::getInstance();
+
+    AtlasRegion region = resourceManager->loadAtlasRegion(textureKey, filename);
+    if (region.isValid()) {
+        m_texture = region.texture;
+        m_sprite.setTexture(*m_texture);
+        m_sprite.setTextureRect(region.rect);
+    }
+    else if (resourceManager->loadTexture(textureKey, filename)) {
+        m_texture = resourceManager->getTexture(ResourceId(textureKey));
+        m_sprite.setTexture(*m_texture, true);
+    }
+    else {
+        return false;
+    }
+
+    sf::IntRect rect = m_sprite.getTextureRect();
+    m_sprite.setOrigin(rect.width / 2.0f, rect.height / 2.0f);
+    return true;
+}
@@ -1,13 +1,16 @@
 #include "Objects.h"
 #include "EventSystem.h"
 #include "RessourceManager.h"
+#include "Level.h"
+#include "TriggerVolumeSystem.h"
 #include <iostream>
 #include <cmath>
 
 GameplayObject::GameplayObject(ObjectType type)
     : Entity(EntityType::None),
     m_objectType(type),
-    m_isInteractable(false)
+    m_isInteractable(false),
+    m_triggerVolume(-1)
 {
     m_name = "Object";
 
@@ -49,6 +52,26 @@ GameplayObject::GameplayObject(ObjectType type)
 
 void GameplayObject::update(float dt) {
     Entity::update(dt);
+    syncTriggerVolume();
+}
+
+void GameplayObject::registerTriggerVolume() {
+    if (!m_level) return;
+
+    TriggerVolumeSystem* volumes = m_level->getTriggerVolumes();
+    volumes->removeVolume(m_triggerVolume);
+    m_triggerBounds = getBounds();
+    m_triggerVolume = volumes->addVolume(this, m_triggerBounds);
+}
+
+void GameplayObject::syncTriggerVolume() {
+    if (m_triggerVolume < 0 || !m_level) return;
+
+    sf::FloatRect bounds = getBounds();
+    if (bounds != m_triggerBounds) {
+        m_triggerBounds = bounds;
+        m_level->getTriggerVolumes()->moveVolume(m_triggerVolume, bounds);
+    }
 }
 
 void GameplayObject::initialize() {
@@ -157,13 +180,9 @@ void Pickup::initialize() {
         m_collider->setIsTrigger(true);
     }
 
-    RessourceManager* resourceManager = RessourceManager::getInstance();
     std::string textureKey = "pickup_" + m_pickupType;
 
-    if (resourceManager->loadTexture(textureKey, textureKey + ".png")) {
-        m_texture = std::make_unique<sf::Texture>(*resourceManager->getTexture(textureKey));
-        m_sprite.setTexture(*m_texture);
-        m_sprite.setOrigin(m_texture->getSize().x / 2.0f, m_texture->getSize().y / 2.0f);
+    if (loadSpriteTexture(textureKey, textureKey + ".png")) {
         m_sprite.setScale(0.05f, 0.05f);
     }
 }
@@ -292,18 +311,13 @@ void Platform::initialize() {
         m_waypoints.push_back(m_position);
     }
 
-    RessourceManager* resourceManager = RessourceManager::getInstance();
     std::string textureKey = m_isMoving ? "platform_moving" : "platform_static";
 
     if (m_isFalling) {
         textureKey = "platform_falling";
     }
 
-    if (resourceManager->loadTexture(textureKey, "Ressources/" + textureKey + ".png")) {
-        m_texture = std::make_unique<sf::Texture>(*resourceManager->getTexture(textureKey));
-        m_sprite.setTexture(*m_texture);
-        m_sprite.setOrigin(m_texture->getSize().x / 2.0f, m_texture->getSize().y / 2.0f);
-    }
+    loadSpriteTexture(textureKey, "Ressources/" + textureKey + ".png");
 }
 
 void Platform::setMoving(bool moving) {
@@ -419,6 +433,7 @@ Hazard::Hazard(int damage)
     m_name = "Hazard";
     m_size = sf::Vector2f(32.0f, 32.0f);
     m_color = sf::Color(255, 50, 50);
+    m_usesPhysics = false;
 }
 
 void Hazard::update(float dt) {
@@ -448,18 +463,11 @@ void Hazard::update(float dt) {
 void Hazard::initialize() {
     GameplayObject::initialize();
 
-    if (m_collider) {
-        m_collider->setIsTrigger(true);
-    }
+    registerTriggerVolume();
 
-    RessourceManager* resourceManager = RessourceManager::getInstance();
     std::string textureKey = "hazard_spikes";
 
-    if (resourceManager->loadTexture(textureKey, "Assets/Textures/" + textureKey + ".png")) {
-        m_texture = std::make_unique<sf::Texture>(*resourceManager->getTexture(textureKey));
-        m_sprite.setTexture(*m_texture);
-        m_sprite.setOrigin(m_texture->getSize().x / 2.0f, m_texture->getSize().y / 2.0f);
-    }
+    loadSpriteTexture(textureKey, "Assets/Textures/" + textureKey + ".png");
 }
 
 void Hazard::setDamage(int damage) {
@@ -504,13 +512,11 @@ bool Hazard::isToggling() const {
     return m_isToggling;
 }
 
-void Hazard::onCollisionEnter(Collider* other) {
-    if (!m_isActive || !other || !other->getOwner()) return;
+void Hazard::onTriggerEnter(Entity* activator) {
+    if (!m_isActive || !activator) return;
 
-    Entity* otherEntity = static_cast<Entity*>(other->getOwner());
-
-    if (otherEntity->getType() == EntityType::Player) {
-        sf::Vector2f knockbackDir = otherEntity->getPosition() - m_position;
+    if (activator->getType() == EntityType::Player) {
+        sf::Vector2f knockbackDir = activator->getPosition() - m_position;
         float length = std::sqrt(knockbackDir.x * knockbackDir.x + knockbackDir.y * knockbackDir.y);
 
         if (length > 0) {
@@ -527,7 +533,7 @@ void Hazard::onCollisionEnter(Collider* other) {
         damageInfo.knockbackDirection = knockbackDir;
         damageInfo.type = "hazard";
 
-        otherEntity->takeDamage(damageInfo);
+        activator->takeDamage(damageInfo);
 
         playSound("hazard_hit", 1.0f);
     }
@@ -542,6 +548,7 @@ Trigger::Trigger(bool triggerOnce)
     m_name = "Trigger";
     m_size = sf::Vector2f(64.0f, 64.0f);
     m_color = sf::Color(0, 255, 255, 100);
+    m_usesPhysics = false;
 }
 
 void Trigger::update(float dt) {
@@ -551,9 +558,7 @@ void Trigger::update(float dt) {
 void Trigger::initialize() {
     GameplayObject::initialize();
 
-    if (m_collider) {
-        m_collider->setIsTrigger(true);
-    }
+    registerTriggerVolume();
 
     m_visible = false;
 }
@@ -586,23 +591,21 @@ void Trigger::setTriggerCallback(const std::function<void(Entity*)>& callback) {
     m_triggerCallback = callback;
 }
 
-void Trigger::onCollisionEnter(Collider* other) {
+void Trigger::onTriggerEnter(Entity* activator) {
     if (m_isTriggered && m_triggerOnce) return;
 
-    if (!other || !other->getOwner()) return;
-
-    Entity* otherEntity = static_cast<Entity*>(other->getOwner());
+    if (!activator) return;
 
-    if (otherEntity->getType() == EntityType::Player) {
+    if (activator->getType() == EntityType::Player) {
         m_isTriggered = true;
 
         if (m_triggerCallback) {
-            m_triggerCallback(otherEntity);
+            m_triggerCallback(activator);
         }
 
         EventSystem::getInstance()->triggerEvent("TriggerActivated", {
             {"trigger", this},
-            {"activator", otherEntity},
+            {"activator", activator},
             {"tag", m_triggerTag}
             });
 
@@ -4,6 +4,7 @@
 #include "EventSystem.h"
 #include "RessourceManager.h"
 #include "Animation.h"
+#include "SpriteBatch.h"
 #include <iostream>
 
 Player::Player()
@@ -73,6 +74,7 @@ void Player::initialize() {
     }
 
     resetJumps();
+    loadAnimations();
 }
 
 void Player::update(float dt) {
@@ -112,11 +114,23 @@ void Player::update(float dt) {
     }
     updatePlayerVisuals();
 
+    if (m_idleAnimation.isValid()) {
+        m_idleAnimation.setFlipHorizontal(!m_facingRight);
+        m_idleAnimation.update(dt);
+        m_idleAnimation.apply(m_sprite);
+    }
+
     Entity::update(dt);
 }
 
 
 void Player::render(sf::RenderWindow& window) {
+    if (m_idleAnimation.isValid()) {
+        m_sprite.setPosition(m_position);
+        window.draw(m_sprite);
+        return;
+    }
+
     m_playerRect.setPosition(m_position);
 
     window.draw(m_playerRect);
@@ -139,6 +153,25 @@ void Player::render(sf::RenderWindow& window) {
     }
 }
 
+void Player::render(SpriteBatch& batch) {
+    if (m_idleAnimation.isValid()) {
+        m_sprite.setPosition(m_position);
+        batch.draw(m_sprite);
+        return;
+    }
+
+    m_playerRect.setPosition(m_position);
+
+    batch.drawShape(m_playerRect);
+
+    if (m_facingRight) {
+        batch.drawRect(sf::FloatRect(m_position.x + m_size.x / 2 - 5, m_position.y - 5, 10, 10), sf::Color::White);
+    }
+    else {
+        batch.drawRect(sf::FloatRect(m_position.x - m_size.x / 2 - 5, m_position.y - 5, 10, 10), sf::Color::White);
+    }
+}
+
 void Player::handleEvents(const sf::Event& event) {
 }
 
@@ -288,6 +321,19 @@ void Player::interact() {
         });
 }
 
+// Blasts out the terrain just ahead of the player's feet; the level turns
+// the event into a DestructibleTerrain edit.
+void Player::dig() {
+    if (m_state == EntityState::Dead) return;
+
+    sf::Vector2f digPos = m_position + getFacingDirection() * 24.0f + sf::Vector2f(0.0f, m_size.y / 2.0f + 16.0f);
+
+    EventSystem::getInstance()->triggerEvent("DestroyTerrain", {
+        {"position", digPos},
+        {"radius", 40.0f}
+        });
+}
+
 void Player::setAction(PlayerAction action, bool active) {
     m_actions[action] = active;
 }
@@ -381,9 +427,7 @@ int Player::getLives() const {
 void Player::onCollisionEnter(Collider* other) {
     Entity::onCollisionEnter(other);
 
-    if (!other || !other->getOwner()) return;
-
-    Entity* otherEntity = static_cast<Entity*>(other->getOwner());
+    if (!other) return;
 
     if ((other->getCollisionLayer() & static_cast<int>(CollisionLayer::Platform)) &&
         !m_isGrounded) {
@@ -411,6 +455,10 @@ void Player::onCollisionEnter(Collider* other) {
         }
     }
 
+    if (!other->getOwner()) return;
+
+    Entity* otherEntity = static_cast<Entity*>(other->getOwner());
+
     if (otherEntity->getType() == EntityType::Pickup) {
         if (otherEntity->getName() == "Bitcoin") {
             addCoins(1);
@@ -516,6 +564,11 @@ void Player::updateMovement(float dt) {
         interact();
         setAction(PlayerAction::Interact, false);
     }
+
+    if (isActionActive(PlayerAction::Special)) {
+        dig();
+        setAction(PlayerAction::Special, false);
+    }
 }
 
 void Player::updateJump(float dt) {
@@ -593,6 +646,22 @@ void Player::updateAnimationState() {
 }
 
 void Player::loadAnimations() {
+    AtlasRegion region = RessourceManager::getInstance()->loadAtlasRegion("player_idle", "player_idle.png");
+    if (!region.isValid() || region.rect.height <= 0) return;
+
+    // player_idle.png is one row of square frames. Frame rects stay relative
+    // to the sheet; the region offset moves them onto the atlas page.
+    int frameSize = region.rect.height;
+    m_idleAnimation.addGridFrames(sf::Vector2i(frameSize, frameSize), sf::Vector2i(0, 0),
+        static_cast<unsigned int>(region.rect.width / frameSize), 0.1f);
+    m_idleAnimation.setAtlasRegion(region);
+
+    m_texture = region.texture;
+    m_sprite.setTexture(*m_texture);
+    m_sprite.setOrigin(frameSize / 2.0f, frameSize / 2.0f);
+    float scale = m_size.y / frameSize;
+    m_sprite.setScale(scale, scale);
+    m_idleAnimation.apply(m_sprite);
 }
 	
 void Player::playAnimation(const std::string& name) {
@@ -26,6 +26,11 @@ private:
     std::vector<Collider*> m_colliders;
     std::set<CollisionPair> m_activeCollisions;
 
+    // Colliders that never move (merged terrain). They sit in their own
+    // grid, rebuilt only when the set changes, and are only ever tested
+    // against moving colliders.
+    std::vector<Collider*> m_staticColliders;
+
     struct Grid {
         int cellSize;
         std::map<std::pair<int, int>, std::vector<Collider*>> cells;
@@ -53,6 +58,11 @@ private:
 
         std::vector<Collider*> getPotentialColliders(Collider* collider) {
             std::vector<Collider*> result;
+            appendPotentialColliders(collider, result);
+            return result;
+        }
+
+        void appendPotentialColliders(Collider* collider, std::vector<Collider*>& result) {
             std::set<Collider*> uniqueColliders;
 
             sf::FloatRect bounds = collider->getBounds();
@@ -75,16 +85,18 @@ private:
                     }
                 }
             }
-
-            return result;
         }
     };
 
     Grid m_grid;
+    Grid m_staticGrid;
+    bool m_staticGridDirty;
     bool m_debugDraw;
 
     CollisionManager();
 
+    void endCollisionsWith(Collider* collider);
+
 public:
     CollisionManager(const CollisionManager&) = delete;
     CollisionManager& operator=(const CollisionManager&) = delete;
@@ -94,6 +106,9 @@ public:
 
     void registerCollider(Collider* collider);
     void unregisterCollider(Collider* collider);
+    void registerStaticCollider(Collider* collider);
+    void unregisterStaticCollider(Collider* collider);
+    std::size_t getStaticColliderCount() const;
 
     void checkCollisions();
 
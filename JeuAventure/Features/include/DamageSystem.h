@@ -51,19 +51,39 @@ private:
     std::map<Entity*, float> m_invincibilityTimers;
 
     struct DamageNumber {
-        sf::Text text;
         sf::Vector2f position;
         sf::Vector2f velocity;
         float lifetime;
-        float alpha;
+        int value;
     };
 
+    struct DigitGlyph {
+        sf::FloatRect fillBounds;
+        sf::IntRect fillRect;
+        sf::FloatRect outlineBounds;
+        sf::IntRect outlineRect;
+        float advance;
+    };
+
+    static const std::size_t MaxDamageNumbers = 256;
+    static const unsigned int DamageNumberCharacterSize = 16;
+
     std::vector<DamageNumber> m_damageNumbers;
+    std::size_t m_damageNumberCount;
     sf::Font m_font;
     bool m_showDamageNumbers;
 
+    DigitGlyph m_digitGlyphs[10];
+    sf::Texture m_digitAtlas;
+    bool m_digitAtlasReady;
+    sf::VertexArray m_damageNumberVertices;
+
     DamageSystem();
 
+    void bakeDigitAtlas();
+    void spawnDamageNumber(const sf::Vector2f& position, int value);
+    void buildDamageNumberVertices();
+
 public:
     DamageSystem(const DamageSystem&) = delete;
     DamageSystem& operator=(const DamageSystem&) = delete;
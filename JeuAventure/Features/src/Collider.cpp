@@ -1,11 +1,7 @@
 #include "Collider.h"
+#include "Entity.h"
 #include <cmath>
 
-class Entity {
-public:
-    virtual sf::Vector2f getPosition() const { return sf::Vector2f(0, 0); }
-};
-
 Collider::Collider(Entity* owner, ColliderType type, const sf::Vector2f& offset)
     : m_owner(owner),
     m_type(type),
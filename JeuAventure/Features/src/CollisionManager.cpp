@@ -4,7 +4,7 @@
 CollisionManager* CollisionManager::s_instance = nullptr;
 
 CollisionManager::CollisionManager()
-    : m_debugDraw(false), m_grid(100)
+    : m_debugDraw(false), m_grid(100), m_staticGrid(100), m_staticGridDirty(false)
 {
 }
 
@@ -34,6 +34,39 @@ void CollisionManager::registerCollider(Collider* collider) {
 void CollisionManager::unregisterCollider(Collider* collider) {
     if (!collider) return;
 
+    endCollisionsWith(collider);
+
+    auto it2 = std::find(m_colliders.begin(), m_colliders.end(), collider);
+    if (it2 != m_colliders.end()) {
+        m_colliders.erase(it2);
+    }
+}
+
+void CollisionManager::registerStaticCollider(Collider* collider) {
+    if (!collider) return;
+
+    m_staticColliders.push_back(collider);
+    m_staticGridDirty = true;
+}
+
+void CollisionManager::unregisterStaticCollider(Collider* collider) {
+    if (!collider) return;
+
+    endCollisionsWith(collider);
+
+    auto it = std::find(m_staticColliders.begin(), m_staticColliders.end(), collider);
+    if (it != m_staticColliders.end()) {
+        *it = m_staticColliders.back();
+        m_staticColliders.pop_back();
+        m_staticGridDirty = true;
+    }
+}
+
+std::size_t CollisionManager::getStaticColliderCount() const {
+    return m_staticColliders.size();
+}
+
+void CollisionManager::endCollisionsWith(Collider* collider) {
     auto it1 = m_activeCollisions.begin();
     while (it1 != m_activeCollisions.end()) {
         if (it1->a == collider || it1->b == collider) {
@@ -45,11 +78,6 @@ void CollisionManager::unregisterCollider(Collider* collider) {
             ++it1;
         }
     }
-
-    auto it2 = std::find(m_colliders.begin(), m_colliders.end(), collider);
-    if (it2 != m_colliders.end()) {
-        m_colliders.erase(it2);
-    }
 }
 
 void CollisionManager::checkCollisions() {
@@ -61,12 +89,21 @@ void CollisionManager::checkCollisions() {
         }
     }
 
+    if (m_staticGridDirty) {
+        m_staticGrid.clear();
+        for (auto* collider : m_staticColliders) {
+            m_staticGrid.addCollider(collider);
+        }
+        m_staticGridDirty = false;
+    }
+
     std::set<CollisionPair> currentCollisions;
 
     for (auto* collider : m_colliders) {
         if (!collider->isEnabled()) continue;
 
         std::vector<Collider*> potentialColliders = m_grid.getPotentialColliders(collider);
+        m_staticGrid.appendPotentialColliders(collider, potentialColliders);
 
         for (auto* other : potentialColliders) {
             if (!other->isEnabled()) continue;
@@ -117,4 +154,10 @@ void CollisionManager::debugDraw(sf::RenderWindow& window) {
             collider->debugDraw(window);
         }
     }
+
+    for (auto* collider : m_staticColliders) {
+        if (collider->isEnabled()) {
+            collider->debugDraw(window);
+        }
+    }
 }
@@ -3,6 +3,7 @@
 #include "EventSystem.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 class Entity {
 public:
@@ -14,11 +15,19 @@ public:
 DamageSystem* DamageSystem::s_instance = nullptr;
 
 DamageSystem::DamageSystem()
-    : m_showDamageNumbers(true)
+    : m_damageNumberCount(0),
+    m_showDamageNumbers(true),
+    m_digitAtlasReady(false),
+    m_damageNumberVertices(sf::Quads)
 {
+    m_damageNumbers.resize(MaxDamageNumbers);
+
     if (!m_font.loadFromFile("Assets/Fonts/damage_font.ttf")) {
         std::cerr << "Failed to load damage number font!" << std::endl;
     }
+    else {
+        bakeDigitAtlas();
+    }
 }
 
 DamageSystem* DamageSystem::getInstance() {
@@ -62,23 +71,7 @@ bool DamageSystem::applyDamage(Entity* target, const DamageInfo& damageInfo) {
         }
 
         if (m_showDamageNumbers) {
-            DamageNumber number;
-            number.text.setFont(m_font);
-            number.text.setString(std::to_string(static_cast<int>(finalDamage)));
-            number.text.setCharacterSize(16);
-            number.text.setFillColor(sf::Color::Red);
-            number.text.setOutlineColor(sf::Color::Black);
-            number.text.setOutlineThickness(1.0f);
-
-            number.position = target->getPosition() + sf::Vector2f(0, -20);
-            number.velocity = sf::Vector2f(
-                (std::rand() % 100 - 50) * 0.5f,
-                -100.0f
-            );
-            number.lifetime = 1.0f;
-            number.alpha = 255.0f;
-
-            m_damageNumbers.push_back(number);
+            spawnDamageNumber(target->getPosition() + sf::Vector2f(0, -20), static_cast<int>(finalDamage));
         }
 
         EventSystem::getInstance()->triggerEvent("EntityDamaged", {
@@ -159,35 +152,147 @@ void DamageSystem::update(float dt) {
         }
     }
 
-    auto numIt = m_damageNumbers.begin();
-    while (numIt != m_damageNumbers.end()) {
-        numIt->position += numIt->velocity * dt;
-        numIt->velocity.y += 200.0f * dt;
-        numIt->lifetime -= dt;
-        numIt->alpha = 255.0f * (numIt->lifetime / 1.0f);
+    for (std::size_t i = 0; i < m_damageNumberCount; ++i) {
+        DamageNumber& number = m_damageNumbers[i];
+        number.position += number.velocity * dt;
+        number.velocity.y += 200.0f * dt;
+        number.lifetime -= dt;
+    }
 
-        if (numIt->lifetime <= 0) {
-            numIt = m_damageNumbers.erase(numIt);
+    for (std::size_t i = m_damageNumberCount; i-- > 0;) {
+        if (m_damageNumbers[i].lifetime <= 0) {
+            m_damageNumbers[i] = m_damageNumbers[--m_damageNumberCount];
         }
-        else {
-            numIt->text.setPosition(numIt->position);
+    }
+
+    buildDamageNumberVertices();
+}
 
-            sf::Color color = numIt->text.getFillColor();
-            color.a = static_cast<sf::Uint8>(numIt->alpha);
-            numIt->text.setFillColor(color);
+void DamageSystem::render(sf::RenderWindow& window) {
+    if (!m_digitAtlasReady || m_damageNumberVertices.getVertexCount() == 0) return;
+
+    window.draw(m_damageNumberVertices, &m_digitAtlas);
+}
 
-            color = numIt->text.getOutlineColor();
-            color.a = static_cast<sf::Uint8>(numIt->alpha);
-            numIt->text.setOutlineColor(color);
+void DamageSystem::bakeDigitAtlas() {
+    const float outlineThickness = 1.0f;
 
-            ++numIt;
-        }
+    sf::Glyph fillGlyphs[10];
+    sf::Glyph outlineGlyphs[10];
+    for (int digit = 0; digit < 10; ++digit) {
+        fillGlyphs[digit] = m_font.getGlyph('0' + digit, DamageNumberCharacterSize, false, 0.0f);
+        outlineGlyphs[digit] = m_font.getGlyph('0' + digit, DamageNumberCharacterSize, false, outlineThickness);
+    }
+
+    sf::Image page = m_font.getTexture(DamageNumberCharacterSize).copyToImage();
+
+    unsigned int atlasWidth = 1;
+    unsigned int atlasHeight = 1;
+    for (int digit = 0; digit < 10; ++digit) {
+        atlasWidth += fillGlyphs[digit].textureRect.width + outlineGlyphs[digit].textureRect.width + 2;
+        atlasHeight = std::max(atlasHeight, static_cast<unsigned int>(outlineGlyphs[digit].textureRect.height) + 2);
+    }
+
+    sf::Image atlas;
+    atlas.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+
+    int cursorX = 1;
+    auto place = [&](const sf::Glyph& glyph) {
+        sf::IntRect rect(cursorX, 1, glyph.textureRect.width, glyph.textureRect.height);
+        atlas.copy(page, rect.left, rect.top, glyph.textureRect);
+        cursorX += rect.width + 1;
+        return rect;
+    };
+
+    for (int digit = 0; digit < 10; ++digit) {
+        DigitGlyph& baked = m_digitGlyphs[digit];
+        baked.fillBounds = fillGlyphs[digit].bounds;
+        baked.fillRect = place(fillGlyphs[digit]);
+        baked.outlineBounds = outlineGlyphs[digit].bounds;
+        baked.outlineRect = place(outlineGlyphs[digit]);
+        baked.advance = fillGlyphs[digit].advance;
+    }
+
+    m_digitAtlasReady = m_digitAtlas.loadFromImage(atlas);
+    if (!m_digitAtlasReady) {
+        std::cerr << "Failed to bake damage number atlas!" << std::endl;
     }
 }
 
-void DamageSystem::render(sf::RenderWindow& window) {
-    for (const auto& number : m_damageNumbers) {
-        window.draw(number.text);
+void DamageSystem::spawnDamageNumber(const sf::Vector2f& position, int value) {
+    std::size_t index = m_damageNumberCount;
+
+    if (m_damageNumberCount < MaxDamageNumbers) {
+        ++m_damageNumberCount;
+    }
+    else {
+        index = 0;
+        for (std::size_t i = 1; i < m_damageNumberCount; ++i) {
+            if (m_damageNumbers[i].lifetime < m_damageNumbers[index].lifetime) {
+                index = i;
+            }
+        }
     }
+
+    DamageNumber& number = m_damageNumbers[index];
+    number.position = position;
+    number.velocity = sf::Vector2f(
+        (std::rand() % 100 - 50) * 0.5f,
+        -100.0f
+    );
+    number.lifetime = 1.0f;
+    number.value = std::max(0, value);
 }
 
+void DamageSystem::buildDamageNumberVertices() {
+    m_damageNumberVertices.clear();
+    if (!m_digitAtlasReady) return;
+
+    auto appendQuad = [this](const sf::Vector2f& origin, const sf::FloatRect& bounds, const sf::IntRect& rect, const sf::Color& color) {
+        float left = origin.x + bounds.left;
+        float top = origin.y + bounds.top;
+        float right = left + bounds.width;
+        float bottom = top + bounds.height;
+
+        float u0 = static_cast<float>(rect.left);
+        float v0 = static_cast<float>(rect.top);
+        float u1 = static_cast<float>(rect.left + rect.width);
+        float v1 = static_cast<float>(rect.top + rect.height);
+
+        m_damageNumberVertices.append(sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u0, v0)));
+        m_damageNumberVertices.append(sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0)));
+        m_damageNumberVertices.append(sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1)));
+        m_damageNumberVertices.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1)));
+    };
+
+    char digits[16];
+    for (std::size_t i = 0; i < m_damageNumberCount; ++i) {
+        const DamageNumber& number = m_damageNumbers[i];
+
+        int length = 0;
+        int value = number.value;
+        do {
+            digits[length++] = static_cast<char>(value % 10);
+            value /= 10;
+        } while (value > 0 && length < 16);
+
+        sf::Uint8 alpha = static_cast<sf::Uint8>(255.0f * std::max(0.0f, std::min(1.0f, number.lifetime)));
+        sf::Color outlineColor(0, 0, 0, alpha);
+        sf::Color fillColor(255, 0, 0, alpha);
+
+        // Outline quads first so the fill of every digit sits on top.
+        sf::Vector2f pen(number.position.x, number.position.y + DamageNumberCharacterSize);
+        for (int d = length - 1; d >= 0; --d) {
+            const DigitGlyph& glyph = m_digitGlyphs[static_cast<int>(digits[d])];
+            appendQuad(pen, glyph.outlineBounds, glyph.outlineRect, outlineColor);
+            pen.x += glyph.advance;
+        }
+
+        pen.x = number.position.x;
+        for (int d = length - 1; d >= 0; --d) {
+            const DigitGlyph& glyph = m_digitGlyphs[static_cast<int>(digits[d])];
+            appendQuad(pen, glyph.fillBounds, glyph.fillRect, fillColor);
+            pen.x += glyph.advance;
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
+#include "TextureAtlas.h"
 
 struct AnimationFrame {
     sf::IntRect rect;
@@ -19,6 +20,7 @@ private:
     float m_speedFactor;
     sf::IntRect m_defaultRect;
     bool m_flipHorizontal;
+    sf::Vector2i m_frameOffset;
 
 public:
     Animation();
@@ -54,5 +56,9 @@ public:
     void setDefaultRect(const sf::IntRect& rect);
     const sf::IntRect& getDefaultRect() const;
 
+    void setAtlasRegion(const AtlasRegion& region);
+    void setFrameOffset(const sf::Vector2i& offset);
+    const sf::Vector2i& getFrameOffset() const;
+
     bool isValid() const;
 };
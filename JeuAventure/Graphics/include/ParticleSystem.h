@@ -0,0 +1,152 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <utility>
+#include <map>
+#include <string>
+#include <memory>
+
+struct ParticleEmitterConfig {
+    float minLifetime;
+    float maxLifetime;
+    float minSpeed;
+    float maxSpeed;
+    float direction;
+    float spread;
+    float drag;
+    float startSize;
+    float endSize;
+    sf::Vector2f gravity;
+    sf::Color startColor;
+    sf::Color endColor;
+    sf::BlendMode blendMode;
+
+    ParticleEmitterConfig()
+        : minLifetime(0.3f),
+        maxLifetime(0.6f),
+        minSpeed(40.0f),
+        maxSpeed(120.0f),
+        direction(-90.0f),
+        spread(360.0f),
+        drag(0.0f),
+        startSize(3.0f),
+        endSize(1.0f),
+        gravity(0.0f, 0.0f),
+        startColor(sf::Color::White),
+        endColor(sf::Color(255, 255, 255, 0)),
+        blendMode(sf::BlendAlpha)
+    {
+    }
+};
+
+// Fixed-capacity structure-of-arrays pool: each attribute lives in its own
+// contiguous array so the update loops stay branch-free and auto-vectorise.
+class ParticlePool {
+private:
+    std::size_t m_capacity;
+    std::size_t m_count;
+
+public:
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> age;
+    std::vector<float> invLifetime;
+
+    explicit ParticlePool(std::size_t capacity = 0);
+
+    void reserve(std::size_t capacity);
+
+    std::size_t spawn();
+    void kill(std::size_t index);
+    void clear();
+
+    std::size_t getCount() const;
+    std::size_t getCapacity() const;
+};
+
+class ParticleEmitter {
+private:
+    ParticleEmitterConfig m_config;
+    ParticlePool m_pool;
+    sf::VertexArray m_vertices;
+    const sf::Texture* m_texture;
+
+public:
+    ParticleEmitter(const ParticleEmitterConfig& config, std::size_t capacity);
+
+    void emit(const sf::Vector2f& position, unsigned int count);
+
+    void update(float dt);
+    void buildVertices();
+    void render(sf::RenderTarget& target) const;
+
+    void clear();
+
+    void setTexture(const sf::Texture* texture);
+    void setConfig(const ParticleEmitterConfig& config);
+    const ParticleEmitterConfig& getConfig() const;
+
+    std::size_t getParticleCount() const;
+    std::size_t getCapacity() const;
+};
+
+struct ParticleStats {
+    std::size_t particleCount;
+    std::size_t drawCalls;
+    float updateMicroseconds;
+    float buildMicroseconds;
+
+    ParticleStats()
+        : particleCount(0),
+        drawCalls(0),
+        updateMicroseconds(0.0f),
+        buildMicroseconds(0.0f)
+    {
+    }
+
+    float updatePer10k() const;
+    float buildPer10k() const;
+};
+
+class ParticleSystem {
+private:
+    static ParticleSystem* s_instance;
+
+    std::map<std::string, std::unique_ptr<ParticleEmitter>> m_emitters;
+    ParticleStats m_stats;
+    bool m_enabled;
+    // Listeners capturing this system, removed on destruction
+    std::vector<std::pair<std::string, int>> m_eventListeners;
+
+    ParticleSystem();
+
+    void registerDefaultEmitters();
+    void registerEventListeners();
+
+public:
+    ~ParticleSystem();
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    static ParticleSystem* getInstance();
+    static void cleanup();
+
+    ParticleEmitter* registerEmitter(const std::string& name, const ParticleEmitterConfig& config, std::size_t capacity);
+    ParticleEmitter* getEmitter(const std::string& name);
+
+    void emit(const std::string& name, const sf::Vector2f& position, unsigned int count);
+
+    void update(float dt);
+    void render(sf::RenderTarget& target);
+
+    void clear();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    const ParticleStats& getStats() const;
+};
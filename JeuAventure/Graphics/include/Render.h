@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include "Camera.h"
+#include "SpriteBatch.h"
 
 class Entity;
 class Level;
@@ -45,6 +46,7 @@ private:
     Level* m_currentLevel;
 
     std::vector<Renderable> m_renderables;
+    SpriteBatch m_spriteBatch;
 
     sf::Vector2f m_parallaxOffset;
 
@@ -98,6 +100,7 @@ public:
     void render();
 
     Camera* getCamera() const;
+    const SpriteBatch& getSpriteBatch() const;
 
     std::vector<ParallaxLayer> m_parallaxLayers;
 };
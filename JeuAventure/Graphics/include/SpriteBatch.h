@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Collects quads for a frame and submits them in runs of the same (layer,
+// texture, blend mode): consecutive quads sharing a state become one draw
+// call, and a state change starts a new run so submission order is kept.
+// Runs are drawn in ascending layer order.
+class SpriteBatch {
+private:
+    struct Batch {
+        int layer;
+        const sf::Texture* texture;
+        sf::BlendMode blendMode;
+        sf::VertexArray vertices;
+
+        Batch(int batchLayer, const sf::Texture* batchTexture, const sf::BlendMode& batchBlendMode)
+            : layer(batchLayer),
+            texture(batchTexture),
+            blendMode(batchBlendMode),
+            vertices(sf::Quads)
+        {
+        }
+    };
+
+    // Reused across frames; the first m_batchCount hold this frame's runs.
+    std::vector<Batch> m_batches;
+    std::size_t m_batchCount;
+    std::vector<std::size_t> m_order;
+
+    std::size_t m_drawCalls;
+    std::size_t m_quadCount;
+
+    sf::VertexArray& getBatch(int layer, const sf::Texture* texture, const sf::BlendMode& blendMode);
+
+public:
+    SpriteBatch();
+
+    void begin();
+    void flush(sf::RenderTarget& target);
+    void end(sf::RenderTarget& target);
+
+    void draw(const sf::Sprite& sprite, int layer = 0, const sf::BlendMode& blendMode = sf::BlendAlpha);
+    void drawShape(const sf::Shape& shape, int layer = 0, const sf::BlendMode& blendMode = sf::BlendAlpha);
+    void drawRect(const sf::FloatRect& rect, const sf::Color& color, int layer = 0);
+    void drawRect(const sf::Vector2f& size, const sf::Transform& transform, const sf::Color& color, int layer = 0);
+    void drawQuad(const sf::Vertex* quad, const sf::Texture* texture, int layer = 0, const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+    std::size_t getDrawCallCount() const;
+    std::size_t getQuadCount() const;
+};
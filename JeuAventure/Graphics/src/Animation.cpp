@@ -8,7 +8,8 @@ Animation::Animation() :
     m_isFinished(false),
     m_speedFactor(1.0f),
     m_defaultRect(0, 0, 0, 0),
-    m_flipHorizontal(false)
+    m_flipHorizontal(false),
+    m_frameOffset(0, 0)
 {
 }
 
@@ -65,11 +66,18 @@ void Animation::update(float deltaTime) {
 
 void Animation::apply(sf::Sprite& sprite) {
     if (m_frames.empty()) {
-        sprite.setTextureRect(m_defaultRect);
+        sf::IntRect rect = m_defaultRect;
+        rect.left += m_frameOffset.x;
+        rect.top += m_frameOffset.y;
+        sprite.setTextureRect(rect);
         return;
     }
 
-    const sf::IntRect& rect = m_frames[m_currentFrame].rect;
+    // Frame rects are relative to the sheet; the offset moves them into the
+    // atlas page the sheet was packed into.
+    sf::IntRect rect = m_frames[m_currentFrame].rect;
+    rect.left += m_frameOffset.x;
+    rect.top += m_frameOffset.y;
 
     if (m_flipHorizontal) {
         sf::IntRect flippedRect = rect;
@@ -141,4 +149,16 @@ const sf::IntRect& Animation::getDefaultRect() const {
 
 bool Animation::isValid() const {
     return !m_frames.empty();
-}
\ No newline at end of file
+}
+
+void Animation::setAtlasRegion(const AtlasRegion& region) {
+    m_frameOffset = sf::Vector2i(region.rect.left, region.rect.top);
+}
+
+void Animation::setFrameOffset(const sf::Vector2i& offset) {
+    m_frameOffset = offset;
+}
+
+const sf::Vector2i& Animation::getFrameOffset() const {
+    return m_frameOffset;
+}
@@ -0,0 +1,439 @@
+#include "ParticleSystem.h"
+#include "Entity.h"
+#include "Player.h"
+#include "EventSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    const float PI = 3.14159265f;
+
+    float randomRange(float min, float max) {
+        return min + (max - min) * (static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+    }
+
+    template <typename T>
+    const T* findParam(const std::map<std::string, std::any>& params, const std::string& key) {
+        auto it = params.find(key);
+        if (it == params.end()) return nullptr;
+        return std::any_cast<T>(&it->second);
+    }
+}
+
+ParticlePool::ParticlePool(std::size_t capacity)
+    : m_capacity(0),
+    m_count(0)
+{
+    reserve(capacity);
+}
+
+void ParticlePool::reserve(std::size_t capacity) {
+    m_capacity = capacity;
+    m_count = std::min(m_count, m_capacity);
+
+    posX.resize(m_capacity);
+    posY.resize(m_capacity);
+    velX.resize(m_capacity);
+    velY.resize(m_capacity);
+    age.resize(m_capacity);
+    invLifetime.resize(m_capacity);
+}
+
+std::size_t ParticlePool::spawn() {
+    if (m_count >= m_capacity) {
+        return m_capacity;
+    }
+    return m_count++;
+}
+
+void ParticlePool::kill(std::size_t index) {
+    if (index >= m_count) return;
+
+    std::size_t last = --m_count;
+    if (index != last) {
+        posX[index] = posX[last];
+        posY[index] = posY[last];
+        velX[index] = velX[last];
+        velY[index] = velY[last];
+        age[index] = age[last];
+        invLifetime[index] = invLifetime[last];
+    }
+}
+
+void ParticlePool::clear() {
+    m_count = 0;
+}
+
+std::size_t ParticlePool::getCount() const {
+    return m_count;
+}
+
+std::size_t ParticlePool::getCapacity() const {
+    return m_capacity;
+}
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitterConfig& config, std::size_t capacity)
+    : m_config(config),
+    m_pool(capacity),
+    m_vertices(sf::Quads),
+    m_texture(nullptr)
+{
+}
+
+void ParticleEmitter::emit(const sf::Vector2f& position, unsigned int count) {
+    for (unsigned int i = 0; i < count; ++i) {
+        std::size_t index = m_pool.spawn();
+        if (index >= m_pool.getCapacity()) {
+            break;
+        }
+
+        float angle = (m_config.direction + randomRange(-0.5f, 0.5f) * m_config.spread) * PI / 180.0f;
+        float speed = randomRange(m_config.minSpeed, m_config.maxSpeed);
+        float lifetime = std::max(0.01f, randomRange(m_config.minLifetime, m_config.maxLifetime));
+
+        m_pool.posX[index] = position.x;
+        m_pool.posY[index] = position.y;
+        m_pool.velX[index] = std::cos(angle) * speed;
+        m_pool.velY[index] = std::sin(angle) * speed;
+        m_pool.age[index] = 0.0f;
+        m_pool.invLifetime[index] = 1.0f / lifetime;
+    }
+}
+
+void ParticleEmitter::update(float dt) {
+    const std::size_t count = m_pool.getCount();
+    if (count == 0) return;
+
+    float* posX = m_pool.posX.data();
+    float* posY = m_pool.posY.data();
+    float* velX = m_pool.velX.data();
+    float* velY = m_pool.velY.data();
+    float* age = m_pool.age.data();
+    const float* invLifetime = m_pool.invLifetime.data();
+
+    const float gravityX = m_config.gravity.x * dt;
+    const float gravityY = m_config.gravity.y * dt;
+    const float damping = std::max(0.0f, 1.0f - m_config.drag * dt);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        velX[i] = (velX[i] + gravityX) * damping;
+        velY[i] = (velY[i] + gravityY) * damping;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        age[i] += dt * invLifetime[i];
+    }
+
+    for (std::size_t i = count; i-- > 0;) {
+        if (age[i] >= 1.0f) {
+            m_pool.kill(i);
+        }
+    }
+}
+
+void ParticleEmitter::buildVertices() {
+    const std::size_t count = m_pool.getCount();
+    m_vertices.resize(count * 4);
+    if (count == 0) return;
+
+    sf::Vector2f texSize(0.0f, 0.0f);
+    if (m_texture) {
+        texSize = sf::Vector2f(static_cast<float>(m_texture->getSize().x), static_cast<float>(m_texture->getSize().y));
+    }
+
+    const sf::Color& c0 = m_config.startColor;
+    const sf::Color& c1 = m_config.endColor;
+    const float dr = static_cast<float>(c1.r) - c0.r;
+    const float dg = static_cast<float>(c1.g) - c0.g;
+    const float db = static_cast<float>(c1.b) - c0.b;
+    const float da = static_cast<float>(c1.a) - c0.a;
+    const float halfStart = m_config.startSize * 0.5f;
+    const float halfDelta = (m_config.endSize - m_config.startSize) * 0.5f;
+
+    const float* posX = m_pool.posX.data();
+    const float* posY = m_pool.posY.data();
+    const float* age = m_pool.age.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const float t = std::min(age[i], 1.0f);
+        const float half = halfStart + halfDelta * t;
+        const sf::Color color(
+            static_cast<sf::Uint8>(c0.r + dr * t),
+            static_cast<sf::Uint8>(c0.g + dg * t),
+            static_cast<sf::Uint8>(c0.b + db * t),
+            static_cast<sf::Uint8>(c0.a + da * t));
+
+        sf::Vertex* quad = &m_vertices[i * 4];
+        quad[0].position = sf::Vector2f(posX[i] - half, posY[i] - half);
+        quad[1].position = sf::Vector2f(posX[i] + half, posY[i] - half);
+        quad[2].position = sf::Vector2f(posX[i] + half, posY[i] + half);
+        quad[3].position = sf::Vector2f(posX[i] - half, posY[i] + half);
+
+        quad[0].texCoords = sf::Vector2f(0.0f, 0.0f);
+        quad[1].texCoords = sf::Vector2f(texSize.x, 0.0f);
+        quad[2].texCoords = sf::Vector2f(texSize.x, texSize.y);
+        quad[3].texCoords = sf::Vector2f(0.0f, texSize.y);
+
+        quad[0].color = color;
+        quad[1].color = color;
+        quad[2].color = color;
+        quad[3].color = color;
+    }
+}
+
+void ParticleEmitter::render(sf::RenderTarget& target) const {
+    if (m_vertices.getVertexCount() == 0) return;
+
+    sf::RenderStates states;
+    states.texture = m_texture;
+    states.blendMode = m_config.blendMode;
+    target.draw(m_vertices, states);
+}
+
+void ParticleEmitter::clear() {
+    m_pool.clear();
+    m_vertices.clear();
+}
+
+void ParticleEmitter::setTexture(const sf::Texture* texture) {
+    m_texture = texture;
+}
+
+void ParticleEmitter::setConfig(const ParticleEmitterConfig& config) {
+    m_config = config;
+}
+
+const ParticleEmitterConfig& ParticleEmitter::getConfig() const {
+    return m_config;
+}
+
+std::size_t ParticleEmitter::getParticleCount() const {
+    return m_pool.getCount();
+}
+
+std::size_t ParticleEmitter::getCapacity() const {
+    return m_pool.getCapacity();
+}
+
+float ParticleStats::updatePer10k() const {
+    return particleCount > 0 ? updateMicroseconds * 10000.0f / particleCount : 0.0f;
+}
+
+float ParticleStats::buildPer10k() const {
+    return particleCount > 0 ? buildMicroseconds * 10000.0f / particleCount : 0.0f;
+}
+
+ParticleSystem* ParticleSystem::s_instance = nullptr;
+
+ParticleSystem::ParticleSystem()
+    : m_enabled(true)
+{
+    registerDefaultEmitters();
+    registerEventListeners();
+}
+
+ParticleSystem::~ParticleSystem() {
+    for (const auto& listener : m_eventListeners) {
+        EventSystem::getInstance()->removeEventListener(listener.first, listener.second);
+    }
+}
+
+ParticleSystem* ParticleSystem::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new ParticleSystem();
+    }
+    return s_instance;
+}
+
+void ParticleSystem::cleanup() {
+    if (s_instance != nullptr) {
+        delete s_instance;
+        s_instance = nullptr;
+    }
+}
+
+void ParticleSystem::registerDefaultEmitters() {
+    ParticleEmitterConfig dust;
+    dust.minLifetime = 0.3f;
+    dust.maxLifetime = 0.6f;
+    dust.minSpeed = 20.0f;
+    dust.maxSpeed = 60.0f;
+    dust.direction = -90.0f;
+    dust.spread = 140.0f;
+    dust.drag = 3.0f;
+    dust.startSize = 4.0f;
+    dust.endSize = 8.0f;
+    dust.gravity = sf::Vector2f(0.0f, -20.0f);
+    dust.startColor = sf::Color(180, 170, 150, 160);
+    dust.endColor = sf::Color(180, 170, 150, 0);
+    registerEmitter("dust", dust, 2048);
+
+    ParticleEmitterConfig sparks;
+    sparks.minLifetime = 0.15f;
+    sparks.maxLifetime = 0.35f;
+    sparks.minSpeed = 120.0f;
+    sparks.maxSpeed = 260.0f;
+    sparks.spread = 360.0f;
+    sparks.drag = 4.0f;
+    sparks.startSize = 3.0f;
+    sparks.endSize = 1.0f;
+    sparks.gravity = sf::Vector2f(0.0f, 400.0f);
+    sparks.startColor = sf::Color(255, 240, 180);
+    sparks.endColor = sf::Color(255, 80, 0, 0);
+    sparks.blendMode = sf::BlendAdd;
+    registerEmitter("hit_spark", sparks, 4096);
+
+    ParticleEmitterConfig sparkle;
+    sparkle.minLifetime = 0.4f;
+    sparkle.maxLifetime = 0.8f;
+    sparkle.minSpeed = 30.0f;
+    sparkle.maxSpeed = 90.0f;
+    sparkle.direction = -90.0f;
+    sparkle.spread = 180.0f;
+    sparkle.drag = 2.0f;
+    sparkle.startSize = 3.0f;
+    sparkle.endSize = 0.5f;
+    sparkle.startColor = sf::Color(255, 230, 90);
+    sparkle.endColor = sf::Color(255, 255, 255, 0);
+    sparkle.blendMode = sf::BlendAdd;
+    registerEmitter("coin_sparkle", sparkle, 2048);
+
+    ParticleEmitterConfig burst;
+    burst.minLifetime = 0.5f;
+    burst.maxLifetime = 1.0f;
+    burst.minSpeed = 60.0f;
+    burst.maxSpeed = 220.0f;
+    burst.spread = 360.0f;
+    burst.drag = 1.5f;
+    burst.startSize = 5.0f;
+    burst.endSize = 1.0f;
+    burst.gravity = sf::Vector2f(0.0f, 250.0f);
+    burst.startColor = sf::Color(220, 60, 60);
+    burst.endColor = sf::Color(60, 20, 20, 0);
+    registerEmitter("death_burst", burst, 10000);
+}
+
+void ParticleSystem::registerEventListeners() {
+    EventSystem* events = EventSystem::getInstance();
+
+    m_eventListeners.emplace_back("EntityDamaged", events->addEventListener("EntityDamaged", [this](const std::map<std::string, std::any>& params) {
+        const Entity* const* target = findParam<Entity*>(params, "target");
+        if (target && *target) {
+            emit("hit_spark", (*target)->getPosition(), 12);
+        }
+        }));
+
+    m_eventListeners.emplace_back("AbilityUsed", events->addEventListener("AbilityUsed", [this](const std::map<std::string, std::any>& params) {
+        const Entity* const* entity = findParam<Entity*>(params, "entity");
+        if (entity && *entity) {
+            emit("dust", (*entity)->getPosition(), 8);
+        }
+        }));
+
+    m_eventListeners.emplace_back("EntityDied", events->addEventListener("EntityDied", [this](const std::map<std::string, std::any>& params) {
+        const sf::Vector2f* position = findParam<sf::Vector2f>(params, "position");
+        if (position) {
+            emit("death_burst", *position, 40);
+        }
+        }));
+
+    m_eventListeners.emplace_back("PlayerCoinsChanged", events->addEventListener("PlayerCoinsChanged", [this](const std::map<std::string, std::any>& params) {
+        const Player* const* player = findParam<Player*>(params, "player");
+        if (player && *player) {
+            emit("coin_sparkle", (*player)->getPosition(), 16);
+        }
+        }));
+
+    m_eventListeners.emplace_back("EntityStateChanged", events->addEventListener("EntityStateChanged", [this](const std::map<std::string, std::any>& params) {
+        const int* oldState = findParam<int>(params, "oldState");
+        const int* newState = findParam<int>(params, "newState");
+        const Entity* const* entity = findParam<Entity*>(params, "entity");
+        if (!oldState || !newState || !entity || !*entity) return;
+
+        if (*oldState == static_cast<int>(EntityState::Falling) && *newState == static_cast<int>(EntityState::Idle)) {
+            sf::Vector2f feet = (*entity)->getPosition() + sf::Vector2f(0.0f, (*entity)->getSize().y / 2.0f);
+            emit("dust", feet, 6);
+        }
+        }));
+}
+
+ParticleEmitter* ParticleSystem::registerEmitter(const std::string& name, const ParticleEmitterConfig& config, std::size_t capacity) {
+    auto emitter = std::make_unique<ParticleEmitter>(config, capacity);
+    ParticleEmitter* emitterPtr = emitter.get();
+    m_emitters[name] = std::move(emitter);
+    return emitterPtr;
+}
+
+ParticleEmitter* ParticleSystem::getEmitter(const std::string& name) {
+    auto it = m_emitters.find(name);
+    if (it != m_emitters.end()) {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+void ParticleSystem::emit(const std::string& name, const sf::Vector2f& position, unsigned int count) {
+    if (!m_enabled) return;
+
+    ParticleEmitter* emitter = getEmitter(name);
+    if (!emitter) {
+        std::cerr << "Particle emitter not found: " << name << std::endl;
+        return;
+    }
+
+    emitter->emit(position, count);
+}
+
+void ParticleSystem::update(float dt) {
+    sf::Clock clock;
+
+    std::size_t particleCount = 0;
+    for (auto& [name, emitter] : m_emitters) {
+        emitter->update(dt);
+        particleCount += emitter->getParticleCount();
+    }
+
+    m_stats.updateMicroseconds = static_cast<float>(clock.restart().asMicroseconds());
+
+    for (auto& [name, emitter] : m_emitters) {
+        emitter->buildVertices();
+    }
+
+    m_stats.buildMicroseconds = static_cast<float>(clock.getElapsedTime().asMicroseconds());
+    m_stats.particleCount = particleCount;
+}
+
+void ParticleSystem::render(sf::RenderTarget& target) {
+    m_stats.drawCalls = 0;
+    if (!m_enabled) return;
+
+    for (const auto& [name, emitter] : m_emitters) {
+        if (emitter->getParticleCount() > 0) {
+            emitter->render(target);
+            m_stats.drawCalls++;
+        }
+    }
+}
+
+void ParticleSystem::clear() {
+    for (auto& [name, emitter] : m_emitters) {
+        emitter->clear();
+    }
+    m_stats = ParticleStats();
+}
+
+void ParticleSystem::setEnabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+bool ParticleSystem::isEnabled() const {
+    return m_enabled;
+}
+
+const ParticleStats& ParticleSystem::getStats() const {
+    return m_stats;
+}
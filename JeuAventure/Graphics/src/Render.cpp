@@ -184,6 +184,10 @@ void Render::render() {
 
     drawParallaxLayers();
 
+    // Renderables are sorted by layer, so queued entities only need flushing
+    // before a plain drawable to keep the layer order intact.
+    m_spriteBatch.begin();
+
     for (const auto& renderable : m_renderables) {
         bool isVisible = true;
         if (renderable.entity) {
@@ -194,13 +198,16 @@ void Render::render() {
             continue;
 
         if (renderable.entity) {
-            renderable.entity->render(*m_window);
+            renderable.entity->render(m_spriteBatch);
         }
         else if (renderable.drawable) {
+            m_spriteBatch.flush(*target);
             target->draw(*renderable.drawable);
         }
     }
 
+    m_spriteBatch.end(*target);
+
 
 
 
@@ -230,6 +237,10 @@ Camera* Render::getCamera() const {
     return m_camera;
 }
 
+const SpriteBatch& Render::getSpriteBatch() const {
+    return m_spriteBatch;
+}
+
 void Render::sortRenderables() {
     std::sort(m_renderables.begin(), m_renderables.end(),
         [](const Renderable& a, const Renderable& b) {
@@ -0,0 +1,220 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cmath>
+
+SpriteBatch::SpriteBatch()
+    : m_batchCount(0),
+    m_drawCalls(0),
+    m_quadCount(0)
+{
+}
+
+sf::VertexArray& SpriteBatch::getBatch(int layer, const sf::Texture* texture, const sf::BlendMode& blendMode) {
+    // Only the newest batch of the layer can take the quad: merging into an
+    // older one would draw it beneath quads submitted after that batch.
+    for (std::size_t i = m_batchCount; i-- > 0;) {
+        Batch& batch = m_batches[i];
+        if (batch.layer != layer) continue;
+
+        if (batch.texture == texture && batch.blendMode == blendMode) {
+            return batch.vertices;
+        }
+        break;
+    }
+
+    if (m_batchCount == m_batches.size()) {
+        m_batches.emplace_back(layer, texture, blendMode);
+    }
+    else {
+        Batch& batch = m_batches[m_batchCount];
+        batch.layer = layer;
+        batch.texture = texture;
+        batch.blendMode = blendMode;
+        batch.vertices.clear();
+    }
+    return m_batches[m_batchCount++].vertices;
+}
+
+void SpriteBatch::begin() {
+    for (std::size_t i = 0; i < m_batchCount; ++i) {
+        m_batches[i].vertices.clear();
+    }
+    m_batchCount = 0;
+
+    m_drawCalls = 0;
+    m_quadCount = 0;
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    m_order.clear();
+    for (std::size_t i = 0; i < m_batchCount; ++i) {
+        if (m_batches[i].vertices.getVertexCount() > 0) {
+            m_order.push_back(i);
+        }
+    }
+
+    std::stable_sort(m_order.begin(), m_order.end(),
+        [this](std::size_t a, std::size_t b) {
+            return m_batches[a].layer < m_batches[b].layer;
+        });
+
+    for (std::size_t index : m_order) {
+        Batch& batch = m_batches[index];
+
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        states.blendMode = batch.blendMode;
+        target.draw(batch.vertices, states);
+
+        m_drawCalls++;
+        batch.vertices.clear();
+    }
+    m_batchCount = 0;
+}
+
+void SpriteBatch::end(sf::RenderTarget& target) {
+    flush(target);
+}
+
+void SpriteBatch::draw(const sf::Sprite& sprite, int layer, const sf::BlendMode& blendMode) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture) return;
+
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Color& color = sprite.getColor();
+
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+
+    float u0 = static_cast<float>(rect.left);
+    float v0 = static_cast<float>(rect.top);
+    float u1 = static_cast<float>(rect.left + rect.width);
+    float v1 = static_cast<float>(rect.top + rect.height);
+
+    sf::Vertex quad[4] = {
+        sf::Vertex(transform.transformPoint(0.0f, 0.0f), color, sf::Vector2f(u0, v0)),
+        sf::Vertex(transform.transformPoint(width, 0.0f), color, sf::Vector2f(u1, v0)),
+        sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(u1, v1)),
+        sf::Vertex(transform.transformPoint(0.0f, height), color, sf::Vector2f(u0, v1))
+    };
+
+    drawQuad(quad, texture, layer, blendMode);
+}
+
+void SpriteBatch::drawShape(const sf::Shape& shape, int layer, const sf::BlendMode& blendMode) {
+    std::size_t count = shape.getPointCount();
+    if (count < 3) return;
+
+    const sf::Transform& transform = shape.getTransform();
+    const sf::Texture* texture = shape.getTexture();
+    const sf::IntRect& texRect = shape.getTextureRect();
+    const sf::FloatRect bounds = shape.getLocalBounds();
+
+    sf::Vector2f center(0.0f, 0.0f);
+    for (std::size_t i = 0; i < count; ++i) {
+        center += shape.getPoint(i);
+    }
+    center /= static_cast<float>(count);
+
+    auto texCoords = [&](const sf::Vector2f& point) {
+        if (!texture || bounds.width <= 0.0f || bounds.height <= 0.0f) {
+            return sf::Vector2f(0.0f, 0.0f);
+        }
+        return sf::Vector2f(
+            texRect.left + (point.x - bounds.left) / bounds.width * texRect.width,
+            texRect.top + (point.y - bounds.top) / bounds.height * texRect.height);
+    };
+
+    // Fill as a fan of degenerate quads (center, p[i], p[i+1], p[i+1]).
+    const sf::Color& fillColor = shape.getFillColor();
+    if (fillColor.a > 0) {
+        sf::Vertex quad[4];
+        for (std::size_t i = 0; i < count; ++i) {
+            sf::Vector2f p0 = shape.getPoint(i);
+            sf::Vector2f p1 = shape.getPoint((i + 1) % count);
+
+            quad[0] = sf::Vertex(transform.transformPoint(center), fillColor, texCoords(center));
+            quad[1] = sf::Vertex(transform.transformPoint(p0), fillColor, texCoords(p0));
+            quad[2] = sf::Vertex(transform.transformPoint(p1), fillColor, texCoords(p1));
+            quad[3] = quad[2];
+            drawQuad(quad, texture, layer, blendMode);
+        }
+    }
+
+    // Outline: one quad per edge, extruded along the mitred vertex normals.
+    float thickness = shape.getOutlineThickness();
+    const sf::Color& outlineColor = shape.getOutlineColor();
+    if (thickness == 0.0f || outlineColor.a == 0) return;
+
+    auto edgeNormal = [&](const sf::Vector2f& a, const sf::Vector2f& b) {
+        sf::Vector2f normal(a.y - b.y, b.x - a.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0.0f) normal /= length;
+        sf::Vector2f toEdge = a - center;
+        if (normal.x * toEdge.x + normal.y * toEdge.y < 0.0f) normal = -normal;
+        return normal;
+    };
+
+    auto outerPoint = [&](std::size_t i) {
+        sf::Vector2f prev = shape.getPoint((i + count - 1) % count);
+        sf::Vector2f point = shape.getPoint(i);
+        sf::Vector2f next = shape.getPoint((i + 1) % count);
+
+        sf::Vector2f n1 = edgeNormal(prev, point);
+        sf::Vector2f n2 = edgeNormal(point, next);
+        float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+        sf::Vector2f offset = (factor != 0.0f) ? (n1 + n2) / factor : n1;
+        return point + offset * thickness;
+    };
+
+    sf::Vertex quad[4];
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t j = (i + 1) % count;
+        quad[0] = sf::Vertex(transform.transformPoint(shape.getPoint(i)), outlineColor);
+        quad[1] = sf::Vertex(transform.transformPoint(shape.getPoint(j)), outlineColor);
+        quad[2] = sf::Vertex(transform.transformPoint(outerPoint(j)), outlineColor);
+        quad[3] = sf::Vertex(transform.transformPoint(outerPoint(i)), outlineColor);
+        drawQuad(quad, nullptr, layer, blendMode);
+    }
+}
+
+void SpriteBatch::drawRect(const sf::FloatRect& rect, const sf::Color& color, int layer) {
+    sf::Vertex quad[4] = {
+        sf::Vertex(sf::Vector2f(rect.left, rect.top), color),
+        sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color),
+        sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color),
+        sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color)
+    };
+
+    drawQuad(quad, nullptr, layer);
+}
+
+void SpriteBatch::drawRect(const sf::Vector2f& size, const sf::Transform& transform, const sf::Color& color, int layer) {
+    sf::Vertex quad[4] = {
+        sf::Vertex(transform.transformPoint(0.0f, 0.0f), color),
+        sf::Vertex(transform.transformPoint(size.x, 0.0f), color),
+        sf::Vertex(transform.transformPoint(size.x, size.y), color),
+        sf::Vertex(transform.transformPoint(0.0f, size.y), color)
+    };
+
+    drawQuad(quad, nullptr, layer);
+}
+
+void SpriteBatch::drawQuad(const sf::Vertex* quad, const sf::Texture* texture, int layer, const sf::BlendMode& blendMode) {
+    sf::VertexArray& vertices = getBatch(layer, texture, blendMode);
+    vertices.append(quad[0]);
+    vertices.append(quad[1]);
+    vertices.append(quad[2]);
+    vertices.append(quad[3]);
+
+    m_quadCount++;
+}
+
+std::size_t SpriteBatch::getDrawCallCount() const {
+    return m_drawCalls;
+}
+
+std::size_t SpriteBatch::getQuadCount() const {
+    return m_quadCount;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "State.h"
+#include "AssetHandle.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <functional>
@@ -15,7 +16,7 @@ private:
         bool isSelected;
     };
 
-    sf::Font m_font;
+    FontHandle m_font;
     sf::RectangleShape m_background;
     sf::Text m_gameOverText;
     sf::Text m_scoreText;
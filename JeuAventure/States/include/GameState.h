@@ -1,6 +1,7 @@
 #pragma once
 
 #include "State.h"
+#include "AssetHandle.h"
 #include <SFML/Graphics.hpp>
 #include <memory>
 
@@ -32,7 +33,7 @@ private:
     std::unique_ptr<Player> m_player;
     std::unique_ptr<Level> m_level;
 
-    sf::Font m_debugFont;
+    FontHandle m_font;
     sf::Text m_debugText;
     sf::Text m_scoreText;
 
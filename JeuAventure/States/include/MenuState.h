@@ -1,6 +1,7 @@
 #pragma once
 
 #include "State.h"
+#include "AssetHandle.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <functional>
@@ -16,7 +17,7 @@ public:
     };
 
 private:
-    sf::Font m_font;
+    FontHandle m_font;
     sf::Sprite m_backgroundSprite;
     sf::Text m_titleText;
     std::vector<MenuItem> m_menuItems;
@@ -20,21 +20,17 @@ GameOverState::GameOverState(Game& game)
 void GameOverState::initialize() {
     auto* resourceManager = RessourceManager::getInstance();
 
-    if (!resourceManager->loadFont("main_font", "arial.ttf")) {
+    m_font = resourceManager->acquireFont("main_font", "arial.ttf");
+    if (!m_font) {
         std::cerr << "Failed to load main font!" << std::endl;
-        m_font = sf::Font();
-        if (!m_font.loadFromFile("arial.ttf")) {
-            std::cerr << "Failed to load fallback font!" << std::endl;
-        }
-    }
-    else {
-        m_font = *resourceManager->getFont("main_font");
     }
 
     m_background.setSize(sf::Vector2f(m_game.getWindow().getSize().x, m_game.getWindow().getSize().y));
     m_background.setFillColor(sf::Color(0, 0, 0, 200));
 
-    m_gameOverText.setFont(m_font);
+    if (m_font) {
+        m_gameOverText.setFont(*m_font);
+    }
     m_gameOverText.setString("Game Over");
     m_gameOverText.setCharacterSize(90);
     m_gameOverText.setFillColor(sf::Color::Red);
@@ -43,7 +39,9 @@ void GameOverState::initialize() {
 
     centerText(m_gameOverText, m_game.getWindow().getSize().x / 2.f, 150.f);
 
-    m_scoreText.setFont(m_font);
+    if (m_font) {
+        m_scoreText.setFont(*m_font);
+    }
     int score = SaveSystem::getInstance()->getInt("current_score", 0);
     m_scoreText.setString("Score: " + std::to_string(score));
     m_scoreText.setCharacterSize(40);
@@ -122,7 +120,9 @@ void GameOverState::addMenuItem(const std::string& text, const std::function<voi
     item.action = action;
     item.isSelected = false;
 
-    item.displayText.setFont(m_font);
+    if (m_font) {
+        item.displayText.setFont(*m_font);
+    }
     item.displayText.setString(text);
     item.displayText.setCharacterSize(36);
     item.displayText.setFillColor(sf::Color(180, 180, 180));
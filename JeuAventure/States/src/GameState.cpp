@@ -5,7 +5,16 @@
 #include "EventSystem.h"
 #include "Player.h"
 #include "Level.h"
+#include "Tilemap.h"
+#include "TileColliderSet.h"
+#include "DestructibleTerrain.h"
+#include "TileLightMap.h"
+#include "TriggerVolumeSystem.h"
+#include "PickupField.h"
+#include "TileLayerMesh.h"
+#include "WorldStreamer.h"
 #include "UIManager.h"
+#include "ParticleSystem.h"
 #include <iostream>
 #include <sstream>
 #include <filesystem>
@@ -29,15 +38,14 @@ void GameState::initialize() {
     std::cout << "GameState::initialize - Starting game initialization..." << std::endl;
 
     auto* resourceManager = RessourceManager::getInstance();
-    if (!resourceManager->loadFont("debug_font", "arial.ttf")) {
-        std::cerr << "Failed to load debug font!" << std::endl;
-        m_debugFont = sf::Font();
-        if (!m_debugFont.loadFromFile("arial.ttf")) {
-            std::cerr << "Failed to load fallback font!" << std::endl;
-        }
+    m_font = resourceManager->acquireFont("main_font", "arial.ttf");
+    if (m_font) {
+        m_debugText.setFont(*m_font);
+        m_debugText.setCharacterSize(16);
+        m_scoreText.setFont(*m_font);
     }
     else {
-        m_debugFont = *resourceManager->getFont("debug_font");
+        std::cerr << "Failed to load main font!" << std::endl;
     }
 
     m_player = std::make_unique<Player>();
@@ -59,6 +67,8 @@ void GameState::initialize() {
 
     m_level->setPlayer(m_player.get());
 
+    ParticleSystem::getInstance()->clear();
+
     std::cout << "GameState initialization complete" << std::endl;
 }
 
@@ -68,12 +78,29 @@ void GameState::handleEvent(const sf::Event& event) {
             m_showDebugInfo = !m_showDebugInfo;
             std::cout << "Debug info " << (m_showDebugInfo ? "enabled" : "disabled") << std::endl;
         }
+        else if (event.key.code == sf::Keyboard::F4) {
+            if (m_level && m_level->getTilemap()) {
+                Tilemap* tilemap = m_level->getTilemap();
+                tilemap->setShowCollisionOverlay(!tilemap->isShowingCollisionOverlay());
+            }
+        }
+        else if (event.key.code == sf::Keyboard::F5) {
+            if (m_level) {
+                TileLightMap* lighting = m_level->getLighting();
+                lighting->setEnabled(!lighting->isEnabled());
+            }
+        }
         else if (event.key.code == sf::Keyboard::Escape) {
             pauseGame();
         }
         else if (event.key.code == sf::Keyboard::R) {
             resetLevel();
         }
+        else if (event.key.code == sf::Keyboard::X) {
+            if (m_player) {
+                m_player->setAction(PlayerAction::Special, true);
+            }
+        }
     }
 
     if (m_level) {
@@ -97,6 +124,8 @@ void GameState::update(float dt) {
         m_level->update(dt);
     }
 
+    ParticleSystem::getInstance()->update(dt);
+
     updateCamera();
     updateHUD();
 
@@ -113,8 +142,78 @@ void GameState::update(float dt) {
         if (m_level) {
             debugInfo << "Level: " << m_level->getName() << "\n";
             debugInfo << "Entities: " << m_level->getEntitiesInArea(sf::FloatRect(0, 0, m_level->getWidth(), m_level->getHeight())).size() << "\n";
+            debugInfo << "Sprite batch: " << m_level->getSpriteBatch().getQuadCount() << " quads, "
+                << m_level->getSpriteBatch().getDrawCallCount() << " draws\n";
+            if (const TriggerVolumeSystem* volumes = m_level->getTriggerVolumes()) {
+                debugInfo << "Trigger volumes: " << volumes->getVolumeCount() << " in " << volumes->getCellCount()
+                    << " cells, " << volumes->getLastTestedCount() << " tested\n";
+            }
+            if (const PickupField* pickups = m_level->getPickups()) {
+                debugInfo << "Pickups: " << pickups->getRemainingCount() << "/" << pickups->getCount() << " left, "
+                    << pickups->getLastTestedCount() << " tested, " << pickups->getLastDrawnCount() << " drawn\n";
+            }
+
+            if (Tilemap* tilemap = m_level->getTilemap()) {
+                debugInfo << "Tile chunks: " << tilemap->getLastVisibleChunkCount() << "/" << tilemap->getChunkCount()
+                    << " visible, " << tilemap->getLastDrawCallCount() << " draws\n";
+                debugInfo << "Line of sight: " << tilemap->getLastLineOfSightQueryCount() << " queries, "
+                    << tilemap->getLastLineOfSightCacheHits() << " cached\n";
+                debugInfo << "Tile storage: " << tilemap->getAllocatedStorageChunkCount() << "/" << tilemap->getStorageChunkCount()
+                    << " blocks, " << tilemap->getStorageBytes() / 1024 << " KB\n";
+                if (const TileColliderSet* colliders = m_level->getTileColliders()) {
+                    debugInfo << "Terrain colliders: " << colliders->getColliderCount() << " for "
+                        << tilemap->countCollisionsInArea(sf::FloatRect(0.f, 0.f,
+                            static_cast<float>(tilemap->getWidth() * tilemap->getTileWidth()),
+                            static_cast<float>(tilemap->getHeight() * tilemap->getTileHeight()))) << " solid tiles\n";
+                }
+                if (const DestructibleTerrain* terrain = m_level->getTerrain()) {
+                    debugInfo << "Terrain edit: " << terrain->getLastEditCellCount() << " cells in "
+                        << terrain->getLastEditTime().asMicroseconds() << " us, " << terrain->getLayerCount() << " layers\n";
+                }
+                if (const TileLightMap* lighting = m_level->getLighting()) {
+                    debugInfo << "Lighting: " << lighting->getLightCount() << " lights, " << lighting->getLastUpdatedTileCount()
+                        << " tiles updated, " << lighting->getLastUploadedTileCount() << " uploaded\n";
+                }
+            }
+
+            if (!m_level->getTileMeshes().empty()) {
+                std::size_t shaderLayers = 0;
+                std::size_t layerDraws = 0;
+                std::size_t animatedTiles = 0;
+                for (const auto& mesh : m_level->getTileMeshes()) {
+                    if (mesh->isShaderRendered()) shaderLayers++;
+                    layerDraws += mesh->getLastDrawCallCount();
+                    animatedTiles += mesh->getAnimatedTileCount();
+                }
+                debugInfo << "Tile layers: " << shaderLayers << "/" << m_level->getTileMeshes().size()
+                    << " shader-drawn, " << layerDraws << " draws, " << animatedTiles << " animated tiles\n";
+            }
+
+            if (WorldStreamer* streamer = m_level->getWorldStreamer()) {
+                debugInfo << "Streaming: " << streamer->getSectionCount(WorldStreamer::SectionState::Ready) << " ready, "
+                    << streamer->getSectionCount(WorldStreamer::SectionState::Loading) << " loading, "
+                    << streamer->getSectionCount(WorldStreamer::SectionState::Prefetched) << " prefetched, "
+                    << streamer->getSectionCount(WorldStreamer::SectionState::Uploading) << " uploading, "
+                    << streamer->getSectionCount(WorldStreamer::SectionState::Failed) << " failed ("
+                    << streamer->getLastUploadTime().asMicroseconds() << " us)\n";
+            }
         }
 
+        ResourceStats assets = RessourceManager::getInstance()->getStats();
+        const AssetTypeStats& textures = assets.get(AssetType::Texture);
+        debugInfo << "Assets: " << assets.residentBytes / (1024 * 1024) << "/" << assets.memoryBudget / (1024 * 1024)
+            << " MB, " << assets.evictionCount << " evicted\n";
+        debugInfo << "Textures: " << textures.count << " (" << textures.bytes / 1024 << " KB, "
+            << textures.cachedCount << " cached), atlas " << assets.atlasBytes / 1024 << " KB\n";
+        debugInfo << "Texture cache: " << assets.textureCacheHits << " hits, " << assets.textureCacheMisses
+            << " decoded, " << assets.textureLoadTime.asMilliseconds() << " ms\n";
+        debugInfo << "Fonts: " << assets.get(AssetType::Font).bytes / 1024 << " KB, sounds: "
+            << assets.get(AssetType::SoundBuffer).bytes / 1024 << " KB\n";
+
+        const ParticleStats& particles = ParticleSystem::getInstance()->getStats();
+        debugInfo << "Particles: " << particles.particleCount << " (" << particles.drawCalls << " draws)\n";
+        debugInfo << "Particle us/10k: update " << particles.updatePer10k() << ", build " << particles.buildPer10k() << "\n";
+
         m_debugText.setString(debugInfo.str());
     }
 }
@@ -126,6 +225,8 @@ void GameState::render(sf::RenderWindow& window) {
         m_level->render(window);
     }
 
+    ParticleSystem::getInstance()->render(window);
+
     window.setView(window.getDefaultView());
 
     window.draw(m_healthBarBackground);
@@ -138,7 +239,9 @@ void GameState::render(sf::RenderWindow& window) {
 
     if (m_isPaused) {
         sf::Text pauseText;
-        pauseText.setFont(m_debugFont);
+        if (m_font) {
+            pauseText.setFont(*m_font);
+        }
         pauseText.setCharacterSize(48);
         pauseText.setFillColor(sf::Color::White);
         pauseText.setString("PAUSED");
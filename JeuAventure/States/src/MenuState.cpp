@@ -19,26 +19,22 @@ MenuState::MenuState(Game& game)
 void MenuState::initialize() {
     auto* resourceManager = RessourceManager::getInstance();
 
-    if (!resourceManager->loadFont("main_font", "arial.ttf")) {
+    m_font = resourceManager->acquireFont("main_font", "arial.ttf");
+    if (!m_font) {
         std::cerr << "Failed to load main font!" << std::endl;
-        m_font = sf::Font();
-        if (!m_font.loadFromFile("arial.ttf")) {
-            std::cerr << "Failed to load fallback font!" << std::endl;
-        }
-    }
-    else {
-        m_font = *resourceManager->getFont("main_font");
     }
 
     if (resourceManager->loadTexture("menu_background", "Menu.png")) {
-        m_backgroundSprite.setTexture(*resourceManager->getTexture("menu_background"));
+        m_backgroundSprite.setTexture(*resourceManager->getTexture("menu_background"_rid));
 
         float scaleX = static_cast<float>(m_game.getWindow().getSize().x) / m_backgroundSprite.getTexture()->getSize().x;
         float scaleY = static_cast<float>(m_game.getWindow().getSize().y) / m_backgroundSprite.getTexture()->getSize().y;
         m_backgroundSprite.setScale(scaleX, scaleY);
     }
 
-    m_titleText.setFont(m_font);
+    if (m_font) {
+        m_titleText.setFont(*m_font);
+    }
     m_titleText.setString("Platformer Adventure");
     m_titleText.setCharacterSize(72);
     m_titleText.setFillColor(sf::Color::White);
@@ -142,7 +138,9 @@ void MenuState::addMenuItem(const std::string& text, const std::function<void()>
     item.action = action;
     item.isSelected = false;
 
-    item.displayText.setFont(m_font);
+    if (m_font) {
+        item.displayText.setFont(*m_font);
+    }
     item.displayText.setString(text);
     item.displayText.setCharacterSize(36);
     item.displayText.setFillColor(sf::Color(180, 180, 180));
@@ -17,21 +17,17 @@ PauseState::PauseState(Game& game)
 void PauseState::initialize() {
     auto* resourceManager = RessourceManager::getInstance();
 
-    if (!resourceManager->loadFont("main_font", "arial.ttf")) {
+    m_font = resourceManager->acquireFont("main_font", "arial.ttf");
+    if (!m_font) {
         std::cerr << "Failed to load main font!" << std::endl;
-        m_font = sf::Font();
-        if (!m_font.loadFromFile("arial.ttf")) {
-            std::cerr << "Failed to load fallback font!" << std::endl;
-        }
-    }
-    else {
-        m_font = *resourceManager->getFont("main_font");
     }
 
     m_background.setSize(sf::Vector2f(m_game.getWindow().getSize().x, m_game.getWindow().getSize().y));
     m_background.setFillColor(sf::Color(0, 0, 0, 150));
 
-    m_pauseTitle.setFont(m_font);
+    if (m_font) {
+        m_pauseTitle.setFont(*m_font);
+    }
     m_pauseTitle.setString("Paused");
     m_pauseTitle.setCharacterSize(72);
     m_pauseTitle.setFillColor(sf::Color::White);
@@ -109,7 +105,9 @@ void PauseState::addMenuItem(const std::string& text, const std::function<void()
     item.action = action;
     item.isSelected = false;
 
-    item.displayText.setFont(m_font);
+    if (m_font) {
+        item.displayText.setFont(*m_font);
+    }
     item.displayText.setString(text);
     item.displayText.setCharacterSize(36);
     item.displayText.setFillColor(sf::Color(180, 180, 180));
@@ -3,6 +3,7 @@
 #include "InputManager.h"
 #include "EventSystem.h"
 #include "SaveSystem.h"
+#include "ParticleSystem.h"
 #include <iostream>
 
 Game::Game() :
@@ -23,6 +24,7 @@ Game::Game() :
 
 Game::~Game() {
     InputManager::cleanup();
+    ParticleSystem::cleanup();
     EventSystem::cleanup();
     SaveSystem::cleanup();
 }
@@ -62,6 +64,38 @@ void Game::initialize(const std::string& title, unsigned int width, unsigned int
 void Game::initializeSystems() {
     m_stateManager = std::make_unique<StateManager>(*this);
 
+    // Fonts and the menu background decode on the loader threads while the
+    // atlas is packed below; the states then find them already loaded.
+    RessourceManager* resourceManager = RessourceManager::getInstance();
+    resourceManager->loadFontAsync("main_font", "arial.ttf");
+    resourceManager->loadTextureAsync("menu_background", "Menu.png");
+
+    // The pickup, checkpoint and player sheets share one atlas page, so
+    // those entities batch into the same draw call. They are queued first
+    // and packed together, tallest first.
+    resourceManager->addToAtlas("pickup_Bitcoin", "pickup_Bitcoin.png");
+    resourceManager->addToAtlas("pickup_health", "pickup_health.png");
+    resourceManager->addToAtlas("checkpoint", "checkpoint.png");
+    resourceManager->addToAtlas("player_idle", "player_idle.png");
+    resourceManager->packAtlas();
+    resourceManager->finishPendingLoads();
+
+    // Every state shares main_font. Rendering its glyph pages now, for the
+    // sizes the states use, keeps pushing a menu from stalling on them.
+    std::string uiCharacters;
+    for (char c = ' '; c <= '~'; ++c) {
+        uiCharacters += c;
+    }
+    resourceManager->prewarmGlyphs("main_font"_rid, uiCharacters, {
+        { 16, 0.f },  // debug overlay
+        { 30, 0.f },  // score
+        { 36, 2.f },  // menu items, outlined when selected
+        { 40, 0.f },
+        { 48, 0.f },
+        { 72, 3.f },  // titles
+        { 90, 3.f }
+        });
+
     SaveSystem::getInstance()->setSavePath("./saves/");
 
     EventSystem::getInstance()->addEventListener("QuitGame", [this](const std::map<std::string, std::any>&) {
@@ -98,6 +132,8 @@ void Game::run() {
             m_accumulatedTime -= sf::seconds(m_timeStep);
         }
 
+        RessourceManager::getInstance()->processPendingLoads(sf::milliseconds(2));
+
         render();
 
         updateFPS();
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "AssetArchiveFormat.h"
+#include "MappedFile.h"
+
+// Read-only view over a packed asset archive. The whole file is mapped once;
+// find() returns a pointer into the mapping that stays valid until close(),
+// which is what sf::Font and sf::Music need for loadFromMemory/openFromMemory.
+class AssetArchive {
+private:
+    MappedFile m_file;
+    const AssetArchiveFormat::Header* m_header;
+
+    template <typename T>
+    const T* at(std::uint64_t offset) const {
+        return reinterpret_cast<const T*>(m_file.getData() + offset);
+    }
+
+    bool rangeValid(std::uint64_t offset, std::uint64_t count, std::size_t elementSize) const;
+    bool validate() const;
+
+public:
+    AssetArchive();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // relativePath is relative to Ressources/ and normalised internally.
+    // contentHash, when given, receives the packer's hash of the file.
+    const std::uint8_t* find(const std::string& relativePath, std::size_t& size, std::uint64_t* contentHash = nullptr) const;
+    bool contains(const std::string& relativePath) const;
+
+    std::uint32_t getEntryCount() const;
+    std::uint32_t getBlobCount() const;
+    std::size_t getSize() const;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include "ResourceId.h"
+
+// On-disk layout written by the asset_packer tool and mapped by
+// AssetArchive. Little-endian. The entry table is sorted by path hash so a
+// lookup is a binary search; several entries may share one blob when their
+// contents are identical. String offsets index the string table, blob
+// offsets are from the start of the file. Bump Version whenever a struct
+// changes.
+namespace AssetArchiveFormat {
+
+    const char Magic[4] = { 'J', 'A', 'P', 'K' };
+    const std::uint32_t Version = 1;
+
+    // Blobs start on this boundary so decoders get aligned data.
+    const std::size_t BlobAlignment = 16;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t fileSize;
+        std::uint32_t entryCount;
+        std::uint32_t entryTableOffset;
+        std::uint32_t blobCount;
+        std::uint32_t blobTableOffset;
+        std::uint32_t stringTableOffset;
+        std::uint32_t stringTableSize;
+    };
+
+    struct Entry {
+        std::uint32_t pathHash;
+        std::uint32_t path;
+        std::uint32_t blobIndex;
+        std::uint32_t reserved;
+    };
+
+    struct Blob {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint64_t contentHash;
+    };
+
+    // Archive paths are relative to Ressources/, use forward slashes and are
+    // lower-case, so lookups behave like the case-insensitive Windows
+    // filesystem the game ships on.
+    inline std::string normalizePath(const std::string& relativePath) {
+        std::string path = std::filesystem::path(relativePath).lexically_normal().generic_string();
+        while (path.compare(0, 2, "./") == 0) {
+            path.erase(0, 2);
+        }
+        std::transform(path.begin(), path.end(), path.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return path;
+    }
+
+    inline std::uint32_t hashPath(const std::string& normalizedPath) {
+        return fnv1a(normalizedPath);
+    }
+
+    // 64-bit FNV-1a over file contents, used for deduplication.
+    inline std::uint64_t hashContent(const std::uint8_t* data, std::size_t size) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "ResourceId.h"
+
+namespace sf {
+    class Texture;
+    class Font;
+    class SoundBuffer;
+    class Music;
+}
+
+enum class AssetType {
+    Texture,
+    Font,
+    SoundBuffer,
+    Music,
+    Count
+};
+
+template <typename T> struct AssetTypeOf;
+template <> struct AssetTypeOf<sf::Texture> { static const AssetType value = AssetType::Texture; };
+template <> struct AssetTypeOf<sf::Font> { static const AssetType value = AssetType::Font; };
+template <> struct AssetTypeOf<sf::SoundBuffer> { static const AssetType value = AssetType::SoundBuffer; };
+
+// Implemented by RessourceManager; slots index its per-type asset tables.
+void retainAsset(AssetType type, std::uint32_t slot);
+void releaseAsset(AssetType type, std::uint32_t slot);
+
+// Counted reference to an asset owned by RessourceManager. While at least
+// one handle is alive the asset can't be evicted; once the last one goes it
+// moves to the manager's LRU cache. The handle is resolved once, when it is
+// acquired: afterwards access is a plain pointer and the reference count is
+// updated through the slot index, without any lookup.
+template <typename T>
+class AssetHandle {
+private:
+    ResourceId m_id;
+    std::uint32_t m_slot;
+    T* m_asset;
+
+public:
+    AssetHandle() : m_slot(0), m_asset(nullptr) {}
+
+    AssetHandle(ResourceId id, std::uint32_t slot, T* asset)
+        : m_id(id),
+        m_slot(slot),
+        m_asset(asset)
+    {
+        if (m_asset) retainAsset(AssetTypeOf<T>::value, m_slot);
+    }
+
+    AssetHandle(const AssetHandle& other)
+        : m_id(other.m_id),
+        m_slot(other.m_slot),
+        m_asset(other.m_asset)
+    {
+        if (m_asset) retainAsset(AssetTypeOf<T>::value, m_slot);
+    }
+
+    AssetHandle(AssetHandle&& other) noexcept
+        : m_id(other.m_id),
+        m_slot(other.m_slot),
+        m_asset(other.m_asset)
+    {
+        other.m_asset = nullptr;
+    }
+
+    AssetHandle& operator=(AssetHandle other) noexcept {
+        std::swap(m_id, other.m_id);
+        std::swap(m_slot, other.m_slot);
+        std::swap(m_asset, other.m_asset);
+        return *this;
+    }
+
+    ~AssetHandle() {
+        reset();
+    }
+
+    void reset() {
+        if (m_asset) releaseAsset(AssetTypeOf<T>::value, m_slot);
+        m_asset = nullptr;
+        m_id = ResourceId();
+    }
+
+    T* get() const { return m_asset; }
+    T* operator->() const { return m_asset; }
+    T& operator*() const { return *m_asset; }
+    explicit operator bool() const { return m_asset != nullptr; }
+
+    ResourceId getId() const { return m_id; }
+    std::uint32_t getSlot() const { return m_slot; }
+};
+
+using TextureHandle = AssetHandle<sf::Texture>;
+using FontHandle = AssetHandle<sf::Font>;
+using SoundBufferHandle = AssetHandle<sf::SoundBuffer>;
+
+// List of assets a level (or any other owner) needs, so they can be
+// prefetched ahead of time and acquired as a group.
+struct AssetManifest {
+    struct Entry {
+        AssetType type;
+        std::string id;
+        std::string path;
+    };
+
+    std::vector<Entry> entries;
+
+    void add(AssetType type, const std::string& id, const std::string& path) {
+        for (const auto& entry : entries) {
+            if (entry.type == type && entry.id == id) return;
+        }
+        entries.push_back({ type, id, path });
+    }
+
+    bool empty() const { return entries.empty(); }
+};
+
+// Handles acquired for a manifest; dropping the group releases them all.
+struct AssetGroup {
+    std::vector<TextureHandle> textures;
+    std::vector<FontHandle> fonts;
+    std::vector<SoundBufferHandle> soundBuffers;
+
+    sf::Texture* findTexture(ResourceId id) const {
+        for (const auto& texture : textures) {
+            if (texture.getId() == id) return texture.get();
+        }
+        return nullptr;
+    }
+
+    void clear() {
+        textures.clear();
+        fonts.clear();
+        soundBuffers.clear();
+    }
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Small worker pool for asset loading. Each job is split in two: decode()
+// runs on a worker (file I/O, image/audio decoding, nothing touching GL),
+// finish() runs later on the main thread from processFinished(), where GPU
+// uploads are allowed. Both halves usually share state through a
+// std::shared_ptr captured by the two lambdas.
+class AsyncLoader {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Job {
+        Task decode;
+        Task finish;
+    };
+
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_jobFinished;
+    std::deque<Job> m_jobs;
+    std::deque<Task> m_finished;
+    std::size_t m_inFlight;
+    bool m_stopping;
+
+    void workerLoop();
+
+public:
+    explicit AsyncLoader(unsigned int threadCount = 0);
+    ~AsyncLoader();
+
+    AsyncLoader(const AsyncLoader&) = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    void submit(Task decode, Task finish);
+
+    // Runs finished jobs until the budget is spent; always runs at least one
+    // so a large upload can't stall the queue. Returns the number run.
+    std::size_t processFinished(sf::Time budget);
+
+    // Blocks until every submitted job has been decoded and finished.
+    void finishAll();
+
+    std::size_t getPendingCount() const;
+    std::size_t getThreadCount() const;
+};
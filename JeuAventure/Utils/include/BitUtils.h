@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace BitUtils {
+
+    // value must be non-zero.
+    inline int countTrailingZeros(std::uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    // Bits [first, last] set, 0 <= first <= last < 64.
+    inline std::uint64_t rangeMask(int first, int last) {
+        std::uint64_t high = (last == 63) ? ~0ull : ((1ull << (last + 1)) - 1);
+        return high & ~((1ull << first) - 1);
+    }
+
+    inline int popCount(std::uint64_t value) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(value));
+#else
+        return __builtin_popcountll(value);
+#endif
+    }
+}
@@ -12,7 +12,13 @@ class EventSystem {
 private:
     static EventSystem* s_instance;
 
-    std::map<std::string, std::vector<EventCallback>> m_eventListeners;
+    struct Listener {
+        int id;
+        EventCallback callback;
+    };
+
+    std::map<std::string, std::vector<Listener>> m_eventListeners;
+    int m_nextListenerId = 1;
 
     EventSystem() = default;
 
@@ -24,7 +30,10 @@ public:
 
     static void cleanup();
 
-    void addEventListener(const std::string& eventName, EventCallback callback);
+    // Returns an id for removeEventListener().
+    int addEventListener(const std::string& eventName, EventCallback callback);
+
+    void removeEventListener(const std::string& eventName, int listenerId);
 
     void removeAllEventListeners(const std::string& eventName);
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <functional>
+
+// 32-bit FNV-1a. constexpr so that IDs spelled as literals are hashed by the
+// compiler and cost nothing at the call site.
+constexpr std::uint32_t fnv1a(std::string_view text) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+class ResourceId {
+private:
+    std::uint32_t m_hash;
+
+public:
+    constexpr ResourceId() : m_hash(0) {}
+    constexpr explicit ResourceId(std::string_view name) : m_hash(fnv1a(name)) {}
+
+    constexpr std::uint32_t value() const { return m_hash; }
+    constexpr bool isValid() const { return m_hash != 0; }
+
+    constexpr bool operator==(ResourceId other) const { return m_hash == other.m_hash; }
+    constexpr bool operator!=(ResourceId other) const { return m_hash != other.m_hash; }
+};
+
+constexpr ResourceId operator""_rid(const char* text, std::size_t length) {
+    return ResourceId(std::string_view(text, length));
+}
+
+namespace std {
+    template <>
+    struct hash<ResourceId> {
+        std::size_t operator()(ResourceId id) const noexcept {
+            return id.value();
+        }
+    };
+}
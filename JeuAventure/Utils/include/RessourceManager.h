@@ -3,24 +3,167 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <future>
+#include <list>
+#include <vector>
+#include <cstdint>
+#include "TextureAtlas.h"
+#include "AsyncLoader.h"
+#include "AssetArchive.h"
+#include "TextureCache.h"
+#include "AssetHandle.h"
+#include "ResourceId.h"
+
+struct AssetTypeStats {
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+    // Unreferenced assets waiting in the LRU cache.
+    std::size_t cachedCount = 0;
+    std::size_t cachedBytes = 0;
+};
+
+struct ResourceStats {
+    AssetTypeStats types[static_cast<int>(AssetType::Count)];
+    std::size_t atlasBytes = 0;
+    std::size_t residentBytes = 0;
+    std::size_t memoryBudget = 0;
+    std::size_t evictionCount = 0;
+    std::size_t textureCacheHits = 0;
+    std::size_t textureCacheMisses = 0;
+    // Time spent producing texture pixels (cache reads or decodes), loader threads included.
+    sf::Time textureLoadTime;
+
+    const AssetTypeStats& get(AssetType type) const { return types[static_cast<int>(type)]; }
+};
+
+// A character size/outline pair that text is drawn with. sf::Font caches
+// glyphs per pair, so each one needs its own pre-rasterisation.
+struct GlyphStyle {
+    unsigned int characterSize = 30;
+    float outlineThickness = 0.f;
+};
 
 class RessourceManager {
 private:
     static RessourceManager* s_instance;
 
-    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textures;
-    std::unordered_map<std::string, std::unique_ptr<sf::Font>> m_fonts;
-    std::unordered_map<std::string, std::unique_ptr<sf::SoundBuffer>> m_soundBuffers;
-    std::unordered_map<std::string, std::unique_ptr<sf::Music>> m_musics;
+    using LruList = std::list<std::pair<AssetType, std::uint32_t>>;
+
+    // Assets handed out as raw pointers (load*/get*) are pinned: nothing
+    // tracks those pointers, so they are never evicted. Everything else is
+    // kept alive by AssetHandle references and moves to the LRU cache when
+    // the last one is released.
+    template <typename T>
+    struct Entry {
+        std::unique_ptr<T> asset;
+        std::string name;
+        ResourceId id;
+        std::size_t bytes = 0;
+        int refCount = 0;
+        bool pinned = false;
+        bool cached = false;
+        LruList::iterator lruPosition;
+    };
+
+    // One table per asset type. Handles address slots directly; the id
+    // index is only consulted when a handle is resolved. Failed loads are
+    // remembered so a missing file isn't looked up on disk again.
+    template <typename T>
+    struct AssetTable {
+        std::vector<Entry<T>> slots;
+        std::vector<std::uint32_t> freeSlots;
+        std::unordered_map<ResourceId, std::uint32_t> index;
+        std::unordered_map<ResourceId, std::shared_future<bool>> pending;
+        std::unordered_set<ResourceId> failed;
+
+        Entry<T>* find(ResourceId id);
+        const Entry<T>* find(ResourceId id) const;
+        // Drops every entry no handle references and returns the bytes
+        // still held by the others, whose slots stay valid.
+        std::size_t clear();
+    };
+
+    AssetTable<sf::Texture> m_textures;
+    AssetTable<sf::Font> m_fonts;
+    AssetTable<sf::SoundBuffer> m_soundBuffers;
+    AssetTable<sf::Music> m_musics;
+
+    LruList m_lru;
+    std::size_t m_memoryBudget;
+    std::size_t m_residentBytes;
+    std::size_t m_evictionCount;
+
+    // Glyph page bytes per font and character size, see prewarmGlyphs().
+    std::unordered_map<ResourceId, std::unordered_map<unsigned int, std::size_t>> m_glyphPageBytes;
+
+    // Larger images would crowd a 2048px page on their own and are left to
+    // load as textures of their own. The pickup, checkpoint and player
+    // sheets (up to 900x776) all fit on one page together.
+    static constexpr unsigned int MaxAtlasImageSize = 1024;
+    TextureAtlas m_atlas;
+    // Ids addToAtlas() turned away, so each file is only tried once.
+    std::unordered_set<std::string> m_atlasRejected;
 
     std::filesystem::path m_executablePath;
     std::filesystem::path m_resourceBasePath;
 
+    // Ressources.pak, when present, is consulted before the loose files.
+    AssetArchive m_archive;
+    std::filesystem::path m_archiveBasePath;
+
+    TextureCache m_textureCache;
+    std::size_t m_textureCacheHits;
+    std::size_t m_textureCacheMisses;
+    sf::Time m_textureLoadTime;
+
+    // Pixels for one texture, either mapped from the texture cache or
+    // freshly decoded from the source image.
+    struct TexturePixels {
+        MappedFile cacheFile;
+        sf::Image image;
+        const std::uint8_t* pixels = nullptr;
+        sf::Vector2u size;
+        bool fromCache = false;
+        sf::Time loadTime;
+    };
+
+    AsyncLoader m_loader;
+
     RessourceManager();
 
+    std::filesystem::path resolvePath(const std::string& relativePath) const;
+    std::filesystem::path resolveAudioPath(const std::string& filename) const;
+    bool openArchive(const std::filesystem::path& resourceBasePath);
+    const std::uint8_t* findArchived(const std::string& relativePath, std::size_t& size) const;
+
+    template <typename T>
+    bool insertEntry(AssetTable<T>& table, AssetType type, const std::string& name, std::unique_ptr<T> asset, std::size_t bytes, bool pinned);
+    template <typename T>
+    T* pinEntry(AssetTable<T>& table, ResourceId id);
+    template <typename T>
+    AssetHandle<T> acquireEntry(AssetTable<T>& table, ResourceId id);
+    template <typename T>
+    void retainSlot(AssetTable<T>& table, std::uint32_t slot);
+    template <typename T>
+    void releaseSlot(AssetTable<T>& table, AssetType type, std::uint32_t slot);
+    template <typename T>
+    void evictSlot(AssetTable<T>& table, std::uint32_t slot);
+    template <typename T>
+    void accumulateStats(const AssetTable<T>& table, AssetTypeStats& stats) const;
+
+    void evict(AssetType type, std::uint32_t slot);
+    void enforceBudget();
+
+    bool loadTextureEntry(const std::string& id, const std::string& filename, bool pinned);
+    bool readTexturePixels(const std::string& filename, TexturePixels& out) const;
+    bool uploadTexture(const std::string& id, const TexturePixels& source, bool pinned);
+    bool loadFontEntry(const std::string& id, const std::string& filename, bool pinned);
+    bool loadSoundBufferEntry(const std::string& id, const std::string& filename, bool pinned);
+
 public:
     ~RessourceManager();
 
@@ -31,18 +174,75 @@ public:
 
     bool initialize();
 
+    // The std::string overloads hash the name and report misses; they are
+    // meant for load time. The ResourceId overloads are silent and never
+    // touch the filesystem.
     bool loadTexture(const std::string& id, const std::string& filename);
     sf::Texture* getTexture(const std::string& id);
+    sf::Texture* getTexture(ResourceId id);
+    bool hasTexture(const std::string& id) const;
+    bool hasTexture(ResourceId id) const;
+    // Uploads an image that was already decoded elsewhere (e.g. on a loader thread).
+    bool loadTextureFromImage(const std::string& id, const sf::Image& image);
+
+    bool addToAtlas(const std::string& id, const std::string& filename);
+    void packAtlas();
+    AtlasRegion getAtlasRegion(const std::string& id);
+    AtlasRegion loadAtlasRegion(const std::string& id, const std::string& filename);
+    const TextureAtlas& getAtlas() const;
 
     bool loadFont(const std::string& id, const std::string& filename);
     sf::Font* getFont(const std::string& id);
+    sf::Font* getFont(ResourceId id);
 
     bool loadSoundBuffer(const std::string& id, const std::string& filename);
     sf::SoundBuffer* getSoundBuffer(const std::string& id);
+    sf::SoundBuffer* getSoundBuffer(ResourceId id);
 
     bool loadMusic(const std::string& id, const std::string& filename);
     sf::Music* getMusic(const std::string& id);
 
+    // Asynchronous variants: file I/O and decoding run on the loader threads,
+    // the GPU/audio upload happens in processPendingLoads() on the main
+    // thread. The returned future is ready once the asset can be fetched with
+    // the matching get*() call.
+    std::shared_future<bool> loadTextureAsync(const std::string& id, const std::string& filename);
+    std::shared_future<bool> loadFontAsync(const std::string& id, const std::string& filename);
+    std::shared_future<bool> loadSoundBufferAsync(const std::string& id, const std::string& filename);
+
+    void processPendingLoads(sf::Time budget);
+    void finishPendingLoads();
+    std::size_t getPendingLoadCount() const;
+
+    // Reference-counted access. An empty handle means the asset isn't loaded.
+    TextureHandle acquireTexture(ResourceId id);
+    FontHandle acquireFont(ResourceId id);
+    // Loads the font first if it isn't resident yet.
+    FontHandle acquireFont(const std::string& id, const std::string& filename);
+    SoundBufferHandle acquireSoundBuffer(ResourceId id);
+
+    // Starts asynchronous loads for the manifest entries that aren't
+    // resident yet; they wait unreferenced in the LRU cache until acquired.
+    std::vector<std::shared_future<bool>> prefetch(const AssetManifest& manifest);
+    // Loads whatever the manifest still misses and returns handles to all of it.
+    AssetGroup acquire(const AssetManifest& manifest);
+
+    void addReference(AssetType type, std::uint32_t slot);
+    void removeReference(AssetType type, std::uint32_t slot);
+
+    // Rasterises `characters` for every style into the font's glyph pages,
+    // so the first frame that draws them doesn't. Needs the GL context, so
+    // it runs on the main thread; call it at startup. The font is pinned so
+    // the pages outlive the states using it.
+    bool prewarmGlyphs(ResourceId fontId, const std::string& characters, const std::vector<GlyphStyle>& styles);
+
+    void setMemoryBudget(std::size_t bytes);
+    std::size_t getMemoryBudget() const;
+    ResourceStats getStats() const;
+
+    // Joins the base path; doesn't check that the file exists.
     std::filesystem::path getResourcePath(const std::string& relativePath) const;
+    // True if the file is in the archive or on disk. Safe from loader threads.
+    bool resourceExists(const std::string& relativePath) const;
     void clearAll();
 };
\ No newline at end of file
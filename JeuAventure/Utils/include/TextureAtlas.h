@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <memory>
+
+struct AtlasRegion {
+    const sf::Texture* texture;
+    sf::IntRect rect;
+    unsigned int page;
+
+    AtlasRegion() : texture(nullptr), rect(0, 0, 0, 0), page(0) {}
+
+    bool isValid() const { return texture != nullptr; }
+};
+
+// Shelf packer over fixed-size pages. Images are queued with add() and placed
+// by pack() tallest first, so queue a whole batch before packing it; queued
+// images have no region until then. Pages are never rebuilt, so regions
+// handed out stay valid when more images are packed later.
+class TextureAtlas {
+private:
+    struct Shelf {
+        unsigned int y;
+        unsigned int height;
+        unsigned int cursorX;
+    };
+
+    struct Page {
+        std::unique_ptr<sf::Texture> texture;
+        std::vector<Shelf> shelves;
+        unsigned int nextShelfY;
+        unsigned int usedArea;
+    };
+
+    struct PendingImage {
+        std::string id;
+        sf::Image image;
+    };
+
+    unsigned int m_pageSize;
+    unsigned int m_padding;
+
+    std::vector<Page> m_pages;
+    std::unordered_map<std::string, AtlasRegion> m_regions;
+    std::vector<PendingImage> m_pending;
+
+    bool allocate(const sf::Vector2u& size, unsigned int& pageIndex, sf::Vector2u& position);
+    bool createPage();
+    bool insert(const std::string& id, const sf::Image& image);
+
+public:
+    explicit TextureAtlas(unsigned int pageSize = 2048, unsigned int padding = 1);
+
+    bool add(const std::string& id, const sf::Image& image);
+    void pack();
+
+    bool contains(const std::string& id) const;
+    AtlasRegion getRegion(const std::string& id) const;
+
+    std::size_t getPageCount() const;
+    const sf::Texture* getPage(std::size_t index) const;
+    float getOccupancy() const;
+
+    void clear();
+};
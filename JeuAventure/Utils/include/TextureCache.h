@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include "MappedFile.h"
+
+// On-disk layout of a cached texture: the header followed by width*height
+// RGBA8 pixels, row-major. One file per source, named after the source
+// file's content hash, so an edited image simply gets a new entry. Bump
+// Version whenever the header changes.
+namespace TextureCacheFormat {
+
+    const char Magic[4] = { 'J', 'A', 'T', 'X' };
+    const std::uint32_t Version = 1;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t sourceHash;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint64_t pixelOffset;
+    };
+}
+
+// Decoded RGBA copies of the game's images, so startup uploads pixels
+// straight from a mapping instead of running the PNG decoder. load() and
+// store() only touch the filesystem and are safe from loader threads.
+class TextureCache {
+private:
+    std::filesystem::path m_directory;
+
+public:
+    TextureCache();
+
+    void setDirectory(const std::filesystem::path& directory);
+    const std::filesystem::path& getDirectory() const;
+    bool isEnabled() const;
+
+    std::filesystem::path getEntryPath(std::uint64_t sourceHash) const;
+
+    // Maps the cached pixels for a source. On success `pixels` points into
+    // `file` and stays valid until the mapping is closed.
+    bool load(std::uint64_t sourceHash, MappedFile& file, sf::Vector2u& size, const std::uint8_t*& pixels) const;
+    bool store(std::uint64_t sourceHash, const sf::Image& image) const;
+};
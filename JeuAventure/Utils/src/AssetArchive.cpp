@@ -0,0 +1,137 @@
+#include "AssetArchive.h"
+#include <cstring>
+#include <iostream>
+
+AssetArchive::AssetArchive()
+    : m_header(nullptr)
+{
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+
+    if (!m_file.open(path)) {
+        return false;
+    }
+
+    if (m_file.getSize() < sizeof(AssetArchiveFormat::Header)) {
+        std::cerr << "Asset archive too small: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    m_header = at<AssetArchiveFormat::Header>(0);
+
+    if (std::memcmp(m_header->magic, AssetArchiveFormat::Magic, sizeof(AssetArchiveFormat::Magic)) != 0) {
+        std::cerr << "Not an asset archive: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if (m_header->version != AssetArchiveFormat::Version) {
+        std::cerr << "Asset archive version " << m_header->version << " does not match "
+            << AssetArchiveFormat::Version << ", re-run asset_packer: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if (m_header->fileSize != m_file.getSize() || !validate()) {
+        std::cerr << "Corrupt asset archive: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void AssetArchive::close() {
+    m_file.close();
+    m_header = nullptr;
+}
+
+bool AssetArchive::isOpen() const {
+    return m_header != nullptr;
+}
+
+bool AssetArchive::rangeValid(std::uint64_t offset, std::uint64_t count, std::size_t elementSize) const {
+    std::size_t alignment = elementSize < 8 ? elementSize : 8;
+    if (offset % alignment != 0) return false;
+    std::uint64_t end = offset + count * elementSize;
+    return end <= m_file.getSize();
+}
+
+bool AssetArchive::validate() const {
+    const auto& header = *m_header;
+
+    if (!rangeValid(header.stringTableOffset, header.stringTableSize, 1) ||
+        !rangeValid(header.entryTableOffset, header.entryCount, sizeof(AssetArchiveFormat::Entry)) ||
+        !rangeValid(header.blobTableOffset, header.blobCount, sizeof(AssetArchiveFormat::Blob))) {
+        return false;
+    }
+
+    if (header.stringTableSize == 0 || m_file.getData()[header.stringTableOffset + header.stringTableSize - 1] != '\0') {
+        return false;
+    }
+
+    const auto* entries = at<AssetArchiveFormat::Entry>(header.entryTableOffset);
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        if (entries[i].path >= header.stringTableSize || entries[i].blobIndex >= header.blobCount) {
+            return false;
+        }
+        if (i > 0 && entries[i].pathHash < entries[i - 1].pathHash) {
+            return false;
+        }
+    }
+
+    const auto* blobs = at<AssetArchiveFormat::Blob>(header.blobTableOffset);
+    for (std::uint32_t i = 0; i < header.blobCount; ++i) {
+        if (!rangeValid(blobs[i].offset, blobs[i].size, 1)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const std::uint8_t* AssetArchive::find(const std::string& relativePath, std::size_t& size, std::uint64_t* contentHash) const {
+    if (!m_header) return nullptr;
+
+    std::string path = AssetArchiveFormat::normalizePath(relativePath);
+    std::uint32_t hash = AssetArchiveFormat::hashPath(path);
+
+    const auto* begin = at<AssetArchiveFormat::Entry>(m_header->entryTableOffset);
+    const auto* end = begin + m_header->entryCount;
+    const auto* entry = std::lower_bound(begin, end, hash,
+        [](const AssetArchiveFormat::Entry& item, std::uint32_t value) { return item.pathHash < value; });
+
+    const char* strings = at<char>(m_header->stringTableOffset);
+    for (; entry != end && entry->pathHash == hash; ++entry) {
+        if (path != strings + entry->path) continue;
+
+        const auto& blob = at<AssetArchiveFormat::Blob>(m_header->blobTableOffset)[entry->blobIndex];
+        size = static_cast<std::size_t>(blob.size);
+        if (contentHash) {
+            *contentHash = blob.contentHash;
+        }
+        return m_file.getData() + blob.offset;
+    }
+
+    return nullptr;
+}
+
+bool AssetArchive::contains(const std::string& relativePath) const {
+    std::size_t size = 0;
+    return find(relativePath, size) != nullptr;
+}
+
+std::uint32_t AssetArchive::getEntryCount() const {
+    return m_header ? m_header->entryCount : 0;
+}
+
+std::uint32_t AssetArchive::getBlobCount() const {
+    return m_header ? m_header->blobCount : 0;
+}
+
+std::size_t AssetArchive::getSize() const {
+    return m_file.getSize();
+}
@@ -0,0 +1,112 @@
+#include "AsyncLoader.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+
+AsyncLoader::AsyncLoader(unsigned int threadCount)
+    : m_inFlight(0),
+    m_stopping(false)
+{
+    if (threadCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        threadCount = std::max(1u, std::min(4u, hardware > 1 ? hardware - 1 : 1u));
+    }
+
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&AsyncLoader::workerLoop, this);
+    }
+}
+
+AsyncLoader::~AsyncLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_jobAvailable.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void AsyncLoader::submit(Task decode, Task finish) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({ std::move(decode), std::move(finish) });
+        m_inFlight++;
+    }
+    m_jobAvailable.notify_one();
+}
+
+void AsyncLoader::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        if (job.decode) {
+            job.decode();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished.push_back(std::move(job.finish));
+        }
+        m_jobFinished.notify_all();
+    }
+}
+
+std::size_t AsyncLoader::processFinished(sf::Time budget) {
+    sf::Clock budgetClock;
+    std::size_t processed = 0;
+
+    do {
+        Task finish;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_finished.empty()) break;
+
+            finish = std::move(m_finished.front());
+            m_finished.pop_front();
+        }
+
+        if (finish) {
+            finish();
+        }
+        processed++;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inFlight--;
+    } while (budgetClock.getElapsedTime() < budget);
+
+    return processed;
+}
+
+void AsyncLoader::finishAll() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_inFlight == 0) return;
+            m_jobFinished.wait(lock, [this] { return !m_finished.empty() || m_inFlight == 0; });
+        }
+
+        processFinished(sf::Time::Zero);
+    }
+}
+
+std::size_t AsyncLoader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_inFlight;
+}
+
+std::size_t AsyncLoader::getThreadCount() const {
+    return m_workers.size();
+}
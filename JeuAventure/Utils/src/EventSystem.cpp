@@ -17,8 +17,23 @@ void EventSystem::cleanup() {
     }
 }
 
-void EventSystem::addEventListener(const std::string& eventName, EventCallback callback) {
-    m_eventListeners[eventName].push_back(callback);
+int EventSystem::addEventListener(const std::string& eventName, EventCallback callback) {
+    int id = m_nextListenerId++;
+    m_eventListeners[eventName].push_back({ id, callback });
+    return id;
+}
+
+void EventSystem::removeEventListener(const std::string& eventName, int listenerId) {
+    auto it = m_eventListeners.find(eventName);
+    if (it == m_eventListeners.end()) return;
+
+    auto& listeners = it->second;
+    for (auto listener = listeners.begin(); listener != listeners.end(); ++listener) {
+        if (listener->id == listenerId) {
+            listeners.erase(listener);
+            return;
+        }
+    }
 }
 
 void EventSystem::removeAllEventListeners(const std::string& eventName) {
@@ -31,7 +46,9 @@ void EventSystem::removeAllEventListeners(const std::string& eventName) {
 void EventSystem::triggerEvent(const std::string& eventName, const std::map<std::string, std::any>& params) {
     auto it = m_eventListeners.find(eventName);
     if (it != m_eventListeners.end()) {
-        for (auto& callback : it->second) {
+        // Indexed and copied: a callback may add or remove listeners.
+        for (std::size_t i = 0; i < it->second.size(); ++i) {
+            EventCallback callback = it->second[i].callback;
             try {
                 callback(params);
             }
@@ -1,5 +1,9 @@
 #include "RessourceManager.h"
 #include <iostream>
+#include <fstream>
+#include <memory>
+#include <cstring>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -10,7 +14,79 @@
 
 RessourceManager* RessourceManager::s_instance = nullptr;
 
-RessourceManager::RessourceManager() {
+namespace {
+    std::shared_future<bool> makeReadyFuture(bool value) {
+        std::promise<bool> promise;
+        promise.set_value(value);
+        return promise.get_future().share();
+    }
+
+    const char* textureSourceLabel(bool fromCache) {
+        return fromCache ? "cache" : "dcode";
+    }
+
+    struct PendingFont {
+        std::unique_ptr<sf::Font> font = std::make_unique<sf::Font>();
+        std::size_t fileSize = 0;
+        bool decoded = false;
+    };
+
+    struct PendingSound {
+        std::vector<sf::Int16> samples;
+        unsigned int channelCount = 0;
+        unsigned int sampleRate = 0;
+        bool decoded = false;
+    };
+
+    // Width and height from a PNG's IHDR chunk, which always comes first.
+    // Other formats return false and are only sized once decoded.
+    bool readPngSize(const std::uint8_t* data, std::size_t size, sf::Vector2u& out) {
+        static const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        if (size < 24 || std::memcmp(data, signature, sizeof(signature)) != 0 || std::memcmp(data + 12, "IHDR", 4) != 0) {
+            return false;
+        }
+
+        auto readBigEndian = [](const std::uint8_t* bytes) {
+            return (static_cast<unsigned int>(bytes[0]) << 24) | (static_cast<unsigned int>(bytes[1]) << 16) |
+                (static_cast<unsigned int>(bytes[2]) << 8) | static_cast<unsigned int>(bytes[3]);
+        };
+        out = sf::Vector2u(readBigEndian(data + 16), readBigEndian(data + 20));
+        return true;
+    }
+
+    std::size_t textureBytes(const sf::Texture& texture) {
+        return static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4;
+    }
+
+    std::size_t soundBufferBytes(const sf::SoundBuffer& soundBuffer) {
+        return static_cast<std::size_t>(soundBuffer.getSampleCount()) * sizeof(sf::Int16);
+    }
+
+    // sf::Font keeps the face data around; its glyph pages are only counted
+    // once prewarmGlyphs() has rendered them.
+    std::size_t fontFileBytes(const std::filesystem::path& path) {
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(path, error);
+        return error ? 0 : static_cast<std::size_t>(size);
+    }
+}
+
+void retainAsset(AssetType type, std::uint32_t slot) {
+    RessourceManager::getInstance()->addReference(type, slot);
+}
+
+void releaseAsset(AssetType type, std::uint32_t slot) {
+    RessourceManager::getInstance()->removeReference(type, slot);
+}
+
+RessourceManager::RessourceManager()
+    : m_memoryBudget(256 * 1024 * 1024),
+    m_residentBytes(0),
+    m_evictionCount(0),
+    m_textureCacheHits(0),
+    m_textureCacheMisses(0),
+    m_textureLoadTime(sf::Time::Zero)
+{
     initialize();
 }
 
@@ -63,6 +139,12 @@ bool RessourceManager::initialize() {
                     std::cout << "Utilisation du chemin alternatif: " << altPath << std::endl;
                     m_resourceBasePath = altPath;
                 }
+                else if (openArchive(m_resourceBasePath) ||
+                    openArchive(execFilePath.parent_path() / "Ressources") ||
+                    openArchive(altPath)) {
+                    // Packed build: everything is served from the archive.
+                    m_resourceBasePath = m_archiveBasePath;
+                }
                 else {
                     std::cerr << "Impossible de trouver le dossier Ressources" << std::endl;
                     return false;
@@ -70,6 +152,11 @@ bool RessourceManager::initialize() {
             }
         }
 
+        if (!m_archive.isOpen()) {
+            openArchive(m_resourceBasePath);
+        }
+        m_textureCache.setDirectory(m_resourceBasePath.parent_path() / "TextureCache");
+
         std::cout << "Chemin d'excutable: " << m_executablePath << std::endl;
         std::cout << "Chemin des ressources: " << m_resourceBasePath << std::endl;
         return true;
@@ -80,168 +167,944 @@ bool RessourceManager::initialize() {
     }
 }
 
-std::filesystem::path RessourceManager::getResourcePath(const std::string& relativePath) const {
-    std::filesystem::path fullPath = m_resourceBasePath / relativePath;
+// The archive sits next to the folder it replaces: Ressources.pak beside Ressources/.
+bool RessourceManager::openArchive(const std::filesystem::path& resourceBasePath) {
+    std::filesystem::path archivePath = resourceBasePath.parent_path() / "Ressources.pak";
 
-    if (!std::filesystem::exists(fullPath)) {
-        std::cerr << "AVERTISSEMENT: Ressource introuvable: " << fullPath << std::endl;
+    std::error_code error;
+    if (!std::filesystem::exists(archivePath, error) || !m_archive.open(archivePath.string())) {
+        return false;
     }
 
-    return fullPath;
+    m_archiveBasePath = resourceBasePath;
+    std::cout << "Archive de ressources: " << archivePath << " (" << m_archive.getEntryCount() << " fichiers, "
+        << m_archive.getBlobCount() << " blocs uniques, " << m_archive.getSize() / 1024 << " Ko)" << std::endl;
+    return true;
 }
 
-bool RessourceManager::loadTexture(const std::string& id, const std::string& filename) {
-    if (m_textures.find(id) != m_textures.end()) {
+const std::uint8_t* RessourceManager::findArchived(const std::string& relativePath, std::size_t& size) const {
+    return m_archive.find(relativePath, size);
+}
+
+bool RessourceManager::resourceExists(const std::string& relativePath) const {
+    std::size_t size = 0;
+    if (findArchived(relativePath, size)) {
         return true;
     }
 
-    auto filepath = getResourcePath(filename);
+    std::error_code error;
+    return std::filesystem::exists(m_resourceBasePath / relativePath, error);
+}
+
+std::filesystem::path RessourceManager::getResourcePath(const std::string& relativePath) const {
+    return m_resourceBasePath / relativePath;
+}
+
+std::filesystem::path RessourceManager::resolvePath(const std::string& relativePath) const {
+    std::filesystem::path filepath = m_resourceBasePath / relativePath;
+
+    if (!std::filesystem::exists(filepath)) {
+        filepath = relativePath;
+    }
+
+    return filepath;
+}
+
+std::filesystem::path RessourceManager::resolveAudioPath(const std::string& filename) const {
+    std::filesystem::path filepath = m_resourceBasePath / "Audio" / filename;
 
     if (!std::filesystem::exists(filepath)) {
-        if (filename.find("Level_") != std::string::npos) {
-            filepath = getResourcePath(filename);
+        filepath = filename;
+    }
+
+    return filepath;
+}
+
+template <typename T>
+RessourceManager::Entry<T>* RessourceManager::AssetTable<T>::find(ResourceId id) {
+    auto it = index.find(id);
+    return it != index.end() ? &slots[it->second] : nullptr;
+}
+
+template <typename T>
+const RessourceManager::Entry<T>* RessourceManager::AssetTable<T>::find(ResourceId id) const {
+    auto it = index.find(id);
+    return it != index.end() ? &slots[it->second] : nullptr;
+}
+
+template <typename T>
+std::size_t RessourceManager::AssetTable<T>::clear() {
+    std::size_t keptBytes = 0;
+    freeSlots.clear();
+    index.clear();
+    for (std::uint32_t slot = 0; slot < slots.size(); ++slot) {
+        Entry<T>& entry = slots[slot];
+        if (entry.asset && entry.refCount > 0) {
+            entry.cached = false;
+            index[entry.id] = slot;
+            keptBytes += entry.bytes;
         }
+        else {
+            entry = Entry<T>();
+            freeSlots.push_back(slot);
+        }
+    }
+    pending.clear();
+    failed.clear();
+    return keptBytes;
+}
 
-        if (!std::filesystem::exists(filepath)) {
-            filepath = filename;
+template <typename T>
+bool RessourceManager::insertEntry(AssetTable<T>& table, AssetType type, const std::string& name, std::unique_ptr<T> asset, std::size_t bytes, bool pinned) {
+    ResourceId id(name);
+    if (const Entry<T>* existing = table.find(id)) {
+        if (existing->name != name) {
+            std::cerr << "Collision d'identifiants de ressource: " << name << " / " << existing->name << std::endl;
         }
+        return false;
     }
 
-    std::unique_ptr<sf::Texture> texture = std::make_unique<sf::Texture>();
+    std::uint32_t slot;
+    if (!table.freeSlots.empty()) {
+        slot = table.freeSlots.back();
+        table.freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<std::uint32_t>(table.slots.size());
+        table.slots.emplace_back();
+    }
+
+    Entry<T>& entry = table.slots[slot];
+    entry.asset = std::move(asset);
+    entry.name = name;
+    entry.id = id;
+    entry.bytes = bytes;
+    entry.refCount = 0;
+    entry.pinned = pinned;
+    entry.cached = false;
+
+    table.index[id] = slot;
+    table.failed.erase(id);
+    m_residentBytes += bytes;
+
+    if (!pinned) {
+        m_lru.emplace_front(type, slot);
+        entry.lruPosition = m_lru.begin();
+        entry.cached = true;
+    }
+    return true;
+}
+
+template <typename T>
+T* RessourceManager::pinEntry(AssetTable<T>& table, ResourceId id) {
+    Entry<T>* entry = table.find(id);
+    if (!entry) return nullptr;
+
+    if (entry->cached) {
+        m_lru.erase(entry->lruPosition);
+        entry->cached = false;
+    }
+    entry->pinned = true;
+    return entry->asset.get();
+}
+
+template <typename T>
+AssetHandle<T> RessourceManager::acquireEntry(AssetTable<T>& table, ResourceId id) {
+    auto it = table.index.find(id);
+    if (it == table.index.end()) return AssetHandle<T>();
+    return AssetHandle<T>(id, it->second, table.slots[it->second].asset.get());
+}
+
+template <typename T>
+void RessourceManager::retainSlot(AssetTable<T>& table, std::uint32_t slot) {
+    if (slot >= table.slots.size() || !table.slots[slot].asset) return;
+
+    Entry<T>& entry = table.slots[slot];
+    entry.refCount++;
+    if (entry.cached) {
+        m_lru.erase(entry.lruPosition);
+        entry.cached = false;
+    }
+}
+
+template <typename T>
+void RessourceManager::releaseSlot(AssetTable<T>& table, AssetType type, std::uint32_t slot) {
+    // A handle can outlive the manager, whose replacement has no such slot.
+    if (slot >= table.slots.size() || !table.slots[slot].asset) return;
+
+    Entry<T>& entry = table.slots[slot];
+    if (entry.refCount > 0) {
+        entry.refCount--;
+    }
+    if (entry.refCount == 0 && !entry.pinned && !entry.cached) {
+        m_lru.emplace_front(type, slot);
+        entry.lruPosition = m_lru.begin();
+        entry.cached = true;
+    }
+}
+
+template <typename T>
+void RessourceManager::evictSlot(AssetTable<T>& table, std::uint32_t slot) {
+    Entry<T>& entry = table.slots[slot];
+
+    std::cout << "Ressource vince du cache: " << entry.name << " ("
+        << entry.bytes / 1024 << " Ko)" << std::endl;
+
+    m_residentBytes -= entry.bytes;
+    table.index.erase(entry.id);
+    table.freeSlots.push_back(slot);
+    entry = Entry<T>();
+}
 
-    if (!texture->loadFromFile(filepath.string())) {
-        std::cerr << "chec du chargement de la texture: " << filepath << std::endl;
+template <typename T>
+void RessourceManager::accumulateStats(const AssetTable<T>& table, AssetTypeStats& stats) const {
+    for (const auto& entry : table.slots) {
+        if (!entry.asset) continue;
+
+        stats.count++;
+        stats.bytes += entry.bytes;
+        if (entry.cached) {
+            stats.cachedCount++;
+            stats.cachedBytes += entry.bytes;
+        }
+    }
+}
+
+bool RessourceManager::loadTexture(const std::string& id, const std::string& filename) {
+    if (!loadTextureEntry(id, filename, true)) {
         return false;
     }
+    pinEntry(m_textures, ResourceId(id));
+    return true;
+}
 
-    std::cout << "Texture charge avec succs: " << id << " (" << filepath << ")" << std::endl;
+bool RessourceManager::loadTextureEntry(const std::string& id, const std::string& filename, bool pinned) {
+    ResourceId key(id);
+    if (m_textures.find(key)) {
+        return true;
+    }
+    if (m_textures.failed.count(key)) {
+        return false;
+    }
 
-    m_textures[id] = std::move(texture);
+    TexturePixels source;
+    if (!readTexturePixels(filename, source) || !uploadTexture(id, source, pinned)) {
+        std::cerr << "chec du chargement de la texture: " << filename << std::endl;
+        m_textures.failed.insert(key);
+        return false;
+    }
+
+    std::cout << "Texture charge avec succs: " << id << " (" << filename << ", "
+        << textureSourceLabel(source.fromCache) << ", " << source.loadTime.asMicroseconds() << " us)" << std::endl;
     return true;
 }
 
+// Runs on loader threads as well as the main thread: no GL calls, and only
+// the archive and cache, which don't change after initialize().
+bool RessourceManager::readTexturePixels(const std::string& filename, TexturePixels& out) const {
+    sf::Clock loadClock;
+
+    std::size_t sourceSize = 0;
+    std::uint64_t sourceHash = 0;
+    const std::uint8_t* sourceData = m_archive.find(filename, sourceSize, &sourceHash);
+
+    std::vector<std::uint8_t> buffer;
+    if (!sourceData) {
+        std::ifstream file(resolvePath(filename), std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        buffer.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        if (buffer.empty() || !file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+            return false;
+        }
+
+        sourceData = buffer.data();
+        sourceSize = buffer.size();
+        sourceHash = AssetArchiveFormat::hashContent(sourceData, sourceSize);
+    }
+
+    if (m_textureCache.load(sourceHash, out.cacheFile, out.size, out.pixels)) {
+        out.fromCache = true;
+    }
+    else {
+        if (!out.image.loadFromMemory(sourceData, sourceSize)) {
+            return false;
+        }
+        // First load of this source: keep the decoded pixels for next time.
+        m_textureCache.store(sourceHash, out.image);
+
+        out.size = out.image.getSize();
+        out.pixels = out.image.getPixelsPtr();
+        out.fromCache = false;
+    }
+
+    out.loadTime = loadClock.getElapsedTime();
+    return true;
+}
+
+bool RessourceManager::uploadTexture(const std::string& id, const TexturePixels& source, bool pinned) {
+    std::unique_ptr<sf::Texture> texture = std::make_unique<sf::Texture>();
+    if (!texture->create(source.size.x, source.size.y)) {
+        return false;
+    }
+    texture->update(source.pixels);
+
+    if (source.fromCache) {
+        m_textureCacheHits++;
+    }
+    else {
+        m_textureCacheMisses++;
+    }
+    m_textureLoadTime += source.loadTime;
+
+    std::size_t bytes = textureBytes(*texture);
+    return insertEntry(m_textures, AssetType::Texture, id, std::move(texture), bytes, pinned);
+}
+
 sf::Texture* RessourceManager::getTexture(const std::string& id) {
-    auto it = m_textures.find(id);
-    if (it != m_textures.end()) {
-        return it->second.get();
+    if (sf::Texture* texture = getTexture(ResourceId(id))) {
+        return texture;
     }
 
     std::cerr << "Texture introuvable: " << id << std::endl;
     return nullptr;
 }
 
+sf::Texture* RessourceManager::getTexture(ResourceId id) {
+    return pinEntry(m_textures, id);
+}
+
+bool RessourceManager::hasTexture(const std::string& id) const {
+    return hasTexture(ResourceId(id));
+}
 
-bool RessourceManager::loadFont(const std::string& id, const std::string& filename) {
-    if (m_fonts.find(id) != m_fonts.end()) {
+bool RessourceManager::hasTexture(ResourceId id) const {
+    return m_textures.find(id) != nullptr;
+}
+
+bool RessourceManager::loadTextureFromImage(const std::string& id, const sf::Image& image) {
+    if (m_textures.find(ResourceId(id))) {
         return true;
     }
 
-    auto filepath = getResourcePath(filename);
+    std::unique_ptr<sf::Texture> texture = std::make_unique<sf::Texture>();
 
-    if (!std::filesystem::exists(filepath)) {
-        filepath = filename;
+    if (!texture->loadFromImage(image)) {
+        std::cerr << "chec de la cration de la texture: " << id << std::endl;
+        return false;
+    }
+
+    std::size_t bytes = textureBytes(*texture);
+    return insertEntry(m_textures, AssetType::Texture, id, std::move(texture), bytes, false);
+}
+
+bool RessourceManager::addToAtlas(const std::string& id, const std::string& filename) {
+    if (m_atlas.contains(id)) {
+        return true;
+    }
+    if (m_atlasRejected.count(id)) {
+        return false;
+    }
+
+    // Oversized PNGs are turned away from their header, before any decoding.
+    std::uint8_t header[24] = {};
+    std::size_t headerSize = 0;
+    std::size_t archivedSize = 0;
+    if (const std::uint8_t* archived = findArchived(filename, archivedSize)) {
+        headerSize = std::min(archivedSize, sizeof(header));
+        std::memcpy(header, archived, headerSize);
+    }
+    else {
+        std::ifstream file(resolvePath(filename), std::ios::binary);
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        headerSize = static_cast<std::size_t>(file.gcount());
+    }
+
+    sf::Vector2u size;
+    bool sized = readPngSize(header, headerSize, size);
+    if (sized && (size.x > MaxAtlasImageSize || size.y > MaxAtlasImageSize)) {
+        m_atlasRejected.insert(id);
+        return false;
+    }
+
+    // Goes through the texture cache, so a cached source isn't decoded either.
+    TexturePixels source;
+    if (!readTexturePixels(filename, source)) {
+        std::cerr << "chec du chargement de l'image d'atlas: " << filename << std::endl;
+        m_atlasRejected.insert(id);
+        return false;
+    }
+
+    size = source.size;
+    if (size.x > MaxAtlasImageSize || size.y > MaxAtlasImageSize) {
+        m_atlasRejected.insert(id);
+        return false;
+    }
+
+    sf::Image image;
+    if (source.fromCache) {
+        image.create(size.x, size.y, source.pixels);
+    }
+    else {
+        image = source.image;
+    }
+
+    if (!m_atlas.add(id, image)) {
+        m_atlasRejected.insert(id);
+        return false;
+    }
+    return true;
+}
+
+void RessourceManager::packAtlas() {
+    m_atlas.pack();
+
+    std::cout << "Atlas: " << m_atlas.getPageCount() << " page(s), occupation "
+        << static_cast<int>(m_atlas.getOccupancy() * 100.0f) << "%" << std::endl;
+}
+
+AtlasRegion RessourceManager::getAtlasRegion(const std::string& id) {
+    AtlasRegion region = m_atlas.getRegion(id);
+    if (!region.isValid()) {
+        std::cerr << "Rgion d'atlas introuvable: " << id << std::endl;
+    }
+    return region;
+}
+
+AtlasRegion RessourceManager::loadAtlasRegion(const std::string& id, const std::string& filename) {
+    if (!addToAtlas(id, filename)) {
+        return AtlasRegion();
+    }
+
+    // Images queued before packAtlas() are already placed. One seen for the
+    // first time here is packed on its own.
+    AtlasRegion region = m_atlas.getRegion(id);
+    if (!region.isValid()) {
+        m_atlas.pack();
+        region = m_atlas.getRegion(id);
+    }
+    return region;
+}
+
+const TextureAtlas& RessourceManager::getAtlas() const {
+    return m_atlas;
+}
+
+bool RessourceManager::loadFont(const std::string& id, const std::string& filename) {
+    if (!loadFontEntry(id, filename, true)) {
+        return false;
+    }
+    pinEntry(m_fonts, ResourceId(id));
+    return true;
+}
+
+bool RessourceManager::loadFontEntry(const std::string& id, const std::string& filename, bool pinned) {
+    ResourceId key(id);
+    if (m_fonts.find(key)) {
+        return true;
+    }
+    if (m_fonts.failed.count(key)) {
+        return false;
     }
 
     std::unique_ptr<sf::Font> font = std::make_unique<sf::Font>();
 
-    if (!font->loadFromFile(filepath.string())) {
+    // sf::Font reads the face lazily, so archived fonts point straight into
+    // the mapping, which stays open for the manager's lifetime.
+    std::size_t archivedSize = 0;
+    const std::uint8_t* archived = findArchived(filename, archivedSize);
+    auto filepath = archived ? std::filesystem::path(filename) : resolvePath(filename);
+
+    if (archived ? !font->loadFromMemory(archived, archivedSize) : !font->loadFromFile(filepath.string())) {
         std::cerr << "chec du chargement de la police: " << filepath << std::endl;
+        m_fonts.failed.insert(key);
         return false;
     }
 
     std::cout << "Police charge avec succs: " << id << " (" << filepath << ")" << std::endl;
 
-    m_fonts[id] = std::move(font);
-    return true;
+    std::size_t bytes = archived ? archivedSize : fontFileBytes(filepath);
+    return insertEntry(m_fonts, AssetType::Font, id, std::move(font), bytes, pinned);
 }
 
 sf::Font* RessourceManager::getFont(const std::string& id) {
-    auto it = m_fonts.find(id);
-    if (it != m_fonts.end()) {
-        return it->second.get();
+    if (sf::Font* font = getFont(ResourceId(id))) {
+        return font;
     }
 
     std::cerr << "Police introuvable: " << id << std::endl;
     return nullptr;
 }
 
+sf::Font* RessourceManager::getFont(ResourceId id) {
+    return pinEntry(m_fonts, id);
+}
+
 
 bool RessourceManager::loadSoundBuffer(const std::string& id, const std::string& filename) {
+    if (!loadSoundBufferEntry(id, filename, true)) {
+        return false;
+    }
+    pinEntry(m_soundBuffers, ResourceId(id));
+    return true;
+}
 
-    if (m_soundBuffers.find(id) != m_soundBuffers.end()) {
+bool RessourceManager::loadSoundBufferEntry(const std::string& id, const std::string& filename, bool pinned) {
+    ResourceId key(id);
+    if (m_soundBuffers.find(key)) {
         return true;
     }
-
-    auto filepath = getResourcePath("Audio/" + filename);
-
-    if (!std::filesystem::exists(filepath)) {
-        filepath = filename;
+    if (m_soundBuffers.failed.count(key)) {
+        return false;
     }
 
     std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
 
-    if (!soundBuffer->loadFromFile(filepath.string())) {
+    std::size_t archivedSize = 0;
+    const std::uint8_t* archived = findArchived("Audio/" + filename, archivedSize);
+    auto filepath = archived ? std::filesystem::path("Audio/" + filename) : resolveAudioPath(filename);
+
+    if (archived ? !soundBuffer->loadFromMemory(archived, archivedSize) : !soundBuffer->loadFromFile(filepath.string())) {
         std::cerr << "chec du chargement du son: " << filepath << std::endl;
+        m_soundBuffers.failed.insert(key);
         return false;
     }
 
     std::cout << "Son charg avec succs: " << id << " (" << filepath << ")" << std::endl;
 
-    m_soundBuffers[id] = std::move(soundBuffer);
-    return true;
+    std::size_t bytes = soundBufferBytes(*soundBuffer);
+    return insertEntry(m_soundBuffers, AssetType::SoundBuffer, id, std::move(soundBuffer), bytes, pinned);
 }
 
 sf::SoundBuffer* RessourceManager::getSoundBuffer(const std::string& id) {
-    auto it = m_soundBuffers.find(id);
-    if (it != m_soundBuffers.end()) {
-        return it->second.get();
+    if (sf::SoundBuffer* soundBuffer = getSoundBuffer(ResourceId(id))) {
+        return soundBuffer;
     }
 
     std::cerr << "Son introuvable: " << id << std::endl;
     return nullptr;
 }
 
+sf::SoundBuffer* RessourceManager::getSoundBuffer(ResourceId id) {
+    return pinEntry(m_soundBuffers, id);
+}
 
-bool RessourceManager::loadMusic(const std::string& id, const std::string& filename) {
 
-    if (m_musics.find(id) != m_musics.end()) {
+bool RessourceManager::loadMusic(const std::string& id, const std::string& filename) {
+    ResourceId key(id);
+    if (m_musics.find(key)) {
         return true;
     }
-
-    auto filepath = getResourcePath("Audio/" + filename);
-
-    if (!std::filesystem::exists(filepath)) {
-        filepath = filename;
+    if (m_musics.failed.count(key)) {
+        return false;
     }
 
     std::unique_ptr<sf::Music> music = std::make_unique<sf::Music>();
 
-    if (!music->openFromFile(filepath.string())) {
+    std::size_t archivedSize = 0;
+    const std::uint8_t* archived = findArchived("Audio/" + filename, archivedSize);
+    auto filepath = archived ? std::filesystem::path("Audio/" + filename) : resolveAudioPath(filename);
+
+    if (archived ? !music->openFromMemory(archived, archivedSize) : !music->openFromFile(filepath.string())) {
         std::cerr << "chec du chargement de la musique: " << filepath << std::endl;
+        m_musics.failed.insert(key);
         return false;
     }
 
     std::cout << "Musique charge avec succs: " << id << " (" << filepath << ")" << std::endl;
 
-    m_musics[id] = std::move(music);
-    return true;
+    // Streamed from disk: only a small decode buffer stays in memory.
+    return insertEntry(m_musics, AssetType::Music, id, std::move(music), 0, true);
 }
 
 sf::Music* RessourceManager::getMusic(const std::string& id) {
-    auto it = m_musics.find(id);
-    if (it != m_musics.end()) {
-        return it->second.get();
+    if (Entry<sf::Music>* entry = m_musics.find(ResourceId(id))) {
+        return entry->asset.get();
     }
 
     std::cerr << "Musique introuvable: " << id << std::endl;
     return nullptr;
 }
 
+std::shared_future<bool> RessourceManager::loadTextureAsync(const std::string& id, const std::string& filename) {
+    ResourceId key(id);
+    if (m_textures.find(key)) {
+        return makeReadyFuture(true);
+    }
+    if (m_textures.failed.count(key)) {
+        return makeReadyFuture(false);
+    }
+
+    auto pending = m_textures.pending.find(key);
+    if (pending != m_textures.pending.end()) {
+        return pending->second;
+    }
+
+    auto data = std::make_shared<TexturePixels>();
+    auto decoded = std::make_shared<bool>(false);
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::shared_future<bool> future = promise->get_future().share();
+    m_textures.pending[key] = future;
+
+    m_loader.submit(
+        [this, data, decoded, filename]() {
+            *decoded = readTexturePixels(filename, *data);
+        },
+        [this, id, key, data, decoded, filename, promise]() {
+            m_textures.pending.erase(key);
+
+            bool loaded = *decoded && (m_textures.find(key) || uploadTexture(id, *data, false));
+            if (loaded) {
+                std::cout << "Texture charge avec succs: " << id << " (" << filename << ", "
+                    << textureSourceLabel(data->fromCache) << ", " << data->loadTime.asMicroseconds() << " us)" << std::endl;
+            }
+            else {
+                std::cerr << "chec du chargement de la texture: " << filename << std::endl;
+                m_textures.failed.insert(key);
+            }
+            promise->set_value(loaded);
+        });
+
+    return future;
+}
+
+std::shared_future<bool> RessourceManager::loadFontAsync(const std::string& id, const std::string& filename) {
+    ResourceId key(id);
+    if (m_fonts.find(key)) {
+        return makeReadyFuture(true);
+    }
+    if (m_fonts.failed.count(key)) {
+        return makeReadyFuture(false);
+    }
+
+    auto pending = m_fonts.pending.find(key);
+    if (pending != m_fonts.pending.end()) {
+        return pending->second;
+    }
+
+    std::size_t archivedSize = 0;
+    const std::uint8_t* archived = findArchived(filename, archivedSize);
+    auto filepath = archived ? std::filesystem::path(filename) : resolvePath(filename);
+    auto data = std::make_shared<PendingFont>();
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::shared_future<bool> future = promise->get_future().share();
+    m_fonts.pending[key] = future;
+
+    // sf::Font has no GPU state until glyphs are rendered, so the whole
+    // load can happen on the worker.
+    m_loader.submit(
+        [data, filepath, archived, archivedSize]() {
+            if (archived) {
+                data->decoded = data->font->loadFromMemory(archived, archivedSize);
+                data->fileSize = archivedSize;
+            }
+            else {
+                data->decoded = data->font->loadFromFile(filepath.string());
+                data->fileSize = fontFileBytes(filepath);
+            }
+        },
+        [this, id, key, data, filepath, promise]() {
+            m_fonts.pending.erase(key);
+
+            if (!data->decoded) {
+                std::cerr << "chec du chargement de la police: " << filepath << std::endl;
+                m_fonts.failed.insert(key);
+                promise->set_value(false);
+                return;
+            }
+
+            if (!m_fonts.find(key)) {
+                insertEntry(m_fonts, AssetType::Font, id, std::move(data->font), data->fileSize, false);
+            }
+            std::cout << "Police charge avec succs: " << id << " (" << filepath << ")" << std::endl;
+            promise->set_value(true);
+        });
+
+    return future;
+}
+
+std::shared_future<bool> RessourceManager::loadSoundBufferAsync(const std::string& id, const std::string& filename) {
+    ResourceId key(id);
+    if (m_soundBuffers.find(key)) {
+        return makeReadyFuture(true);
+    }
+    if (m_soundBuffers.failed.count(key)) {
+        return makeReadyFuture(false);
+    }
+
+    auto pending = m_soundBuffers.pending.find(key);
+    if (pending != m_soundBuffers.pending.end()) {
+        return pending->second;
+    }
+
+    std::size_t archivedSize = 0;
+    const std::uint8_t* archived = findArchived("Audio/" + filename, archivedSize);
+    auto filepath = archived ? std::filesystem::path("Audio/" + filename) : resolveAudioPath(filename);
+
+    auto data = std::make_shared<PendingSound>();
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::shared_future<bool> future = promise->get_future().share();
+    m_soundBuffers.pending[key] = future;
+
+    m_loader.submit(
+        [data, filepath, archived, archivedSize]() {
+            sf::InputSoundFile file;
+            if (archived ? !file.openFromMemory(archived, archivedSize) : !file.openFromFile(filepath.string())) return;
+
+            data->samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+            sf::Uint64 read = file.read(data->samples.data(), data->samples.size());
+            data->samples.resize(static_cast<std::size_t>(read));
+            data->channelCount = file.getChannelCount();
+            data->sampleRate = file.getSampleRate();
+            data->decoded = true;
+        },
+        [this, id, key, data, filepath, promise]() {
+            m_soundBuffers.pending.erase(key);
+
+            std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
+            if (!data->decoded || !soundBuffer->loadFromSamples(data->samples.data(), data->samples.size(),
+                data->channelCount, data->sampleRate)) {
+                std::cerr << "chec du chargement du son: " << filepath << std::endl;
+                m_soundBuffers.failed.insert(key);
+                promise->set_value(false);
+                return;
+            }
+
+            if (!m_soundBuffers.find(key)) {
+                std::size_t bytes = soundBufferBytes(*soundBuffer);
+                insertEntry(m_soundBuffers, AssetType::SoundBuffer, id, std::move(soundBuffer), bytes, false);
+            }
+            std::cout << "Son charg avec succs: " << id << " (" << filepath << ")" << std::endl;
+            promise->set_value(true);
+        });
+
+    return future;
+}
+
+void RessourceManager::processPendingLoads(sf::Time budget) {
+    if (m_loader.getPendingCount() > 0) {
+        m_loader.processFinished(budget);
+    }
+
+    // Prefetched assets land in the cache without a reference, so the
+    // budget is checked once per frame rather than on every insertion.
+    enforceBudget();
+}
+
+void RessourceManager::finishPendingLoads() {
+    m_loader.finishAll();
+}
+
+std::size_t RessourceManager::getPendingLoadCount() const {
+    return m_loader.getPendingCount();
+}
+
+TextureHandle RessourceManager::acquireTexture(ResourceId id) {
+    return acquireEntry(m_textures, id);
+}
+
+FontHandle RessourceManager::acquireFont(ResourceId id) {
+    return acquireEntry(m_fonts, id);
+}
+
+FontHandle RessourceManager::acquireFont(const std::string& id, const std::string& filename) {
+    if (!loadFontEntry(id, filename, false)) {
+        return FontHandle();
+    }
+    return acquireEntry(m_fonts, ResourceId(id));
+}
+
+SoundBufferHandle RessourceManager::acquireSoundBuffer(ResourceId id) {
+    return acquireEntry(m_soundBuffers, id);
+}
+
+std::vector<std::shared_future<bool>> RessourceManager::prefetch(const AssetManifest& manifest) {
+    std::vector<std::shared_future<bool>> futures;
+    futures.reserve(manifest.entries.size());
+
+    for (const auto& entry : manifest.entries) {
+        switch (entry.type) {
+        case AssetType::Texture:
+            futures.push_back(loadTextureAsync(entry.id, entry.path));
+            break;
+        case AssetType::Font:
+            futures.push_back(loadFontAsync(entry.id, entry.path));
+            break;
+        case AssetType::SoundBuffer:
+            futures.push_back(loadSoundBufferAsync(entry.id, entry.path));
+            break;
+        default:
+            break;
+        }
+    }
+
+    return futures;
+}
+
+AssetGroup RessourceManager::acquire(const AssetManifest& manifest) {
+    AssetGroup group;
+
+    for (const auto& entry : manifest.entries) {
+        switch (entry.type) {
+        case AssetType::Texture:
+            if (loadTextureEntry(entry.id, entry.path, false)) {
+                group.textures.push_back(acquireTexture(ResourceId(entry.id)));
+            }
+            break;
+        case AssetType::Font:
+            if (loadFontEntry(entry.id, entry.path, false)) {
+                group.fonts.push_back(acquireFont(ResourceId(entry.id)));
+            }
+            break;
+        case AssetType::SoundBuffer:
+            if (loadSoundBufferEntry(entry.id, entry.path, false)) {
+                group.soundBuffers.push_back(acquireSoundBuffer(ResourceId(entry.id)));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return group;
+}
+
+void RessourceManager::addReference(AssetType type, std::uint32_t slot) {
+    switch (type) {
+    case AssetType::Texture: retainSlot(m_textures, slot); break;
+    case AssetType::Font: retainSlot(m_fonts, slot); break;
+    case AssetType::SoundBuffer: retainSlot(m_soundBuffers, slot); break;
+    default: break;
+    }
+}
+
+void RessourceManager::removeReference(AssetType type, std::uint32_t slot) {
+    switch (type) {
+    case AssetType::Texture: releaseSlot(m_textures, type, slot); break;
+    case AssetType::Font: releaseSlot(m_fonts, type, slot); break;
+    case AssetType::SoundBuffer: releaseSlot(m_soundBuffers, type, slot); break;
+    default: break;
+    }
+
+    enforceBudget();
+}
+
+void RessourceManager::evict(AssetType type, std::uint32_t slot) {
+    switch (type) {
+    case AssetType::Texture: evictSlot(m_textures, slot); break;
+    case AssetType::Font: evictSlot(m_fonts, slot); break;
+    case AssetType::SoundBuffer: evictSlot(m_soundBuffers, slot); break;
+    default: break;
+    }
+
+    m_evictionCount++;
+}
+
+void RessourceManager::enforceBudget() {
+    while (m_residentBytes > m_memoryBudget && !m_lru.empty()) {
+        std::pair<AssetType, std::uint32_t> oldest = m_lru.back();
+        m_lru.pop_back();
+        evict(oldest.first, oldest.second);
+    }
+}
+
+bool RessourceManager::prewarmGlyphs(ResourceId fontId, const std::string& characters, const std::vector<GlyphStyle>& styles) {
+    Entry<sf::Font>* entry = m_fonts.find(fontId);
+    if (!entry) {
+        return false;
+    }
+
+    sf::Clock prewarmClock;
+    sf::Font& font = *entry->asset;
+    std::size_t glyphCount = 0;
+
+    for (const GlyphStyle& style : styles) {
+        for (unsigned char character : characters) {
+            // Outlined text draws the plain glyph on top of the outline one.
+            font.getGlyph(character, style.characterSize, false, 0.f);
+            if (style.outlineThickness > 0.f) {
+                font.getGlyph(character, style.characterSize, false, style.outlineThickness);
+            }
+            glyphCount++;
+        }
+    }
+
+    // The pages are real GPU memory now, so they count against the budget.
+    // Pages grow when glyphs are added, so only the growth is accounted.
+    std::unordered_map<unsigned int, std::size_t>& pages = m_glyphPageBytes[fontId];
+    std::size_t pageBytes = 0;
+    for (const GlyphStyle& style : styles) {
+        std::size_t bytes = textureBytes(font.getTexture(style.characterSize));
+        std::size_t& counted = pages[style.characterSize];
+        if (bytes > counted) {
+            m_residentBytes += bytes - counted;
+            entry->bytes += bytes - counted;
+            counted = bytes;
+        }
+    }
+    for (const auto& page : pages) {
+        pageBytes += page.second;
+    }
+
+    pinEntry(m_fonts, fontId);
+
+    std::cout << "Glyphes pr-rendus: " << entry->name << " (" << glyphCount << " glyphes, "
+        << pageBytes / 1024 << " KB, " << prewarmClock.getElapsedTime().asMilliseconds() << " ms)" << std::endl;
+    return true;
+}
+
+void RessourceManager::setMemoryBudget(std::size_t bytes) {
+    m_memoryBudget = bytes;
+    enforceBudget();
+}
+
+std::size_t RessourceManager::getMemoryBudget() const {
+    return m_memoryBudget;
+}
+
+ResourceStats RessourceManager::getStats() const {
+    ResourceStats stats;
+    accumulateStats(m_textures, stats.types[static_cast<int>(AssetType::Texture)]);
+    accumulateStats(m_fonts, stats.types[static_cast<int>(AssetType::Font)]);
+    accumulateStats(m_soundBuffers, stats.types[static_cast<int>(AssetType::SoundBuffer)]);
+    accumulateStats(m_musics, stats.types[static_cast<int>(AssetType::Music)]);
+
+    for (std::size_t i = 0; i < m_atlas.getPageCount(); ++i) {
+        if (const sf::Texture* page = m_atlas.getPage(i)) {
+            stats.atlasBytes += textureBytes(*page);
+        }
+    }
+
+    stats.residentBytes = m_residentBytes;
+    stats.memoryBudget = m_memoryBudget;
+    stats.evictionCount = m_evictionCount;
+    stats.textureCacheHits = m_textureCacheHits;
+    stats.textureCacheMisses = m_textureCacheMisses;
+    stats.textureLoadTime = m_textureLoadTime;
+    return stats;
+}
+
 void RessourceManager::clearAll() {
-    m_textures.clear();
-    m_fonts.clear();
-    m_soundBuffers.clear();
-    m_musics.clear();
+    // Assets still referenced by a handle are kept, so the handle's slot
+    // stays valid until it is released.
+    m_lru.clear();
+    m_residentBytes = m_textures.clear();
+    m_residentBytes += m_fonts.clear();
+    m_residentBytes += m_soundBuffers.clear();
+    m_residentBytes += m_musics.clear();
+    for (auto it = m_glyphPageBytes.begin(); it != m_glyphPageBytes.end();) {
+        if (m_fonts.index.count(it->first)) {
+            ++it;
+        }
+        else {
+            it = m_glyphPageBytes.erase(it);
+        }
+    }
+    m_atlas.clear();
+    m_atlasRejected.clear();
 
     std::cout << "Toutes les ressources ont t libres." << std::endl;
-}
\ No newline at end of file
+}
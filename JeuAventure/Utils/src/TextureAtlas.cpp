@@ -0,0 +1,184 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding)
+    : m_pageSize(pageSize),
+    m_padding(padding)
+{
+}
+
+bool TextureAtlas::add(const std::string& id, const sf::Image& image) {
+    if (contains(id)) {
+        return true;
+    }
+
+    sf::Vector2u size = image.getSize();
+    if (size.x == 0 || size.y == 0) {
+        std::cerr << "Atlas: image vide ignoree: " << id << std::endl;
+        return false;
+    }
+
+    if (size.x + m_padding * 2 > m_pageSize || size.y + m_padding * 2 > m_pageSize) {
+        std::cerr << "Atlas: image trop grande pour une page (" << size.x << "x" << size.y
+            << "): " << id << std::endl;
+        return false;
+    }
+
+    PendingImage pending;
+    pending.id = id;
+    pending.image = image;
+    m_pending.push_back(std::move(pending));
+    return true;
+}
+
+void TextureAtlas::pack() {
+    if (m_pending.empty()) return;
+
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+        [](const PendingImage& a, const PendingImage& b) {
+            return a.image.getSize().y > b.image.getSize().y;
+        });
+
+    for (const auto& pending : m_pending) {
+        insert(pending.id, pending.image);
+    }
+
+    m_pending.clear();
+}
+
+bool TextureAtlas::createPage() {
+    sf::Vector2u maxSize(sf::Texture::getMaximumSize(), sf::Texture::getMaximumSize());
+    if (m_pageSize > maxSize.x) {
+        m_pageSize = maxSize.x;
+    }
+
+    Page page;
+    page.texture = std::make_unique<sf::Texture>();
+    if (!page.texture->create(m_pageSize, m_pageSize)) {
+        std::cerr << "Atlas: impossible de creer une page " << m_pageSize << "x" << m_pageSize << std::endl;
+        return false;
+    }
+
+    // Padding texels must be transparent, so clear the page once up front.
+    sf::Image blank;
+    blank.create(m_pageSize, m_pageSize, sf::Color::Transparent);
+    page.texture->update(blank);
+
+    page.nextShelfY = 0;
+    page.usedArea = 0;
+    m_pages.push_back(std::move(page));
+    return true;
+}
+
+bool TextureAtlas::allocate(const sf::Vector2u& size, unsigned int& pageIndex, sf::Vector2u& position) {
+    unsigned int width = size.x + m_padding * 2;
+    unsigned int height = size.y + m_padding * 2;
+    if (width > m_pageSize || height > m_pageSize) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < m_pages.size(); ++i) {
+        Page& page = m_pages[i];
+
+        for (auto& shelf : page.shelves) {
+            if (height <= shelf.height && shelf.cursorX + width <= m_pageSize) {
+                position = sf::Vector2u(shelf.cursorX + m_padding, shelf.y + m_padding);
+                shelf.cursorX += width;
+                page.usedArea += width * height;
+                pageIndex = static_cast<unsigned int>(i);
+                return true;
+            }
+        }
+
+        if (page.nextShelfY + height <= m_pageSize) {
+            Shelf shelf;
+            shelf.y = page.nextShelfY;
+            shelf.height = height;
+            shelf.cursorX = width;
+            page.shelves.push_back(shelf);
+            page.nextShelfY += height;
+            page.usedArea += width * height;
+
+            position = sf::Vector2u(m_padding, shelf.y + m_padding);
+            pageIndex = static_cast<unsigned int>(i);
+            return true;
+        }
+    }
+
+    if (!createPage()) {
+        return false;
+    }
+
+    return allocate(size, pageIndex, position);
+}
+
+bool TextureAtlas::insert(const std::string& id, const sf::Image& image) {
+    unsigned int pageIndex = 0;
+    sf::Vector2u position;
+
+    if (!allocate(image.getSize(), pageIndex, position)) {
+        std::cerr << "Atlas: echec du placement de " << id << std::endl;
+        return false;
+    }
+
+    sf::Texture* page = m_pages[pageIndex].texture.get();
+    page->update(image, position.x, position.y);
+
+    AtlasRegion region;
+    region.texture = page;
+    region.rect = sf::IntRect(
+        static_cast<int>(position.x),
+        static_cast<int>(position.y),
+        static_cast<int>(image.getSize().x),
+        static_cast<int>(image.getSize().y));
+    region.page = pageIndex;
+
+    m_regions[id] = region;
+    return true;
+}
+
+bool TextureAtlas::contains(const std::string& id) const {
+    if (m_regions.find(id) != m_regions.end()) {
+        return true;
+    }
+
+    return std::any_of(m_pending.begin(), m_pending.end(),
+        [&id](const PendingImage& pending) { return pending.id == id; });
+}
+
+AtlasRegion TextureAtlas::getRegion(const std::string& id) const {
+    auto it = m_regions.find(id);
+    return it != m_regions.end() ? it->second : AtlasRegion();
+}
+
+std::size_t TextureAtlas::getPageCount() const {
+    return m_pages.size();
+}
+
+const sf::Texture* TextureAtlas::getPage(std::size_t index) const {
+    if (index >= m_pages.size()) {
+        return nullptr;
+    }
+    return m_pages[index].texture.get();
+}
+
+float TextureAtlas::getOccupancy() const {
+    if (m_pages.empty()) {
+        return 0.0f;
+    }
+
+    float used = 0.0f;
+    for (const auto& page : m_pages) {
+        used += static_cast<float>(page.usedArea);
+    }
+
+    float total = static_cast<float>(m_pageSize) * static_cast<float>(m_pageSize) * m_pages.size();
+    return used / total;
+}
+
+void TextureAtlas::clear() {
+    m_pages.clear();
+    m_regions.clear();
+    m_pending.clear();
+}
@@ -0,0 +1,102 @@
+#include "TextureCache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+TextureCache::TextureCache() {
+}
+
+void TextureCache::setDirectory(const std::filesystem::path& directory) {
+    m_directory = directory;
+}
+
+const std::filesystem::path& TextureCache::getDirectory() const {
+    return m_directory;
+}
+
+bool TextureCache::isEnabled() const {
+    return !m_directory.empty();
+}
+
+std::filesystem::path TextureCache::getEntryPath(std::uint64_t sourceHash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.rgba", static_cast<unsigned long long>(sourceHash));
+    return m_directory / name;
+}
+
+bool TextureCache::load(std::uint64_t sourceHash, MappedFile& file, sf::Vector2u& size, const std::uint8_t*& pixels) const {
+    if (!isEnabled()) return false;
+
+    std::filesystem::path path = getEntryPath(sourceHash);
+    std::error_code error;
+    if (!std::filesystem::exists(path, error) || !file.open(path.string())) {
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const TextureCacheFormat::Header*>(file.getData());
+    if (file.getSize() < sizeof(TextureCacheFormat::Header) ||
+        std::memcmp(header->magic, TextureCacheFormat::Magic, sizeof(TextureCacheFormat::Magic)) != 0 ||
+        header->version != TextureCacheFormat::Version ||
+        header->sourceHash != sourceHash) {
+        file.close();
+        return false;
+    }
+
+    std::uint64_t pixelBytes = static_cast<std::uint64_t>(header->width) * header->height * 4;
+    if (header->pixelOffset + pixelBytes != file.getSize()) {
+        std::cerr << "Corrupt texture cache entry: " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    size = sf::Vector2u(header->width, header->height);
+    pixels = file.getData() + header->pixelOffset;
+    return true;
+}
+
+bool TextureCache::store(std::uint64_t sourceHash, const sf::Image& image) const {
+    if (!isEnabled()) return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    TextureCacheFormat::Header header;
+    std::memcpy(header.magic, TextureCacheFormat::Magic, sizeof(header.magic));
+    header.version = TextureCacheFormat::Version;
+    header.sourceHash = sourceHash;
+    header.width = image.getSize().x;
+    header.height = image.getSize().y;
+    header.pixelOffset = sizeof(header);
+
+    // Written under a per-thread name and renamed into place, so a reader
+    // never maps a half-written entry.
+    std::filesystem::path path = getEntryPath(sourceHash);
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    {
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) {
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(image.getPixelsPtr()),
+            static_cast<std::streamsize>(header.width) * header.height * 4);
+        if (!output) {
+            output.close();
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
@@ -14,9 +14,16 @@ private:
     float m_pulseFrequency;
     float m_pulseAmplitude;
     bool m_showRadius;
+    int m_triggerVolume;
+    sf::FloatRect m_triggerBounds;
 
     std::function<void()> m_onActivateCallback;
 
+    sf::FloatRect getTriggerBounds() const;
+    void registerTriggerVolume();
+    // Follows setPosition() and radius changes; called from update().
+    void syncTriggerVolume();
+
 public:
     Checkpoint();
     Checkpoint(const sf::Vector2f& position, float radius = 2.0f);
@@ -24,7 +31,8 @@ public:
     void initialize() override;
     void update(float dt) override;
     void render(sf::RenderWindow& window) override;
-    void onCollisionEnter(Collider* other) override;
+    void render(SpriteBatch& batch) override;
+    void onTriggerEnter(Entity* activator) override;
 
     void activate();
     void deactivate();
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include "CookedLevelFormat.h"
+#include "MappedFile.h"
+
+// Zero-parse view over a cooked level project. open() maps the file and
+// checks every table against the file size once; accessors are then plain
+// pointer arithmetic into the mapping.
+class CookedLevelFile {
+private:
+    MappedFile m_file;
+    const CookedLevelFormat::Header* m_header;
+
+    template <typename T>
+    const T* at(std::uint32_t offset) const {
+        return reinterpret_cast<const T*>(m_file.getData() + offset);
+    }
+
+    bool rangeValid(std::uint32_t offset, std::uint64_t count, std::size_t elementSize) const;
+    bool validate() const;
+
+public:
+    CookedLevelFile();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    const CookedLevelFormat::Header& getHeader() const;
+
+    std::uint32_t getLevelCount() const;
+    const CookedLevelFormat::Level* getLevel(std::uint32_t index) const;
+    const CookedLevelFormat::Level* findLevel(const std::string& identifier) const;
+
+    std::uint32_t getTilesetCount() const;
+    const CookedLevelFormat::Tileset* getTileset(std::uint32_t index) const;
+
+    const CookedLevelFormat::Layer* getLayers(const CookedLevelFormat::Level& level) const;
+    const CookedLevelFormat::Tile* getTiles(const CookedLevelFormat::Layer& layer) const;
+    const CookedLevelFormat::Entity* getEntities(const CookedLevelFormat::Level& level) const;
+    const std::uint64_t* getCollisionWords(const CookedLevelFormat::Level& level) const;
+
+    const char* getString(std::uint32_t offset) const;
+};
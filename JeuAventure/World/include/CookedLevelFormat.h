@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout written by the level_cooker tool and mapped as-is by
+// CookedLevelFile. Little-endian, every section 8-byte aligned, all offsets
+// are from the start of the file except string offsets, which index the
+// string table. Bump Version whenever a struct changes.
+namespace CookedLevelFormat {
+
+    const char Magic[4] = { 'J', 'A', 'L', 'V' };
+    const std::uint32_t Version = 1;
+
+    const std::uint8_t TileFlipX = 1;
+    const std::uint8_t TileFlipY = 2;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t fileSize;
+        std::uint32_t defaultGridSize;
+        std::uint32_t levelCount;
+        std::uint32_t levelTableOffset;
+        std::uint32_t tilesetCount;
+        std::uint32_t tilesetTableOffset;
+        std::uint32_t stringTableOffset;
+        std::uint32_t stringTableSize;
+    };
+
+    struct Tileset {
+        std::uint32_t uid;
+        std::uint32_t identifier;
+        std::uint32_t relPath;
+        std::uint32_t tileSize;
+        std::uint32_t columns;
+    };
+
+    struct Level {
+        std::uint32_t identifier;
+        std::int32_t worldX;
+        std::int32_t worldY;
+        std::uint32_t pxWidth;
+        std::uint32_t pxHeight;
+        std::uint32_t gridSize;
+        std::uint32_t cellsX;
+        std::uint32_t cellsY;
+        std::uint32_t collisionOffset;
+        std::uint32_t collisionWordsPerRow;
+        std::uint32_t layerOffset;
+        std::uint32_t layerCount;
+        std::uint32_t entityOffset;
+        std::uint32_t entityCount;
+    };
+
+    // Tile layers are stored bottom-up, in draw order.
+    struct Layer {
+        std::uint32_t identifier;
+        std::uint32_t tilesetIndex;
+        std::int32_t offsetX;
+        std::int32_t offsetY;
+        float opacity;
+        std::uint32_t gridSize;
+        std::uint32_t cellsX;
+        std::uint32_t cellsY;
+        std::uint32_t tileOffset;
+        std::uint32_t tileCount;
+    };
+
+    struct Tile {
+        std::uint16_t tileId;
+        std::uint16_t cellX;
+        std::uint16_t cellY;
+        std::uint8_t flags;
+        std::uint8_t reserved;
+    };
+
+    struct Entity {
+        std::uint32_t identifier;
+        std::int32_t x;
+        std::int32_t y;
+        std::uint32_t width;
+        std::uint32_t height;
+    };
+
+    static_assert(sizeof(Header) == 40, "CookedLevelFormat::Header layout changed");
+    static_assert(sizeof(Tileset) == 20, "CookedLevelFormat::Tileset layout changed");
+    static_assert(sizeof(Level) == 56, "CookedLevelFormat::Level layout changed");
+    static_assert(sizeof(Layer) == 40, "CookedLevelFormat::Layer layout changed");
+    static_assert(sizeof(Tile) == 8, "CookedLevelFormat::Tile layout changed");
+    static_assert(sizeof(Entity) == 20, "CookedLevelFormat::Entity layout changed");
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Tilemap;
+class TileLayerMesh;
+
+// Runtime edits of the level's solid cells (bombs, digging). An edit changes
+// the Tilemap collision cells, then re-tiles only the 3x3 neighbourhood of
+// the changed cells in the terrain layers, so its cost follows the edit size
+// rather than the level size. The merged colliders pick the change up through
+// the tilemap's collision listener; everything else can listen for the
+// "TerrainChanged" event ("cells": sf::IntRect, "area": sf::FloatRect).
+//
+// Auto-tile rules map the solid neighbours of a terrain cell to a tile ID,
+// indexed by the Neighbour bits. -1 keeps the tile already placed, so a
+// layer whose 16 rules are all -1 only has its destroyed cells cleared.
+// Layers without rules (backgrounds, props) are never touched.
+class DestructibleTerrain {
+public:
+    enum Neighbour {
+        North = 1 << 0,
+        East = 1 << 1,
+        South = 1 << 2,
+        West = 1 << 3
+    };
+
+    using AutoTileRules = std::array<int, 16>;
+
+private:
+    struct Layer {
+        TileLayerMesh* mesh;
+        const AutoTileRules* rules;
+    };
+
+    Tilemap* m_tilemap;
+    std::unordered_map<std::string, AutoTileRules> m_rules;
+    std::vector<Layer> m_layers;
+
+    // Cells changed by the current edit, relative to m_editBounds.
+    std::vector<sf::Vector2i> m_editCells;
+    std::vector<bool> m_editMask;
+    sf::IntRect m_editBounds;
+
+    std::size_t m_lastEditCells;
+    sf::Time m_lastEditTime;
+
+    void collectCells(const sf::FloatRect& area, bool collidable);
+    bool isSolidAt(float x, float y) const;
+    bool wasEdited(float x, float y) const;
+    void retileLayer(const Layer& layer, const sf::FloatRect& area);
+    int applyEdit(bool solid);
+
+public:
+    DestructibleTerrain();
+
+    // { "<layer identifier>": [16 tile IDs] }
+    bool loadRules(const std::string& filename);
+    void setRules(const std::string& layerName, const AutoTileRules& rules);
+
+    void setTilemap(Tilemap* tilemap);
+    // Registers the mesh if its layer has rules; returns whether it did.
+    bool addLayer(TileLayerMesh* mesh);
+    void clear();
+
+    // Return the number of cells that changed.
+    int destroyArea(const sf::FloatRect& area);
+    int destroyCircle(const sf::Vector2f& center, float radius);
+    int fillArea(const sf::FloatRect& area);
+
+    std::size_t getLayerCount() const;
+    std::size_t getLastEditCellCount() const;
+    sf::Time getLastEditTime() const;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <nlohmann/json.hpp>
+#include "TileLayerMesh.h"
+
+struct LdtkTilesetInfo {
+    int uid = -1;
+    std::string identifier;
+    std::string relPath;
+    int tileGridSize = 0;
+    int columns = 0;
+};
+
+struct LdtkTileLayer {
+    std::string identifier;
+    int tilesetDefUid = -1;
+    int gridSize = 0;
+    int cellsX = 0;
+    int cellsY = 0;
+    int offsetX = 0;
+    int offsetY = 0;
+    float opacity = 1.0f;
+    std::vector<LayerTile> tiles;
+};
+
+struct LdtkEntityInfo {
+    std::string identifier;
+    int x = 0;
+    int y = 0;
+    int width = 16;
+    int height = 16;
+};
+
+struct LdtkLevelInfo {
+    std::string identifier;
+    int worldX = 0;
+    int worldY = 0;
+    int pxWidth = 0;
+    int pxHeight = 0;
+};
+
+// Everything LevelLoader needs from one level of an LDtk project, decoded
+// without keeping the JSON around.
+struct LdtkLevelData {
+    int defaultGridSize = 16;
+    int defaultLevelWidth = 0;
+    int defaultLevelHeight = 0;
+
+    // Header of every level in the project; only levels[levelIndex] has
+    // its layers decoded.
+    std::vector<LdtkLevelInfo> levels;
+    int levelIndex = -1;
+
+    // Only the tilesets the decoded level references.
+    std::vector<LdtkTilesetInfo> tilesets;
+
+    // Bottom-up, in draw order.
+    std::vector<LdtkTileLayer> tileLayers;
+
+    // IntGrid values > 0, one 64-bit word per 64 cells of a row.
+    int collisionGridSize = 0;
+    int collisionCellsX = 0;
+    int collisionCellsY = 0;
+    int collisionWordsPerRow = 0;
+    std::vector<std::uint64_t> collisionWords;
+
+    std::vector<LdtkEntityInfo> entities;
+
+    const LdtkLevelInfo* getLevel() const;
+    const LdtkTilesetInfo* findTileset(int uid) const;
+};
+
+// SAX handler for LDtk project files. Walks the document once and only
+// materialises the requested level: other levels' layers, unused defs and
+// per-tile metadata are skipped as they stream past.
+class LdtkStreamParser : public nlohmann::json::json_sax_t {
+public:
+    // An empty levelIdentifier selects the first level.
+    static bool parse(std::istream& input, const std::string& levelIdentifier, LdtkLevelData& out);
+
+    bool null() override;
+    bool boolean(bool value) override;
+    bool number_integer(number_integer_t value) override;
+    bool number_unsigned(number_unsigned_t value) override;
+    bool number_float(number_float_t value, const string_t& text) override;
+    bool string(string_t& value) override;
+    bool binary(binary_t& value) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& value) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::json::exception& ex) override;
+
+private:
+    enum class Context {
+        Root,
+        Defs,
+        TilesetArray,
+        Tileset,
+        LevelArray,
+        Level,
+        LayerArray,
+        Layer,
+        IntGridCsv,
+        TileArray,
+        Tile,
+        TilePx,
+        EntityArray,
+        Entity,
+        EntityGrid
+    };
+
+    LdtkStreamParser(const std::string& levelIdentifier, LdtkLevelData& out);
+
+    bool enter(bool isArray);
+    bool onNumber(double value);
+    void finishLayer();
+    void finishLevel();
+
+    std::string m_levelIdentifier;
+    LdtkLevelData& m_out;
+
+    std::vector<Context> m_stack;
+    int m_skipDepth;
+    std::string m_key;
+    std::string m_error;
+
+    bool m_levelSelected;
+    bool m_levelDone;
+    std::vector<LdtkTilesetInfo> m_allTilesets;
+    LdtkTilesetInfo m_tileset;
+    LdtkLevelInfo m_level;
+
+    std::string m_layerType;
+    LdtkTileLayer m_layer;
+    std::vector<LayerTile> m_autoTiles;
+    bool m_inAutoTiles;
+    int m_csvIndex;
+    LayerTile m_tile;
+    int m_arrayIndex;
+    LdtkEntityInfo m_entity;
+    int m_entityGridSize;
+    std::vector<LdtkTileLayer> m_topDownLayers;
+};
@@ -6,12 +6,21 @@
 #include <unordered_map>
 #include <memory>
 #include "Checkpoint.h"
+#include "SpriteBatch.h"
+#include "AssetHandle.h"
 
 class Entity;
 class Tilemap;
+class TileColliderSet;
+class DestructibleTerrain;
+class TileLightMap;
+class TriggerVolumeSystem;
+class PickupField;
+class TileLayerMesh;
 class Background;
 class Player;
 class Checkpoint;
+class WorldStreamer;
 
 class Level {
 private:
@@ -24,13 +33,22 @@ private:
     std::unordered_map<std::string, std::string> m_properties;
 
     std::unique_ptr<Tilemap> m_tilemap;
+    // Declared after m_tilemap: it detaches from the tilemap on destruction.
+    std::unique_ptr<TileColliderSet> m_tileColliders;
 
     std::unique_ptr<Background> m_background;
 
     std::vector<std::unique_ptr<sf::Sprite>> m_layers;
+    AssetGroup m_assets;
+    std::vector<std::unique_ptr<TileLayerMesh>> m_tileMeshes;
+    std::unique_ptr<DestructibleTerrain> m_terrain;
+    std::unique_ptr<TileLightMap> m_lighting;
+    int m_playerLight;
     sf::Vector2f m_scale;
 
     std::vector<Entity*> m_entities;
+    std::unique_ptr<TriggerVolumeSystem> m_triggerVolumes;
+    std::unique_ptr<PickupField> m_pickups;
 
     sf::Vector2f m_playerStartPosition;
 
@@ -51,6 +69,13 @@ private:
 
     float m_levelTimer;
 
+    SpriteBatch m_spriteBatch;
+
+    std::unique_ptr<WorldStreamer> m_worldStreamer;
+
+    // Listeners capturing this level, removed on destruction.
+    std::vector<std::pair<std::string, int>> m_eventListeners;
+
 public:
     Level(const std::string& name = "");
     ~Level();
@@ -69,6 +94,13 @@ public:
 
     void setTilemap(Tilemap* tilemap);
     Tilemap* getTilemap() const;
+    const TileColliderSet* getTileColliders() const;
+    DestructibleTerrain* getTerrain() const;
+    TileLightMap* getLighting() const;
+    TriggerVolumeSystem* getTriggerVolumes() const;
+    PickupField* getPickups() const;
+
+    const SpriteBatch& getSpriteBatch() const;
 
     void setBackground(const std::string& texturePath);
     Background* getBackground() const;
@@ -117,6 +149,16 @@ public:
     void addPlatformLayer(sf::Texture* texture);
 
     void addTileLayer(std::unique_ptr<sf::Sprite> layer);
+    void addTileMesh(std::unique_ptr<TileLayerMesh> mesh);
+    const std::vector<std::unique_ptr<TileLayerMesh>>& getTileMeshes() const;
+    void clearTileMeshes();
+
+    void setAssets(AssetGroup assets);
+    const AssetGroup& getAssets() const;
+
+    void setWorldStreamer(std::unique_ptr<WorldStreamer> streamer);
+    WorldStreamer* getWorldStreamer() const;
+
     void addParallaxLayer(sf::Sprite* sprite, const sf::Vector2f& parallaxFactor);
     void setBackground(sf::Texture* texture);
 };
\ No newline at end of file
@@ -4,33 +4,38 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <filesystem>
+#include <cstdint>
 #include <SFML/Graphics.hpp>
-#include <nlohmann/json.hpp>
 
 class Level;
 class Entity;
-
-using json = nlohmann::json;
+class TileLayerMesh;
+struct LdtkLevelData;
+struct LdtkLevelInfo;
+struct AssetManifest;
 
 class LevelLoader {
 public:
     static bool loadLevel(const std::string& jsonFilePath, Level* level);
 
 private:
-    struct TileInfo {
-        int tileId;
-        int x, y;
-        bool flipped;
-        bool flipY;
-        bool rotated;
-    };
+    static bool isCookedFileCurrent(const std::filesystem::path& cookedPath, const std::filesystem::path& sourcePath);
+    static bool loadCookedLevel(const std::string& cookedPath, const std::filesystem::path& projectPath, Level* level);
+    static void loadParsedLevel(const LdtkLevelData& data, Level* level);
+    static int applyCollisionWords(Level* level, const std::uint64_t* words, int wordsPerRow, int rows);
+
+    static void prepareLevel(Level* level, int width, int height, int gridSize);
+    static void addFallbackLayers(Level* level, int width, int height, int gridSize);
+    static void finishLevel(Level* level);
+    static void enableWorldStreaming(Level* level, const std::filesystem::path& projectPath, const std::vector<LdtkLevelInfo>& levels, int homeIndex);
+    static void addTilesetToManifest(AssetManifest& manifest, const std::string& tilesetId, const std::string& relPath);
+    static void addTileMeshes(Level* level, const AssetManifest& manifest, std::vector<std::unique_ptr<TileLayerMesh>>& meshes, const std::vector<std::string>& tilesetIds);
 
-    static void loadCollisionsFromIntGrid(Level* level, const json& layerData, int gridSize);
-    static void loadTileLayer(Level* level, const json& layerData, const json& project, const std::string& basePath);
-    static void loadEntities(Level* level, const json& layerData);
-    static json findTileset(const json& project, int tilesetId);
-    static std::vector<TileInfo> decodeTiles(const json& layerData, int gridSize);
-    static json getCurrentLevel(const json& project);
-    static Entity* createEntityByType(const std::string& type, const json& entityData);
+    // "Torch"/"Light" entities become tile light sources instead of entities.
+    static bool addLevelLight(Level* level, const std::string& type, int x, int y, int width, int height);
+    // Coins and health go to the level's PickupField rather than becoming entities.
+    static bool addLevelPickup(Level* level, const std::string& type, int x, int y);
+    static Entity* createEntityByType(const std::string& type, int width, int height);
     static void createDefaultEntities(Level* level);
 };
\ No newline at end of file
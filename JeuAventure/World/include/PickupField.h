@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Player;
+class SpriteBatch;
+
+// Static collectibles (coins, health) stored as flat arrays instead of one
+// Entity each. Bobbing is one pass over the arrays per frame: every pickup
+// shares the bob speed, so sin(t + phase) expands to
+// sin(t) * cos(phase) + cos(t) * sin(phase) with the phase terms stored per
+// pickup. Pickups are bucketed by position in a grid rebuilt only when
+// pickups are added; the player's bounds and the view each visit only the
+// cells they overlap. Collected pickups are swap-removed from the arrays
+// once CompactThreshold of them have piled up.
+class PickupField {
+public:
+    static const int CellSize = 128;
+    static const std::size_t CompactThreshold = 32;
+
+private:
+    struct Kind {
+        std::string type;
+        const sf::Texture* texture;
+        sf::IntRect textureRect;
+        sf::Vector2f halfSize;
+        sf::Color color;
+        // Value of a pickup added without one (e.g. an enemy drop).
+        int defaultValue;
+    };
+
+    std::vector<Kind> m_kinds;
+
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_phaseSin;
+    std::vector<float> m_phaseCos;
+    std::vector<float> m_bobOffset;
+    std::vector<std::uint8_t> m_kind;
+    std::vector<std::uint8_t> m_collected;
+    std::vector<int> m_value;
+    std::size_t m_remaining;
+
+    // Cell i lists m_cellPickups[m_cellStart[i] .. m_cellStart[i + 1]).
+    sf::Vector2i m_gridOrigin;
+    int m_columns;
+    int m_rows;
+    std::vector<int> m_cellStart;
+    std::vector<int> m_cellPickups;
+    bool m_gridDirty;
+    sf::Vector2f m_maxHalfSize;
+
+    float m_time;
+    float m_bobHeight;
+    float m_bobSpeed;
+    float m_spinSpeed;
+
+    std::size_t m_lastTested;
+    std::size_t m_lastDrawn;
+
+    int findKind(const std::string& type);
+    void rebuildGrid();
+    sf::IntRect getCellRange(const sf::FloatRect& area) const;
+    void collect(int index, Player* player);
+    void compact();
+
+public:
+    PickupField();
+
+    void add(const std::string& type, int value, const sf::Vector2f& position);
+    void add(const std::string& type, const sf::Vector2f& position);
+    void clear();
+
+    void setBob(float height, float speed);
+
+    void update(float dt, Player* player);
+    void render(SpriteBatch& batch, const sf::FloatRect& viewArea);
+
+    std::size_t getCount() const;
+    std::size_t getRemainingCount() const;
+    std::size_t getLastTestedCount() const;
+    std::size_t getLastDrawnCount() const;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TileAnimation {
+    std::vector<int> frames;
+    float frameDuration;
+
+    TileAnimation() : frameDuration(0.1f) {}
+
+    int getFrame(float time) const;
+};
+
+// Animations of one tileset, keyed by the tile ID placed in the level.
+using TilesetAnimations = std::unordered_map<int, TileAnimation>;
+
+// Animated tile definitions and the clock they all run on. Tile meshes keep
+// pointers into the definitions, so entries are replaced but never removed.
+//
+// getStep() changes only on frames where some animation advances; meshes
+// compare it with the step they last applied to skip unchanged chunks.
+//
+// Definitions are added on the main thread (each level load rereads
+// tileAnimations.json) while the streaming worker may be building meshes
+// from them. addAnimation() takes the lock; the worker holds it for as long
+// as it reads the definitions.
+class TileAnimationSet {
+private:
+    static TileAnimationSet* s_instance;
+
+    std::unordered_map<std::string, TilesetAnimations> m_tilesets;
+    mutable std::mutex m_mutex;
+    float m_time;
+    unsigned int m_step;
+
+    TileAnimationSet();
+
+public:
+    TileAnimationSet(const TileAnimationSet&) = delete;
+    TileAnimationSet& operator=(const TileAnimationSet&) = delete;
+
+    static TileAnimationSet* getInstance();
+    static void cleanup();
+
+    // { "<tileset identifier>": [ { "tileId": 42, "frames": [42, 43, 44], "duration": 0.15 } ] }
+    bool loadFromFile(const std::string& filename);
+    bool addAnimation(const std::string& tilesetId, int tileId, const std::vector<int>& frames, float frameDuration);
+
+    const TilesetAnimations* find(const std::string& tilesetId) const;
+    std::unique_lock<std::mutex> lock() const;
+    std::size_t getAnimationCount() const;
+
+    void update(float dt);
+    float getTime() const;
+    unsigned int getStep() const;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+class Tilemap;
+class BoxCollider;
+
+// Static colliders for a Tilemap's collision layer. Solid tiles are merged
+// greedily into as few rectangles as possible, each registered with the
+// CollisionManager as one static BoxCollider. The map is cut into bands of
+// BandHeight rows that are merged independently, so a tile change only
+// re-merges its own band, on the next update().
+class TileColliderSet {
+public:
+    static const int BandHeight = 16;
+
+private:
+    struct Band {
+        std::vector<std::unique_ptr<BoxCollider>> colliders;
+        bool dirty = true;
+    };
+
+    Tilemap* m_tilemap;
+    std::vector<Band> m_bands;
+    std::size_t m_colliderCount;
+
+    void rebuildBand(int index);
+    void releaseBand(Band& band);
+
+public:
+    TileColliderSet();
+    ~TileColliderSet();
+
+    TileColliderSet(const TileColliderSet&) = delete;
+    TileColliderSet& operator=(const TileColliderSet&) = delete;
+
+    // Merges the whole map and follows its later collision changes.
+    void build(Tilemap* tilemap);
+    void clear();
+
+    void markRowsDirty(int firstRow, int lastRow);
+    void update();
+
+    std::size_t getColliderCount() const;
+
+    // Greedy merge of rows [firstRow, lastRow], in tiles: each rectangle is
+    // grown right along its run, then down while the rows below match.
+    static std::vector<sf::IntRect> mergeRows(const Tilemap& tilemap, int firstRow, int lastRow);
+};
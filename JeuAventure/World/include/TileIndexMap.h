@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdint>
+
+// Encoding of a tile layer as an index texture, one RGBA8 texel per cell,
+// and the fragment shader that draws the layer from it. R and G hold
+// tileId + 1 (little-endian, 0 = empty cell), B the LDtk flip bits. The
+// CPU functions below mirror the shader's arithmetic so the two can be
+// checked against each other; change them together.
+namespace TileIndexMap {
+
+    const std::uint8_t FlipX = 1;
+    const std::uint8_t FlipY = 2;
+
+    // 0xFFFF would wrap to the empty marker.
+    const int MaxTileId = 0xFFFE;
+
+    inline bool encode(int tileId, bool flipX, bool flipY, std::uint8_t* texel) {
+        if (tileId < 0 || tileId > MaxTileId) return false;
+
+        unsigned int stored = static_cast<unsigned int>(tileId) + 1;
+        texel[0] = static_cast<std::uint8_t>(stored & 0xFF);
+        texel[1] = static_cast<std::uint8_t>(stored >> 8);
+        texel[2] = static_cast<std::uint8_t>((flipX ? FlipX : 0) | (flipY ? FlipY : 0));
+        texel[3] = 255;
+        return true;
+    }
+
+    inline bool decode(const std::uint8_t* texel, int& tileId, bool& flipX, bool& flipY) {
+        int stored = texel[0] | (texel[1] << 8);
+        if (stored == 0) return false;
+
+        tileId = stored - 1;
+        flipX = (texel[2] & FlipX) != 0;
+        flipY = (texel[2] & FlipY) != 0;
+        return true;
+    }
+
+    // Tileset pixel sampled for a point `local` in [0, 1)^2 inside a cell,
+    // as the shader computes it. False for empty cells.
+    inline bool lookup(const std::uint8_t* texel, sf::Vector2f local, int tilesetColumns, int tilesetTileSize, sf::Vector2f& tilesetPixel) {
+        int tileId = 0;
+        bool flipX = false;
+        bool flipY = false;
+        if (!decode(texel, tileId, flipX, flipY)) return false;
+
+        if (flipX) local.x = 1.f - local.x;
+        if (flipY) local.y = 1.f - local.y;
+
+        sf::Vector2f origin(static_cast<float>(tileId % tilesetColumns), static_cast<float>(tileId / tilesetColumns));
+        tilesetPixel = (origin + local) * static_cast<float>(tilesetTileSize);
+        return true;
+    }
+
+    // Texture coordinates of the layer quad are in cells. Channels are
+    // rebuilt from the normalised texel with floor(x * 255 + 0.5), which is
+    // exact for 8-bit values. The sample is clamped half a texel inside the
+    // tile so neighbouring tiles never bleed in at the edges.
+    const char* const FragmentShader = R"(
+uniform sampler2D tileset;
+uniform sampler2D indexMap;
+uniform vec2 mapSize;
+uniform vec2 tilesetSize;
+uniform float tilesetTileSize;
+uniform float tilesetColumns;
+
+void main()
+{
+    vec2 cellCoord = gl_TexCoord[0].xy;
+    vec2 cell = floor(cellCoord);
+    vec4 texel = texture2D(indexMap, (cell + 0.5) / mapSize);
+
+    float stored = floor(texel.r * 255.0 + 0.5) + floor(texel.g * 255.0 + 0.5) * 256.0;
+    if (stored < 0.5)
+        discard;
+
+    float tileId = stored - 1.0;
+    float flags = floor(texel.b * 255.0 + 0.5);
+
+    vec2 local = cellCoord - cell;
+    if (mod(flags, 2.0) >= 1.0)
+        local.x = 1.0 - local.x;
+    if (flags >= 2.0)
+        local.y = 1.0 - local.y;
+
+    float halfTexel = 0.5 / tilesetTileSize;
+    local = clamp(local, halfTexel, 1.0 - halfTexel);
+
+    vec2 origin = vec2(mod(tileId, tilesetColumns), floor(tileId / tilesetColumns));
+    vec2 uv = (origin + local) * tilesetTileSize / tilesetSize;
+    gl_FragColor = texture2D(tileset, uv) * gl_Color;
+}
+)";
+}
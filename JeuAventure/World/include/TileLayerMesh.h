@@ -0,0 +1,146 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include "TileAnimationSet.h"
+
+struct LayerTile {
+    int tileId;
+    int x;
+    int y;
+    bool flipX;
+    bool flipY;
+};
+
+// One decorative tile layer (LDtk "Tiles" layer) as chunked static meshes
+// referencing the tileset texture. Memory scales with the tile count rather
+// than the level's pixel area.
+//
+// When shaders are available, grid-aligned tiles are instead uploaded as a
+// tile-index texture (see TileIndexMap.h) and the whole layer is drawn as one
+// quad. Tiles the index can't hold (stacked in a cell, off-grid) keep going
+// through the chunk meshes, drawn on top.
+//
+// Animated tiles always live in the chunk meshes. Each chunk lists its
+// animated quads and, when visible, rewrites only their texture coordinates
+// after a TileAnimationSet step.
+class TileLayerMesh {
+public:
+    static const int ChunkSize = 16;
+
+private:
+    struct AnimatedSlot {
+        std::uint32_t vertex;
+        const TileAnimation* animation;
+        // The ID placed in the level, and the frame the quad shows now.
+        int tileId;
+        int frame;
+        bool flipX;
+        bool flipY;
+    };
+
+    struct Chunk {
+        sf::FloatRect bounds;
+        std::vector<sf::Vertex> vertices;
+        sf::VertexBuffer buffer;
+        bool uploaded;
+        bool edited;
+
+        std::vector<AnimatedSlot> animatedSlots;
+        unsigned int animationStep;
+
+        Chunk() : buffer(sf::Quads, sf::VertexBuffer::Static), uploaded(false), edited(false), animationStep(~0u) {}
+    };
+
+    std::string m_name;
+    const sf::Texture* m_texture;
+    int m_tilesetTileSize;
+    int m_tilesetColumns;
+    int m_gridSize;
+    sf::Vector2f m_offset;
+    sf::Color m_color;
+
+    int m_chunksX;
+    int m_chunksY;
+    std::vector<Chunk> m_chunks;
+    bool m_useVertexBuffers;
+    std::size_t m_uploadCursor;
+
+    int m_widthInTiles;
+    int m_heightInTiles;
+    std::vector<std::uint8_t> m_indexPixels;
+    std::size_t m_indexedTileCount;
+    sf::Texture m_indexTexture;
+    bool m_useShader;
+
+    const TilesetAnimations* m_animations;
+    std::size_t m_animatedTileCount;
+
+    std::size_t m_tileCount;
+    std::size_t m_lastDrawCalls;
+
+    static bool s_shaderRenderingEnabled;
+
+    static sf::Shader* getIndexShader();
+
+    void appendTile(Chunk& chunk, const LayerTile& tile);
+    void updateAnimatedSlots(Chunk& chunk);
+    void appendIndexedTiles(std::size_t chunkIndex);
+    std::size_t removeChunkTiles(Chunk& chunk, int cellX, int cellY);
+    void reuploadChunk(Chunk& chunk);
+    void renderIndexed(sf::RenderTarget& target, const sf::FloatRect& viewRect);
+
+public:
+    TileLayerMesh(const std::string& name, const sf::Texture* texture, int tilesetTileSize, int tilesetColumns);
+
+    // Animations of this layer's tileset; must be set before buildVertices().
+    void setAnimations(const TilesetAnimations* animations);
+
+    void build(const std::vector<LayerTile>& tiles, int gridSize, int widthInTiles, int heightInTiles);
+
+    // build() split in two so the vertex data can be generated off the main
+    // thread: buildVertices() touches no OpenGL state, uploadChunks() must
+    // run on the render thread. Returns the number of chunks uploaded.
+    void buildVertices(const std::vector<LayerTile>& tiles, int gridSize, int widthInTiles, int heightInTiles);
+    std::size_t uploadChunks(std::size_t maxChunks);
+    bool isUploaded() const;
+
+    // Replaces whatever the layer draws in one cell (tileId < 0 clears it).
+    // Only the cell's chunk, or its index texel, is rewritten; the chunk is
+    // re-uploaded once when next drawn. The mesh must be fully uploaded.
+    bool setTile(int cellX, int cellY, int tileId, bool flipX = false, bool flipY = false);
+    // The topmost tile drawn in one cell, or -1. Animated tiles report the
+    // ID they were placed with, not their current frame.
+    int getTile(int cellX, int cellY) const;
+
+    // Tileset pixel coordinates of a tile's quad corners, clockwise from the
+    // top left. The index shader must sample the same texels.
+    void setTileTexCoords(sf::Vertex* quad, int tileId, bool flipX, bool flipY) const;
+
+    void render(sf::RenderTarget& target);
+
+    void setOffset(const sf::Vector2f& offset);
+    const sf::Vector2f& getOffset() const;
+    int getGridSize() const;
+    int getWidthInTiles() const;
+    int getHeightInTiles() const;
+
+    void setOpacity(float opacity);
+
+    void setTexture(const sf::Texture* texture);
+
+    const std::string& getName() const;
+    const sf::Texture* getTexture() const;
+    std::size_t getTileCount() const;
+    std::size_t getAnimatedTileCount() const;
+    std::size_t getChunkCount() const;
+    std::size_t getMemoryUsage() const;
+    std::size_t getLastDrawCallCount() const;
+    bool isShaderRendered() const;
+
+    // Takes effect for meshes uploaded afterwards.
+    static void setShaderRenderingEnabled(bool enabled);
+    static bool isShaderRenderingEnabled();
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+class Tilemap;
+
+// Light levels on the tile grid, spread by flood fill from point lights:
+// each step away from a light loses one level, and solid tiles are lit but
+// don't pass light on. Adding, moving or removing a light and editing tiles
+// only revisit the tiles whose level can change (light removal first clears
+// the area the old light reached, then refills it from its edges).
+//
+// The levels are drawn as a texture with one texel per tile, smoothed by
+// linear filtering and multiplied over the scene. Only the rectangle of
+// tiles changed since the last frame is uploaded.
+class TileLightMap {
+public:
+    static const int MaxLevel = 15;
+
+private:
+    struct Light {
+        sf::Vector2f position;
+        sf::Vector2i tile;
+        int level;
+        bool active;
+    };
+
+    // A tile whose level dropped; only tiles that passed light on can have
+    // lit their neighbours through it.
+    struct Removal {
+        int index;
+        int level;
+        bool emitted;
+    };
+
+    static const int NoTile = -1;
+
+    const Tilemap* m_tilemap;
+    int m_width;
+    int m_height;
+
+    std::vector<std::uint8_t> m_levels;
+    // Strongest light placed in each tile.
+    std::vector<std::uint8_t> m_sourceLevels;
+    std::vector<Light> m_lights;
+
+    std::vector<int> m_increaseQueue;
+    std::vector<Removal> m_decreaseQueue;
+
+    sf::Texture m_texture;
+    std::vector<std::uint8_t> m_pixels;
+    bool m_textureReady;
+    int m_dirtyMinX;
+    int m_dirtyMinY;
+    int m_dirtyMaxX;
+    int m_dirtyMaxY;
+
+    sf::Color m_ambientColor;
+    sf::Color m_lightColor;
+    bool m_enabled;
+
+    std::size_t m_updatedTiles;
+    std::size_t m_lastUpdatedTiles;
+    std::size_t m_lastUploadedTiles;
+
+    bool isOpaque(int index) const;
+    sf::Vector2i worldToTile(const sf::Vector2f& position) const;
+    void setLevel(int index, int level);
+    void markAllDirty();
+    void refreshSource(const sf::Vector2i& tile);
+    void addSource(const sf::Vector2i& tile, int level);
+    void removeSource(const sf::Vector2i& tile);
+    void propagate();
+    sf::Color levelColor(int level) const;
+    void uploadDirty();
+
+public:
+    TileLightMap();
+
+    // Sizes the grid to the tilemap and lights it from scratch.
+    void build(const Tilemap* tilemap);
+    void clear();
+
+    // Returns an id for moveLight()/removeLight().
+    int addLight(const sf::Vector2f& position, int level);
+    void moveLight(int id, const sf::Vector2f& position);
+    void setLightLevel(int id, int level);
+    void removeLight(int id);
+
+    // Cells whose collision changed, in tile coordinates.
+    void onTilesChanged(const sf::IntRect& cells);
+
+    int getLevel(int x, int y) const;
+
+    void setAmbientColor(const sf::Color& color);
+    void setLightColor(const sf::Color& color);
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void update();
+    void render(sf::RenderTarget& target);
+
+    std::size_t getLightCount() const;
+    std::size_t getLastUpdatedTileCount() const;
+    std::size_t getLastUploadedTileCount() const;
+};
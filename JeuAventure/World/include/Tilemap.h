@@ -1,41 +1,159 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <string>
 
-struct TileInfo {
-    int id;
-    bool collidable;
-    std::string type;
-    std::vector<std::string> properties;
-};
-
+// Tiles are grouped into ChunkSize x ChunkSize chunks. Each chunk keeps its
+// quads in a static vertex buffer that is only rebuilt when one of its tiles
+// changes, and render() only draws chunks that intersect the view.
+//
+// Tile data is stored separately, in StorageChunkSize x StorageChunkSize
+// blocks of packed ids and flags. Blocks that are entirely empty aren't
+// allocated, and the rare per-tile strings live in a side table, so air
+// costs nothing and a solid block costs 3 bytes per tile.
 class Tilemap {
+public:
+    static const int ChunkSize = 16;
+
+    // Called with the first and last row whose collision changed.
+    using CollisionListener = std::function<void(int firstRow, int lastRow)>;
+    static const int StorageChunkSize = 32;
+
+    // Tile ids are stored as uint16_t; this one marks an empty cell.
+    static constexpr std::uint16_t EmptyTileId = 0xFFFF;
+
+    enum TileFlags : std::uint8_t {
+        TileCollidable = 1 << 0
+    };
+
+    struct RaycastHit {
+        sf::Vector2i tile;
+        sf::Vector2f point;
+        // Face of the tile the ray entered through; (0, 0) if it started inside.
+        sf::Vector2i normal;
+        float distance;
+    };
+
+    static const int LineOfSightCacheBits = 8;
+    static const int LineOfSightCacheSize = 1 << LineOfSightCacheBits;
+
 private:
+    static const int StorageChunkArea = StorageChunkSize * StorageChunkSize;
+
+    struct TileStorageChunk {
+        std::array<std::uint16_t, StorageChunkArea> ids;
+        std::array<std::uint8_t, StorageChunkArea> flags;
+        // Cells that have an id or a flag; the chunk is freed at zero.
+        int usedCount;
+
+        TileStorageChunk()
+            : usedCount(0)
+        {
+            ids.fill(EmptyTileId);
+            flags.fill(0);
+        }
+    };
+
+    struct TileProperties {
+        std::string type;
+        std::vector<std::string> properties;
+    };
+
+    struct LineOfSightEntry {
+        std::uint64_t key;
+        unsigned int generation;
+        bool visible;
+    };
+
+    struct TileChunk {
+        std::vector<sf::Vertex> vertices;
+        sf::VertexBuffer buffer;
+        bool dirty;
+
+        std::vector<sf::Vertex> overlayVertices;
+        sf::VertexBuffer overlayBuffer;
+        bool overlayDirty;
+
+        TileChunk()
+            : buffer(sf::Quads, sf::VertexBuffer::Static),
+            dirty(true),
+            overlayBuffer(sf::Quads, sf::VertexBuffer::Static),
+            overlayDirty(true)
+        {
+        }
+    };
+
     int m_width;
     int m_height;
     int m_tileWidth;
     int m_tileHeight;
 
-    std::vector<std::vector<TileInfo>> m_tiles;
+    std::vector<std::unique_ptr<TileStorageChunk>> m_storage;
+    int m_storageChunksX;
+    int m_storageChunksY;
+    std::unordered_map<std::uint64_t, TileProperties> m_tileProperties;
 
     sf::Texture* m_tilesetTexture;
 
     int m_tilesetColumns;
     int m_tilesetRows;
 
-    sf::VertexArray m_vertices;
-
-    std::vector<sf::FloatRect> m_collisionBoxes;
-
-    sf::FloatRect m_lastViewRect;
-    std::vector<sf::Vector2i> m_visibleTiles;
-
-    void rebuildVertexArray();
-
-    void updateVisibleTiles(const sf::FloatRect& viewRect);
+    std::vector<TileChunk> m_chunks;
+    int m_chunksX;
+    int m_chunksY;
+    bool m_useVertexBuffers;
+
+    // One bit per tile, row-major, each row padded to whole words. Area
+    // queries test 64 tiles per word; the per-tile boxes are only built when
+    // someone asks for them.
+    std::vector<std::uint64_t> m_collisionBits;
+    int m_collisionWordsPerRow;
+    mutable std::vector<sf::FloatRect> m_collisionBoxes;
+    mutable bool m_collisionBoxesDirty;
+    CollisionListener m_collisionListener;
+
+    // Line-of-sight results between tile pairs, direct-mapped. An entry is
+    // only valid for the generation it was stored in; the generation moves
+    // on every frame and whenever a collision bit changes.
+    mutable std::array<LineOfSightEntry, LineOfSightCacheSize> m_lineOfSightCache;
+    unsigned int m_lineOfSightGeneration;
+    mutable std::size_t m_lineOfSightQueries;
+    mutable std::size_t m_lineOfSightCacheHits;
+    std::size_t m_lastLineOfSightQueries;
+    std::size_t m_lastLineOfSightCacheHits;
+
+    bool m_showCollisionOverlay;
+    std::size_t m_lastDrawCalls;
+    std::size_t m_lastVisibleChunks;
+
+    bool inBounds(int x, int y) const;
+    static std::uint64_t propertyKey(int x, int y);
+    const TileStorageChunk* findStorage(int x, int y, int& cell) const;
+    TileStorageChunk* findOrCreateStorage(int x, int y, int& cell);
+    void releaseStorageIfUnused(int x, int y);
+    void resizeStorage(int width, int height);
+    void setCollisionBit(int x, int y, bool collidable);
+    void rebuildCollisionBits();
+    bool getTileRange(const sf::FloatRect& area, int& firstX, int& firstY, int& lastX, int& lastY) const;
+    template <typename Visitor>
+    bool forEachCollidableTile(const sf::FloatRect& area, Visitor visitor) const;
+    template <typename Visitor>
+    bool traverseRay(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance, Visitor visitor) const;
+    bool isCollisionBitSet(int x, int y) const;
+
+    void resetChunks();
+    void markAllChunksDirty();
+    void markChunkDirty(int x, int y, bool overlay);
+    void rebuildChunk(TileChunk& chunk, int chunkX, int chunkY);
+    void rebuildChunkOverlay(TileChunk& chunk, int chunkX, int chunkY);
+    void drawChunk(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices,
+        const sf::VertexBuffer& buffer, const sf::RenderStates& states);
 
     sf::Vector2i getTilesetCoords(int id) const;
 
@@ -53,6 +171,8 @@ public:
 
     void setTileType(int x, int y, const std::string& type);
     std::string getTileType(int x, int y) const;
+    void addTileProperty(int x, int y, const std::string& property);
+    std::vector<std::string> getTileProperties(int x, int y) const;
 
     void resize(int width, int height);
     int getWidth() const;
@@ -67,9 +187,37 @@ public:
 
     bool checkCollision(const sf::FloatRect& rect) const;
     std::vector<sf::FloatRect> getCollisionsInArea(const sf::FloatRect& area) const;
+    int countCollisionsInArea(const sf::FloatRect& area) const;
+    // One box per collidable tile, rebuilt on demand after tiles change.
+    const std::vector<sf::FloatRect>& getCollisionBoxes() const;
+
+    // Raw bitset access: bit x of row y, rows padded to whole words.
+    int getCollisionWordsPerRow() const;
+    const std::uint64_t* getCollisionRow(int y) const;
+    void setCollisionListener(const CollisionListener& listener);
+
+    // Grid raycast over the collision bitset (Amanatides & Woo). Returns
+    // true and fills `hit` if a collidable tile lies within maxDistance.
+    bool raycast(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance, RaycastHit* hit = nullptr) const;
+    // Tile-resolution visibility: the ray between the centres of the tiles
+    // holding `from` and `to`, ignoring those two tiles. Results are cached
+    // for the current frame.
+    bool hasLineOfSight(const sf::Vector2f& from, const sf::Vector2f& to) const;
+    std::size_t getLastLineOfSightQueryCount() const;
+    std::size_t getLastLineOfSightCacheHits() const;
 
     void update(float dt);
     void render(sf::RenderWindow& window);
 
+    void setShowCollisionOverlay(bool show);
+    bool isShowingCollisionOverlay() const;
+
+    std::size_t getLastDrawCallCount() const;
+    std::size_t getLastVisibleChunkCount() const;
+    std::size_t getChunkCount() const;
+    std::size_t getStorageChunkCount() const;
+    std::size_t getAllocatedStorageChunkCount() const;
+    std::size_t getStorageBytes() const;
+
     void clear();
 };
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class Entity;
+
+// Trigger areas (checkpoints, finish zones, hazards) kept out of the physics
+// and collision pipelines. Volumes are bucketed in a uniform grid rebuilt
+// only when volumes are added, removed or moved into other cells; their
+// owners call moveVolume() when they move. Each update() tests just
+// the registered activators (usually the player) against the cells they
+// overlap and calls Entity::onTriggerEnter/onTriggerExit on the owners.
+// An activator that goes inactive or is removed leaves every volume it was
+// inside, so the owners always see a matching exit.
+class TriggerVolumeSystem {
+public:
+    static const int CellSize = 128;
+
+private:
+    struct Volume {
+        sf::FloatRect bounds;
+        Entity* owner;
+    };
+
+    struct Activator {
+        Entity* entity;
+        // Volumes the activator overlapped last update, sorted.
+        std::vector<int> inside;
+    };
+
+    // Owner captured when the overlap changed, so a callback that removes
+    // the volume and lets another owner reuse its id cannot redirect the event.
+    struct TriggerEvent {
+        int volume;
+        Entity* owner;
+        Entity* activator;
+    };
+
+    std::vector<Volume> m_volumes;
+    std::vector<int> m_freeVolumes;
+    std::vector<Activator> m_activators;
+
+    // Cell contents stored back to back: cell i lists
+    // m_cellVolumes[m_cellStart[i] .. m_cellStart[i + 1]).
+    sf::Vector2i m_gridOrigin;
+    int m_columns;
+    int m_rows;
+    std::vector<int> m_cellStart;
+    std::vector<int> m_cellVolumes;
+    bool m_gridDirty;
+
+    // Per-volume stamp so a volume spanning several cells is tested once.
+    std::vector<unsigned int> m_visitStamps;
+    unsigned int m_visitStamp;
+
+    std::vector<int> m_overlaps;
+    std::vector<TriggerEvent> m_entered;
+    std::vector<TriggerEvent> m_exited;
+
+    std::size_t m_lastTestedCount;
+
+    void rebuildGrid();
+    sf::IntRect getCellRange(const sf::FloatRect& bounds) const;
+    void queryOverlaps(const sf::FloatRect& bounds);
+    bool isLive(const TriggerEvent& event) const;
+
+public:
+    TriggerVolumeSystem();
+
+    TriggerVolumeSystem(const TriggerVolumeSystem&) = delete;
+    TriggerVolumeSystem& operator=(const TriggerVolumeSystem&) = delete;
+
+    int addVolume(Entity* owner, const sf::FloatRect& bounds);
+    void removeVolume(int id);
+    void moveVolume(int id, const sf::FloatRect& bounds);
+    void removeVolumesOf(Entity* owner);
+
+    void addActivator(Entity* entity);
+    void removeActivator(Entity* entity);
+
+    // Builds the grid now instead of on the next update().
+    void build();
+    void clear();
+    void update();
+
+    std::size_t getVolumeCount() const;
+    std::size_t getCellCount() const;
+    std::size_t getLastTestedCount() const;
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <cstdint>
+#include <future>
+#include "LdtkStreamParser.h"
+#include "AssetHandle.h"
+
+class TileLayerMesh;
+
+// Keeps the LDtk levels around the home level resident as the player walks
+// towards them. A worker thread parses the project, decodes tiles and builds
+// the meshes' vertex data. Once a level comes within the prefetch distance
+// its asset manifest is handed to RessourceManager, whose loader threads
+// decode the tilesets into the cache; when it comes within the load
+// distance the section acquires the assets and the main thread uploads the
+// vertex buffers within a per-frame time budget.
+// Coordinates are relative to the home level, which the Level owns itself.
+class WorldStreamer {
+public:
+    enum class SectionState {
+        Loading,
+        Prefetched,
+        Uploading,
+        Ready,
+        // Decoding failed; skipped until evicted, then requested again.
+        Failed
+    };
+
+private:
+    struct StreamedLevel {
+        std::string identifier;
+        bool success;
+        int gridSize;
+        int cellsX;
+        int cellsY;
+        int wordsPerRow;
+        std::vector<std::uint64_t> collision;
+        std::vector<std::unique_ptr<TileLayerMesh>> meshes;
+        std::vector<ResourceId> meshTilesets;
+        AssetManifest manifest;
+        sf::Time loadTime;
+
+        StreamedLevel();
+        ~StreamedLevel();
+    };
+
+    struct Section {
+        LdtkLevelInfo info;
+        sf::Vector2f offset;
+        SectionState state;
+        std::unique_ptr<StreamedLevel> data;
+        std::vector<std::shared_future<bool>> pendingAssets;
+        AssetGroup assets;
+        bool assetsAcquired;
+        std::size_t nextMesh;
+        sf::Time uploadTime;
+
+        sf::FloatRect getBounds() const;
+    };
+
+    struct Job {
+        std::string identifier;
+        sf::Vector2f offset;
+    };
+
+    std::filesystem::path m_projectPath;
+    std::vector<LdtkLevelInfo> m_levels;
+    int m_homeIndex;
+
+    std::vector<Section> m_sections;
+
+    float m_prefetchDistance;
+    float m_loadDistance;
+    float m_evictDistance;
+    sf::Time m_uploadBudget;
+    sf::Time m_lastUploadTime;
+    std::size_t m_evictedCount;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    std::vector<std::unique_ptr<StreamedLevel>> m_completed;
+    bool m_stopping;
+
+    void workerLoop();
+    std::unique_ptr<StreamedLevel> loadLevel(const Job& job) const;
+    std::string resolveTilesetPath(const std::string& relPath) const;
+
+    void requestSection(const LdtkLevelInfo& info, const sf::Vector2f& offset);
+    void evictSection(std::size_t index);
+    void receiveCompleted();
+    void uploadPending();
+    bool acquireAssets(Section& section);
+    bool uploadStep(Section& section);
+
+    Section* findSection(const std::string& identifier);
+
+public:
+    WorldStreamer(const std::filesystem::path& projectPath, const std::vector<LdtkLevelInfo>& levels, int homeIndex);
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    void update(const sf::Vector2f& focus);
+    void render(sf::RenderTarget& target);
+
+    bool checkCollision(const sf::FloatRect& rect) const;
+    sf::FloatRect extendBounds(const sf::FloatRect& bounds) const;
+
+    void setPrefetchDistance(float distance);
+    void setLoadDistance(float distance);
+    void setEvictDistance(float distance);
+    void setUploadBudget(sf::Time budget);
+
+    std::size_t getSectionCount(SectionState state) const;
+    std::size_t getEvictedCount() const;
+    sf::Time getLastUploadTime() const;
+};
@@ -35,7 +35,7 @@ void Background::addLayer(const sf::Texture& texture, float scrollSpeed, bool re
 
 void Background::addLayer(const std::string& texturePath, float scrollSpeed, bool repeat) {
     sf::Texture* texture = nullptr;
-    texture = RessourceManager::getInstance()->getTexture(texturePath);
+    texture = RessourceManager::getInstance()->getTexture(ResourceId(texturePath));
 
     if (!texture) {
         if (RessourceManager::getInstance()->loadTexture(texturePath, texturePath)) {
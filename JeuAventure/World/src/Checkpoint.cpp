@@ -1,5 +1,7 @@
 #include "Checkpoint.h"
+#include "SpriteBatch.h"
 #include "Level.h"
+#include "TriggerVolumeSystem.h"
 #include "RessourceManager.h"
 #include "EventSystem.h"
 #include "Player.h"
@@ -13,9 +15,11 @@ Checkpoint::Checkpoint()
     m_animationTimer(0.0f),
     m_pulseFrequency(2.0f),
     m_pulseAmplitude(0.2f),
-    m_showRadius(false) {
+    m_showRadius(false),
+    m_triggerVolume(-1) {
     m_name = "Checkpoint";
     m_size = sf::Vector2f(2.0f, 2.0f);
+    m_usesPhysics = false;
     m_radiusVisual.setRadius(m_activationRadius);
     m_radiusVisual.setFillColor(sf::Color(0, 200, 255, 40));
     m_radiusVisual.setOutlineColor(sf::Color(0, 150, 255));
@@ -31,9 +35,11 @@ Checkpoint::Checkpoint(const sf::Vector2f& position, float radius)
     m_animationTimer(0.0f),
     m_pulseFrequency(2.0f),
     m_pulseAmplitude(0.2f),
-    m_showRadius(false) {
+    m_showRadius(false),
+    m_triggerVolume(-1) {
     m_name = "Checkpoint";
     m_size = sf::Vector2f(2.0f, 2.0f);
+    m_usesPhysics = false;
     setPosition(position);
     m_radiusVisual.setRadius(m_activationRadius);
     m_radiusVisual.setFillColor(sf::Color(0, 200, 255, 40));
@@ -44,22 +50,36 @@ Checkpoint::Checkpoint(const sf::Vector2f& position, float radius)
 
 void Checkpoint::initialize() {
     Entity::initialize();
-    RessourceManager* resourceManager = RessourceManager::getInstance();
-    if (resourceManager->loadTexture("checkpoint", "checkpoint.png")) {
-        m_texture = std::make_unique<sf::Texture>(*resourceManager->getTexture("checkpoint"));
-        m_sprite.setTexture(*m_texture);
-        sf::Vector2u textureSize = m_texture->getSize();
-        m_sprite.setOrigin(textureSize.x / 2.0f, textureSize.y / 2.0f);
+    if (loadSpriteTexture("checkpoint", "checkpoint.png")) {
         m_sprite.setScale(0.05f, 0.05f);
     }
-    if (m_collider) {
-        m_collider->setIsTrigger(true);
-        m_collider->setCollisionLayer(static_cast<int>(CollisionLayer::Trigger));
-        float diameter = m_activationRadius * 2;
-        static_cast<BoxCollider*>(m_collider.get())->setSize(sf::Vector2f(diameter, diameter));
+    registerTriggerVolume();
+}
+
+void Checkpoint::registerTriggerVolume() {
+    if (!m_level) return;
+
+    TriggerVolumeSystem* volumes = m_level->getTriggerVolumes();
+    volumes->removeVolume(m_triggerVolume);
+    m_triggerBounds = getTriggerBounds();
+    m_triggerVolume = volumes->addVolume(this, m_triggerBounds);
+}
+
+void Checkpoint::syncTriggerVolume() {
+    if (m_triggerVolume < 0 || !m_level) return;
+
+    sf::FloatRect bounds = getTriggerBounds();
+    if (bounds != m_triggerBounds) {
+        m_triggerBounds = bounds;
+        m_level->getTriggerVolumes()->moveVolume(m_triggerVolume, bounds);
     }
 }
 
+sf::FloatRect Checkpoint::getTriggerBounds() const {
+    return sf::FloatRect(m_position.x - m_activationRadius, m_position.y - m_activationRadius,
+        m_activationRadius * 2, m_activationRadius * 2);
+}
+
 void Checkpoint::update(float dt) {
     m_animationTimer += dt;
     if (m_isActive) {
@@ -78,16 +98,8 @@ void Checkpoint::update(float dt) {
         m_radiusVisual.setOrigin(m_activationRadius * radiusScale, m_activationRadius * radiusScale);
         m_radiusVisual.setPosition(m_position);
     }
-    if (m_level && !m_isActive) {
-        Player* player = m_level->getPlayer();
-        if (player) {
-            float distance = distanceTo(*player);
-            if (distance <= m_activationRadius) {
-                activate();
-            }
-        }
-    }
     Entity::update(dt);
+    syncTriggerVolume();
 }
 
 void Checkpoint::render(sf::RenderWindow& window) {
@@ -97,9 +109,15 @@ void Checkpoint::render(sf::RenderWindow& window) {
     Entity::render(window);
 }
 
-void Checkpoint::onCollisionEnter(Collider* other) {
-    if (!other || !other->getOwner()) return;
-    if (other->getOwner()->getType() == EntityType::Player) {
+void Checkpoint::render(SpriteBatch& batch) {
+    if (m_showRadius) {
+        batch.drawShape(m_radiusVisual);
+    }
+    Entity::render(batch);
+}
+
+void Checkpoint::onTriggerEnter(Entity* activator) {
+    if (activator && activator->getType() == EntityType::Player) {
         activate();
     }
 }
@@ -138,10 +156,7 @@ void Checkpoint::setActivationRadius(float radius) {
     m_activationRadius = radius;
     m_radiusVisual.setRadius(m_activationRadius);
     m_radiusVisual.setOrigin(m_activationRadius, m_activationRadius);
-    if (m_collider) {
-        float diameter = m_activationRadius * 2;
-        static_cast<BoxCollider*>(m_collider.get())->setSize(sf::Vector2f(diameter, diameter));
-    }
+    syncTriggerVolume();
 }
 
 float Checkpoint::getActivationRadius() const {
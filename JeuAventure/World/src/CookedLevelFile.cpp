@@ -0,0 +1,168 @@
+#include "CookedLevelFile.h"
+#include <cstring>
+#include <iostream>
+
+CookedLevelFile::CookedLevelFile()
+    : m_header(nullptr)
+{
+}
+
+bool CookedLevelFile::open(const std::string& path) {
+    close();
+
+    if (!m_file.open(path)) {
+        return false;
+    }
+
+    if (m_file.getSize() < sizeof(CookedLevelFormat::Header)) {
+        std::cerr << "Cooked level file too small: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    m_header = at<CookedLevelFormat::Header>(0);
+
+    if (std::memcmp(m_header->magic, CookedLevelFormat::Magic, sizeof(CookedLevelFormat::Magic)) != 0) {
+        std::cerr << "Not a cooked level file: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if (m_header->version != CookedLevelFormat::Version) {
+        std::cerr << "Cooked level version " << m_header->version << " does not match "
+            << CookedLevelFormat::Version << ", re-run level_cooker: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if (m_header->fileSize != m_file.getSize() || !validate()) {
+        std::cerr << "Corrupt cooked level file: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void CookedLevelFile::close() {
+    m_file.close();
+    m_header = nullptr;
+}
+
+bool CookedLevelFile::isOpen() const {
+    return m_header != nullptr;
+}
+
+bool CookedLevelFile::rangeValid(std::uint32_t offset, std::uint64_t count, std::size_t elementSize) const {
+    std::size_t alignment = elementSize < 8 ? elementSize : 8;
+    if (offset % alignment != 0) return false;
+    std::uint64_t end = static_cast<std::uint64_t>(offset) + count * elementSize;
+    return end <= m_file.getSize();
+}
+
+bool CookedLevelFile::validate() const {
+    const auto& header = *m_header;
+
+    if (!rangeValid(header.stringTableOffset, header.stringTableSize, 1) ||
+        !rangeValid(header.levelTableOffset, header.levelCount, sizeof(CookedLevelFormat::Level)) ||
+        !rangeValid(header.tilesetTableOffset, header.tilesetCount, sizeof(CookedLevelFormat::Tileset))) {
+        return false;
+    }
+
+    if (header.stringTableSize == 0 || m_file.getData()[header.stringTableOffset + header.stringTableSize - 1] != '\0') {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < header.levelCount; ++i) {
+        const auto& level = *getLevel(i);
+
+        if (level.identifier >= header.stringTableSize ||
+            !rangeValid(level.collisionOffset, static_cast<std::uint64_t>(level.collisionWordsPerRow) * level.cellsY, sizeof(std::uint64_t)) ||
+            !rangeValid(level.layerOffset, level.layerCount, sizeof(CookedLevelFormat::Layer)) ||
+            !rangeValid(level.entityOffset, level.entityCount, sizeof(CookedLevelFormat::Entity))) {
+            return false;
+        }
+
+        if (level.collisionWordsPerRow * 64 < level.cellsX) {
+            return false;
+        }
+
+        const CookedLevelFormat::Layer* layers = getLayers(level);
+        for (std::uint32_t l = 0; l < level.layerCount; ++l) {
+            if (layers[l].tilesetIndex >= header.tilesetCount ||
+                layers[l].identifier >= header.stringTableSize ||
+                !rangeValid(layers[l].tileOffset, layers[l].tileCount, sizeof(CookedLevelFormat::Tile))) {
+                return false;
+            }
+        }
+
+        const CookedLevelFormat::Entity* entities = getEntities(level);
+        for (std::uint32_t e = 0; e < level.entityCount; ++e) {
+            if (entities[e].identifier >= header.stringTableSize) {
+                return false;
+            }
+        }
+    }
+
+    for (std::uint32_t i = 0; i < header.tilesetCount; ++i) {
+        const auto& tileset = *getTileset(i);
+        if (tileset.identifier >= header.stringTableSize || tileset.relPath >= header.stringTableSize) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const CookedLevelFormat::Header& CookedLevelFile::getHeader() const {
+    return *m_header;
+}
+
+std::uint32_t CookedLevelFile::getLevelCount() const {
+    return m_header ? m_header->levelCount : 0;
+}
+
+const CookedLevelFormat::Level* CookedLevelFile::getLevel(std::uint32_t index) const {
+    if (!m_header || index >= m_header->levelCount) return nullptr;
+    return at<CookedLevelFormat::Level>(m_header->levelTableOffset) + index;
+}
+
+const CookedLevelFormat::Level* CookedLevelFile::findLevel(const std::string& identifier) const {
+    for (std::uint32_t i = 0; i < getLevelCount(); ++i) {
+        const CookedLevelFormat::Level* level = getLevel(i);
+        if (identifier == getString(level->identifier)) {
+            return level;
+        }
+    }
+    return nullptr;
+}
+
+std::uint32_t CookedLevelFile::getTilesetCount() const {
+    return m_header ? m_header->tilesetCount : 0;
+}
+
+const CookedLevelFormat::Tileset* CookedLevelFile::getTileset(std::uint32_t index) const {
+    if (!m_header || index >= m_header->tilesetCount) return nullptr;
+    return at<CookedLevelFormat::Tileset>(m_header->tilesetTableOffset) + index;
+}
+
+const CookedLevelFormat::Layer* CookedLevelFile::getLayers(const CookedLevelFormat::Level& level) const {
+    return at<CookedLevelFormat::Layer>(level.layerOffset);
+}
+
+const CookedLevelFormat::Tile* CookedLevelFile::getTiles(const CookedLevelFormat::Layer& layer) const {
+    return at<CookedLevelFormat::Tile>(layer.tileOffset);
+}
+
+const CookedLevelFormat::Entity* CookedLevelFile::getEntities(const CookedLevelFormat::Level& level) const {
+    return at<CookedLevelFormat::Entity>(level.entityOffset);
+}
+
+const std::uint64_t* CookedLevelFile::getCollisionWords(const CookedLevelFormat::Level& level) const {
+    return at<std::uint64_t>(level.collisionOffset);
+}
+
+const char* CookedLevelFile::getString(std::uint32_t offset) const {
+    if (!m_header || offset >= m_header->stringTableSize) return "";
+    return reinterpret_cast<const char*>(m_file.getData() + m_header->stringTableOffset + offset);
+}
@@ -0,0 +1,245 @@
+#include "DestructibleTerrain.h"
+#include "Tilemap.h"
+#include "TileLayerMesh.h"
+#include "EventSystem.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+DestructibleTerrain::DestructibleTerrain()
+    : m_tilemap(nullptr),
+    m_lastEditCells(0)
+{
+}
+
+bool DestructibleTerrain::loadRules(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Could not open terrain rules: " << filename << std::endl;
+        return false;
+    }
+
+    try {
+        nlohmann::json root = nlohmann::json::parse(file);
+
+        for (auto layer = root.begin(); layer != root.end(); ++layer) {
+            std::vector<int> tiles = layer.value().get<std::vector<int>>();
+            if (tiles.size() != 16) {
+                std::cerr << "Terrain rules for " << layer.key() << " need 16 tiles, got " << tiles.size() << std::endl;
+                continue;
+            }
+
+            AutoTileRules rules;
+            std::copy(tiles.begin(), tiles.end(), rules.begin());
+            setRules(layer.key(), rules);
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error loading terrain rules " << filename << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void DestructibleTerrain::setRules(const std::string& layerName, const AutoTileRules& rules) {
+    m_rules[layerName] = rules;
+}
+
+void DestructibleTerrain::setTilemap(Tilemap* tilemap) {
+    m_tilemap = tilemap;
+}
+
+bool DestructibleTerrain::addLayer(TileLayerMesh* mesh) {
+    if (!mesh) return false;
+
+    auto rules = m_rules.find(mesh->getName());
+    if (rules == m_rules.end()) return false;
+
+    m_layers.push_back({ mesh, &rules->second });
+    return true;
+}
+
+void DestructibleTerrain::clear() {
+    m_layers.clear();
+    m_tilemap = nullptr;
+}
+
+void DestructibleTerrain::collectCells(const sf::FloatRect& area, bool collidable) {
+    float tileWidth = static_cast<float>(m_tilemap->getTileWidth());
+    float tileHeight = static_cast<float>(m_tilemap->getTileHeight());
+    int firstX = std::max(0, static_cast<int>(std::floor(area.left / tileWidth)));
+    int firstY = std::max(0, static_cast<int>(std::floor(area.top / tileHeight)));
+    int lastX = std::min(m_tilemap->getWidth() - 1, static_cast<int>(std::ceil((area.left + area.width) / tileWidth)) - 1);
+    int lastY = std::min(m_tilemap->getHeight() - 1, static_cast<int>(std::ceil((area.top + area.height) / tileHeight)) - 1);
+
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            if (m_tilemap->isTileCollidable(x, y) == collidable) {
+                m_editCells.emplace_back(x, y);
+            }
+        }
+    }
+}
+
+int DestructibleTerrain::destroyArea(const sf::FloatRect& area) {
+    if (!m_tilemap) return 0;
+
+    collectCells(area, true);
+    return applyEdit(false);
+}
+
+int DestructibleTerrain::destroyCircle(const sf::Vector2f& center, float radius) {
+    if (!m_tilemap || radius <= 0.0f) return 0;
+
+    float tileWidth = static_cast<float>(m_tilemap->getTileWidth());
+    float tileHeight = static_cast<float>(m_tilemap->getTileHeight());
+    int firstX = std::max(0, static_cast<int>(std::floor((center.x - radius) / tileWidth)));
+    int firstY = std::max(0, static_cast<int>(std::floor((center.y - radius) / tileHeight)));
+    int lastX = std::min(m_tilemap->getWidth() - 1, static_cast<int>(std::floor((center.x + radius) / tileWidth)));
+    int lastY = std::min(m_tilemap->getHeight() - 1, static_cast<int>(std::floor((center.y + radius) / tileHeight)));
+
+    float radiusSquared = radius * radius;
+    for (int y = firstY; y <= lastY; ++y) {
+        float dy = (y + 0.5f) * tileHeight - center.y;
+        for (int x = firstX; x <= lastX; ++x) {
+            float dx = (x + 0.5f) * tileWidth - center.x;
+            if (dx * dx + dy * dy <= radiusSquared && m_tilemap->isTileCollidable(x, y)) {
+                m_editCells.emplace_back(x, y);
+            }
+        }
+    }
+    return applyEdit(false);
+}
+
+int DestructibleTerrain::fillArea(const sf::FloatRect& area) {
+    if (!m_tilemap) return 0;
+
+    collectCells(area, false);
+    return applyEdit(true);
+}
+
+int DestructibleTerrain::applyEdit(bool solid) {
+    sf::Clock clock;
+    int count = static_cast<int>(m_editCells.size());
+    m_lastEditCells = m_editCells.size();
+    if (count == 0) {
+        m_lastEditTime = sf::Time::Zero;
+        return 0;
+    }
+
+    int minX = m_editCells[0].x, maxX = minX;
+    int minY = m_editCells[0].y, maxY = minY;
+    for (const auto& cell : m_editCells) {
+        minX = std::min(minX, cell.x);
+        maxX = std::max(maxX, cell.x);
+        minY = std::min(minY, cell.y);
+        maxY = std::max(maxY, cell.y);
+    }
+
+    m_editBounds = sf::IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+    m_editMask.assign(static_cast<std::size_t>(m_editBounds.width) * m_editBounds.height, false);
+
+    for (const auto& cell : m_editCells) {
+        m_editMask[static_cast<std::size_t>(cell.y - minY) * m_editBounds.width + (cell.x - minX)] = true;
+        m_tilemap->setTileCollision(cell.x, cell.y, solid);
+        if (!solid) {
+            m_tilemap->setTile(cell.x, cell.y, -1);
+        }
+    }
+
+    float tileWidth = static_cast<float>(m_tilemap->getTileWidth());
+    float tileHeight = static_cast<float>(m_tilemap->getTileHeight());
+    sf::FloatRect area(minX * tileWidth, minY * tileHeight,
+        m_editBounds.width * tileWidth, m_editBounds.height * tileHeight);
+
+    for (const auto& layer : m_layers) {
+        retileLayer(layer, area);
+    }
+
+    m_editCells.clear();
+
+    EventSystem::getInstance()->triggerEvent("TerrainChanged", {
+        {"cells", m_editBounds},
+        {"area", area}
+        });
+
+    m_lastEditTime = clock.getElapsedTime();
+    return count;
+}
+
+void DestructibleTerrain::retileLayer(const Layer& layer, const sf::FloatRect& area) {
+    TileLayerMesh* mesh = layer.mesh;
+    float grid = static_cast<float>(mesh->getGridSize());
+    const sf::Vector2f& offset = mesh->getOffset();
+
+    // One mesh cell of margin: the neighbours of an edited cell change mask.
+    int firstX = std::max(0, static_cast<int>(std::floor((area.left - offset.x) / grid)) - 1);
+    int firstY = std::max(0, static_cast<int>(std::floor((area.top - offset.y) / grid)) - 1);
+    int lastX = std::min(mesh->getWidthInTiles() - 1, static_cast<int>(std::ceil((area.left + area.width - offset.x) / grid)));
+    int lastY = std::min(mesh->getHeightInTiles() - 1, static_cast<int>(std::ceil((area.top + area.height - offset.y) / grid)));
+
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            float centerX = offset.x + (x + 0.5f) * grid;
+            float centerY = offset.y + (y + 0.5f) * grid;
+            bool edited = wasEdited(centerX, centerY);
+
+            if (!isSolidAt(centerX, centerY)) {
+                if (edited) {
+                    mesh->setTile(x, y, -1);
+                }
+                continue;
+            }
+
+            bool neighbourEdited = wasEdited(centerX, centerY - grid) || wasEdited(centerX + grid, centerY) ||
+                wasEdited(centerX, centerY + grid) || wasEdited(centerX - grid, centerY);
+            if (!edited && !neighbourEdited) continue;
+
+            int mask = 0;
+            if (isSolidAt(centerX, centerY - grid)) mask |= North;
+            if (isSolidAt(centerX + grid, centerY)) mask |= East;
+            if (isSolidAt(centerX, centerY + grid)) mask |= South;
+            if (isSolidAt(centerX - grid, centerY)) mask |= West;
+
+            int tileId = (*layer.rules)[mask];
+            if (tileId >= 0) {
+                mesh->setTile(x, y, tileId);
+            }
+        }
+    }
+}
+
+bool DestructibleTerrain::isSolidAt(float x, float y) const {
+    int tileX = static_cast<int>(std::floor(x / m_tilemap->getTileWidth()));
+    int tileY = static_cast<int>(std::floor(y / m_tilemap->getTileHeight()));
+
+    // Outside the map counts as solid so the borders keep their edges.
+    if (tileX < 0 || tileY < 0 || tileX >= m_tilemap->getWidth() || tileY >= m_tilemap->getHeight()) {
+        return true;
+    }
+    return m_tilemap->isTileCollidable(tileX, tileY);
+}
+
+bool DestructibleTerrain::wasEdited(float x, float y) const {
+    int tileX = static_cast<int>(std::floor(x / m_tilemap->getTileWidth())) - m_editBounds.left;
+    int tileY = static_cast<int>(std::floor(y / m_tilemap->getTileHeight())) - m_editBounds.top;
+
+    if (tileX < 0 || tileY < 0 || tileX >= m_editBounds.width || tileY >= m_editBounds.height) {
+        return false;
+    }
+    return m_editMask[static_cast<std::size_t>(tileY) * m_editBounds.width + tileX];
+}
+
+std::size_t DestructibleTerrain::getLayerCount() const {
+    return m_layers.size();
+}
+
+std::size_t DestructibleTerrain::getLastEditCellCount() const {
+    return m_lastEditCells;
+}
+
+sf::Time DestructibleTerrain::getLastEditTime() const {
+    return m_lastEditTime;
+}
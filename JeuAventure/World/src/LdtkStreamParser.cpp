@@ -0,0 +1,454 @@
+#include "LdtkStreamParser.h"
+#include <algorithm>
+#include <iostream>
+
+const LdtkLevelInfo* LdtkLevelData::getLevel() const {
+    if (levelIndex < 0 || levelIndex >= static_cast<int>(levels.size())) return nullptr;
+    return &levels[levelIndex];
+}
+
+const LdtkTilesetInfo* LdtkLevelData::findTileset(int uid) const {
+    for (const auto& tileset : tilesets) {
+        if (tileset.uid == uid) {
+            return &tileset;
+        }
+    }
+    return nullptr;
+}
+
+LdtkStreamParser::LdtkStreamParser(const std::string& levelIdentifier, LdtkLevelData& out)
+    : m_levelIdentifier(levelIdentifier),
+    m_out(out),
+    m_skipDepth(0),
+    m_levelSelected(false),
+    m_levelDone(false),
+    m_inAutoTiles(false),
+    m_csvIndex(0),
+    m_tile(),
+    m_arrayIndex(0),
+    m_entityGridSize(0)
+{
+}
+
+bool LdtkStreamParser::parse(std::istream& input, const std::string& levelIdentifier, LdtkLevelData& out) {
+    out = LdtkLevelData();
+
+    LdtkStreamParser handler(levelIdentifier, out);
+    if (!nlohmann::json::sax_parse(input, &handler)) {
+        std::cerr << "Error parsing LDtk project: " << handler.m_error << std::endl;
+        return false;
+    }
+
+    if (out.levelIndex < 0) {
+        std::cerr << "Level not found in LDtk project: "
+            << (levelIdentifier.empty() ? "(first level)" : levelIdentifier) << std::endl;
+        return false;
+    }
+
+    // defs precede levels in the file, so unused tilesets can only be
+    // dropped once the level's layers are known.
+    for (auto& tileset : handler.m_allTilesets) {
+        auto used = std::find_if(out.tileLayers.begin(), out.tileLayers.end(),
+            [&tileset](const LdtkTileLayer& layer) { return layer.tilesetDefUid == tileset.uid; });
+        if (used != out.tileLayers.end()) {
+            out.tilesets.push_back(std::move(tileset));
+        }
+    }
+
+    return true;
+}
+
+// Containers are chosen here from the keys seen so far, so the parser relies
+// on the key order LDtk writes: a level's "identifier" comes before its
+// "layerInstances", and a layer's "__type" and "__cWid" come before its
+// "intGridCsv", "gridTiles", "autoLayerTiles" and "entityInstances". A data
+// array that shows up before its layer type fails the parse instead of
+// being skipped silently.
+bool LdtkStreamParser::enter(bool isArray) {
+    if (m_skipDepth > 0) {
+        ++m_skipDepth;
+        return true;
+    }
+
+    if (m_stack.empty()) {
+        if (isArray) {
+            m_skipDepth = 1;
+        }
+        else {
+            m_stack.push_back(Context::Root);
+        }
+        return true;
+    }
+
+    bool interested = false;
+    Context next = Context::Root;
+
+    switch (m_stack.back()) {
+    case Context::Root:
+        if (!isArray && m_key == "defs") {
+            next = Context::Defs;
+            interested = true;
+        }
+        else if (isArray && m_key == "levels") {
+            next = Context::LevelArray;
+            interested = true;
+        }
+        break;
+
+    case Context::Defs:
+        if (isArray && m_key == "tilesets") {
+            next = Context::TilesetArray;
+            interested = true;
+        }
+        break;
+
+    case Context::TilesetArray:
+        if (!isArray) {
+            m_tileset = LdtkTilesetInfo();
+            next = Context::Tileset;
+            interested = true;
+        }
+        break;
+
+    case Context::LevelArray:
+        if (!isArray) {
+            m_level = LdtkLevelInfo();
+            m_levelSelected = false;
+            next = Context::Level;
+            interested = true;
+        }
+        break;
+
+    case Context::Level:
+        if (isArray && m_key == "layerInstances" && !m_levelDone) {
+            if (!m_levelIdentifier.empty() && m_level.identifier.empty()) {
+                m_error = "level layerInstances before its identifier";
+                return false;
+            }
+            m_levelSelected = m_levelIdentifier.empty() || m_level.identifier == m_levelIdentifier;
+            if (m_levelSelected) {
+                m_topDownLayers.clear();
+                next = Context::LayerArray;
+                interested = true;
+            }
+        }
+        break;
+
+    case Context::LayerArray:
+        if (!isArray) {
+            m_layer = LdtkTileLayer();
+            m_layerType.clear();
+            m_autoTiles.clear();
+            next = Context::Layer;
+            interested = true;
+        }
+        break;
+
+    case Context::Layer:
+        if (!isArray) break;
+        if (m_key == "intGridCsv" || m_key == "gridTiles" || m_key == "autoLayerTiles" || m_key == "entityInstances") {
+            if (m_layerType.empty() || (m_key == "intGridCsv" && m_layerType == "IntGrid" && m_layer.cellsX == 0)) {
+                m_error = "layer " + m_key + " before its __type and __cWid";
+                return false;
+            }
+        }
+        if (m_key == "intGridCsv" && m_layerType == "IntGrid" && m_layer.cellsX > 0) {
+            if (m_out.collisionWords.empty()) {
+                m_out.collisionGridSize = m_layer.gridSize;
+                m_out.collisionCellsX = m_layer.cellsX;
+                m_out.collisionCellsY = m_layer.cellsY;
+                m_out.collisionWordsPerRow = (m_layer.cellsX + 63) / 64;
+                m_out.collisionWords.assign(static_cast<std::size_t>(m_out.collisionWordsPerRow) * m_layer.cellsY, 0);
+            }
+            m_csvIndex = 0;
+            next = Context::IntGridCsv;
+            interested = true;
+        }
+        else if ((m_key == "gridTiles" || m_key == "autoLayerTiles") && m_layerType == "Tiles") {
+            m_inAutoTiles = m_key == "autoLayerTiles";
+            next = Context::TileArray;
+            interested = true;
+        }
+        else if (m_key == "entityInstances" && m_layerType == "Entities") {
+            next = Context::EntityArray;
+            interested = true;
+        }
+        break;
+
+    case Context::TileArray:
+        if (!isArray) {
+            m_tile = LayerTile();
+            next = Context::Tile;
+            interested = true;
+        }
+        break;
+
+    case Context::Tile:
+        if (isArray && m_key == "px") {
+            m_arrayIndex = 0;
+            next = Context::TilePx;
+            interested = true;
+        }
+        break;
+
+    case Context::EntityArray:
+        if (!isArray) {
+            m_entity = LdtkEntityInfo();
+            m_entityGridSize = m_layer.gridSize;
+            next = Context::Entity;
+            interested = true;
+        }
+        break;
+
+    case Context::Entity:
+        if (isArray && m_key == "__grid") {
+            m_arrayIndex = 0;
+            next = Context::EntityGrid;
+            interested = true;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (interested) {
+        m_stack.push_back(next);
+    }
+    else {
+        m_skipDepth = 1;
+    }
+    return true;
+}
+
+bool LdtkStreamParser::onNumber(double value) {
+    if (m_skipDepth > 0 || m_stack.empty()) return true;
+
+    int number = static_cast<int>(value);
+
+    switch (m_stack.back()) {
+    case Context::Root:
+        if (m_key == "defaultGridSize") m_out.defaultGridSize = number;
+        else if (m_key == "defaultLevelWidth") m_out.defaultLevelWidth = number;
+        else if (m_key == "defaultLevelHeight") m_out.defaultLevelHeight = number;
+        break;
+
+    case Context::Tileset:
+        if (m_key == "uid") m_tileset.uid = number;
+        else if (m_key == "tileGridSize") m_tileset.tileGridSize = number;
+        else if (m_key == "__cWid") m_tileset.columns = number;
+        break;
+
+    case Context::Level:
+        if (m_key == "worldX") m_level.worldX = number;
+        else if (m_key == "worldY") m_level.worldY = number;
+        else if (m_key == "pxWid") m_level.pxWidth = number;
+        else if (m_key == "pxHei") m_level.pxHeight = number;
+        break;
+
+    case Context::Layer:
+        if (m_key == "__cWid") m_layer.cellsX = number;
+        else if (m_key == "__cHei") m_layer.cellsY = number;
+        else if (m_key == "__gridSize") m_layer.gridSize = number;
+        else if (m_key == "__opacity") m_layer.opacity = static_cast<float>(value);
+        else if (m_key == "__pxTotalOffsetX") m_layer.offsetX = number;
+        else if (m_key == "__pxTotalOffsetY") m_layer.offsetY = number;
+        else if (m_key == "__tilesetDefUid") m_layer.tilesetDefUid = number;
+        break;
+
+    case Context::IntGridCsv:
+        if (number > 0) {
+            int x = m_csvIndex % m_layer.cellsX;
+            int y = m_csvIndex / m_layer.cellsX;
+            if (x < m_out.collisionCellsX && y < m_out.collisionCellsY) {
+                m_out.collisionWords[static_cast<std::size_t>(y) * m_out.collisionWordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+            }
+        }
+        ++m_csvIndex;
+        break;
+
+    case Context::Tile:
+        if (m_key == "t") {
+            m_tile.tileId = number;
+        }
+        else if (m_key == "f") {
+            // LDtk flip bits: 1 = horizontal, 2 = vertical.
+            m_tile.flipX = (number & 1) != 0;
+            m_tile.flipY = (number & 2) != 0;
+        }
+        break;
+
+    case Context::TilePx:
+        if (m_arrayIndex == 0) m_tile.x = number;
+        else if (m_arrayIndex == 1) m_tile.y = number;
+        ++m_arrayIndex;
+        break;
+
+    case Context::Entity:
+        if (m_key == "width") m_entity.width = number;
+        else if (m_key == "height") m_entity.height = number;
+        else if (m_key == "__gridSize") m_entityGridSize = number;
+        break;
+
+    case Context::EntityGrid:
+        if (m_arrayIndex == 0) m_entity.x = number;
+        else if (m_arrayIndex == 1) m_entity.y = number;
+        ++m_arrayIndex;
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+void LdtkStreamParser::finishLayer() {
+    if (m_layerType != "Tiles") return;
+
+    if (m_layer.tiles.empty()) {
+        m_layer.tiles.swap(m_autoTiles);
+    }
+
+    if (!m_layer.tiles.empty() && m_layer.tilesetDefUid >= 0) {
+        m_topDownLayers.push_back(std::move(m_layer));
+    }
+}
+
+void LdtkStreamParser::finishLevel() {
+    if (m_levelSelected) {
+        m_out.levelIndex = static_cast<int>(m_out.levels.size());
+
+        // LDtk lists layers top-most first.
+        m_out.tileLayers.assign(std::make_move_iterator(m_topDownLayers.rbegin()),
+            std::make_move_iterator(m_topDownLayers.rend()));
+        m_topDownLayers.clear();
+
+        m_levelSelected = false;
+        m_levelDone = true;
+    }
+
+    m_out.levels.push_back(m_level);
+}
+
+bool LdtkStreamParser::null() {
+    return true;
+}
+
+bool LdtkStreamParser::boolean(bool) {
+    return true;
+}
+
+bool LdtkStreamParser::number_integer(number_integer_t value) {
+    return onNumber(static_cast<double>(value));
+}
+
+bool LdtkStreamParser::number_unsigned(number_unsigned_t value) {
+    return onNumber(static_cast<double>(value));
+}
+
+bool LdtkStreamParser::number_float(number_float_t value, const string_t&) {
+    return onNumber(value);
+}
+
+bool LdtkStreamParser::string(string_t& value) {
+    if (m_skipDepth > 0 || m_stack.empty()) return true;
+
+    switch (m_stack.back()) {
+    case Context::Tileset:
+        if (m_key == "identifier") m_tileset.identifier = std::move(value);
+        else if (m_key == "relPath") m_tileset.relPath = std::move(value);
+        break;
+
+    case Context::Level:
+        if (m_key == "identifier") m_level.identifier = std::move(value);
+        break;
+
+    case Context::Layer:
+        if (m_key == "__identifier") m_layer.identifier = std::move(value);
+        else if (m_key == "__type") m_layerType = std::move(value);
+        break;
+
+    case Context::Entity:
+        if (m_key == "__identifier") m_entity.identifier = std::move(value);
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+bool LdtkStreamParser::binary(binary_t&) {
+    return true;
+}
+
+bool LdtkStreamParser::start_object(std::size_t) {
+    return enter(false);
+}
+
+bool LdtkStreamParser::key(string_t& value) {
+    if (m_skipDepth == 0) {
+        m_key = value;
+    }
+    return true;
+}
+
+bool LdtkStreamParser::end_object() {
+    if (m_skipDepth > 0) {
+        --m_skipDepth;
+        return true;
+    }
+
+    Context context = m_stack.back();
+    m_stack.pop_back();
+
+    switch (context) {
+    case Context::Tileset:
+        m_allTilesets.push_back(std::move(m_tileset));
+        break;
+
+    case Context::Level:
+        finishLevel();
+        break;
+
+    case Context::Layer:
+        finishLayer();
+        break;
+
+    case Context::Tile:
+        (m_inAutoTiles ? m_autoTiles : m_layer.tiles).push_back(m_tile);
+        break;
+
+    case Context::Entity:
+        m_entity.x *= m_entityGridSize;
+        m_entity.y *= m_entityGridSize;
+        m_out.entities.push_back(std::move(m_entity));
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+bool LdtkStreamParser::start_array(std::size_t) {
+    return enter(true);
+}
+
+bool LdtkStreamParser::end_array() {
+    if (m_skipDepth > 0) {
+        --m_skipDepth;
+        return true;
+    }
+
+    m_stack.pop_back();
+    return true;
+}
+
+bool LdtkStreamParser::parse_error(std::size_t, const std::string&, const nlohmann::json::exception& ex) {
+    m_error = ex.what();
+    return false;
+}
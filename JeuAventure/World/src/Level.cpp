@@ -1,5 +1,13 @@
 #include "Level.h"
 #include "Tilemap.h"
+#include "TileColliderSet.h"
+#include "DestructibleTerrain.h"
+#include "TileLightMap.h"
+#include "TriggerVolumeSystem.h"
+#include "PickupField.h"
+#include "TileLayerMesh.h"
+#include "TileAnimationSet.h"
+#include "WorldStreamer.h"
 #include "Background.h"
 #include "LevelLoader.h"
 #include "Entity.h"
@@ -14,6 +22,7 @@ Level::Level(const std::string& name)
     m_height(0.0f),
     m_tileWidth(32),
     m_tileHeight(32),
+    m_playerLight(-1),
     m_player(nullptr),
     m_activeCheckpoint(nullptr),
     m_musicPlaying(false),
@@ -22,11 +31,48 @@ Level::Level(const std::string& name)
     m_isLoaded(false),
     m_levelTimer(0.0f) {
     m_tilemap = std::make_unique<Tilemap>(100, 100);
+    m_tileColliders = std::make_unique<TileColliderSet>();
+    m_terrain = std::make_unique<DestructibleTerrain>();
+    m_terrain->setTilemap(m_tilemap.get());
+    m_lighting = std::make_unique<TileLightMap>();
+    m_triggerVolumes = std::make_unique<TriggerVolumeSystem>();
+    m_pickups = std::make_unique<PickupField>();
     m_cameraBounds = sf::FloatRect(0.0f, 0.0f, 0.0f, 0.0f);
     EventSystem::getInstance()->addEventListener("PlayerDied", [this](const std::map<std::string, std::any>& params) {});
+    m_eventListeners.emplace_back("DestroyTerrain", EventSystem::getInstance()->addEventListener("DestroyTerrain", [this](const std::map<std::string, std::any>& params) {
+        auto position = params.find("position");
+        auto radius = params.find("radius");
+        if (position != params.end() && radius != params.end()) {
+            m_terrain->destroyCircle(std::any_cast<sf::Vector2f>(position->second), std::any_cast<float>(radius->second));
+        }
+        }));
+    m_eventListeners.emplace_back("CreatePickup", EventSystem::getInstance()->addEventListener("CreatePickup", [this](const std::map<std::string, std::any>& params) {
+        auto position = params.find("position");
+        auto type = params.find("type");
+        if (position == params.end() || type == params.end()) return;
+
+        // Senders pass either a string literal or a std::string.
+        const sf::Vector2f* pickupPosition = std::any_cast<sf::Vector2f>(&position->second);
+        if (!pickupPosition) return;
+        if (const std::string* pickupType = std::any_cast<std::string>(&type->second)) {
+            m_pickups->add(*pickupType, *pickupPosition);
+        }
+        else if (const char* const* pickupName = std::any_cast<const char*>(&type->second)) {
+            m_pickups->add(*pickupName, *pickupPosition);
+        }
+        }));
+    m_eventListeners.emplace_back("TerrainChanged", EventSystem::getInstance()->addEventListener("TerrainChanged", [this](const std::map<std::string, std::any>& params) {
+        auto cells = params.find("cells");
+        if (cells != params.end()) {
+            m_lighting->onTilesChanged(std::any_cast<sf::IntRect>(cells->second));
+        }
+        }));
 }
 
 Level::~Level() {
+    for (const auto& listener : m_eventListeners) {
+        EventSystem::getInstance()->removeEventListener(listener.first, listener.second);
+    }
     clearEntities();
 }
 
@@ -45,12 +91,16 @@ bool Level::loadFromFile(const std::string& levelFolder) {
 }
 
 void Level::initialize() {
+    m_tileColliders->build(m_tilemap.get());
+    m_lighting->build(m_tilemap.get());
+
     for (auto* entity : m_entities) {
         if (entity) {
             entity->setLevel(this);
             entity->initialize();
         }
     }
+    m_triggerVolumes->build();
 
     if (!m_musicPath.empty()) {
         playMusic();
@@ -78,6 +128,7 @@ void Level::reset() {
 
 void Level::update(float dt) {
     m_levelTimer += dt;
+    m_lighting->update();
 
     auto it = m_entities.begin();
     while (it != m_entities.end()) {
@@ -88,6 +139,7 @@ void Level::update(float dt) {
         }
         else if (entity && !entity->isActive()) {
             it = m_entities.erase(it);
+            m_triggerVolumes->removeVolumesOf(entity);
             delete entity;
         }
         else {
@@ -95,7 +147,27 @@ void Level::update(float dt) {
         }
     }
 
+    m_triggerVolumes->update();
+    m_pickups->update(dt, m_player);
+
+    if (m_worldStreamer && m_player) {
+        m_worldStreamer->update(m_player->getPosition());
+    }
+
+    if (m_player) {
+        sf::FloatRect bounds = m_player->getBounds();
+        sf::Vector2f center(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+        if (m_playerLight < 0) {
+            m_playerLight = m_lighting->addLight(center, 8);
+        }
+        else {
+            m_lighting->moveLight(m_playerLight, center);
+        }
+    }
+
     if (m_tilemap) { m_tilemap->update(dt); }
+    TileAnimationSet::getInstance()->update(dt);
+    m_tileColliders->update();
     if (m_background) { m_background->update(dt); }
 
     for (Checkpoint* checkpoint : m_checkpoints) {
@@ -114,6 +186,14 @@ void Level::render(sf::RenderWindow& window) {
         window.draw(*layer);
     }
 
+    for (const auto& mesh : m_tileMeshes) {
+        mesh->render(window);
+    }
+
+    if (m_worldStreamer) {
+        m_worldStreamer->render(window);
+    }
+
     if (m_tilemap) {
         m_tilemap->render(window);
     }
@@ -127,17 +207,26 @@ void Level::render(sf::RenderWindow& window) {
         }
     );
 
+    m_spriteBatch.begin();
+
     for (Entity* entity : m_entities) {
         if (entity && entity->isActive() && entity->isVisible()) {
-            entity->render(window);
+            entity->render(m_spriteBatch);
         }
     }
 
+    const sf::View& view = window.getView();
+    m_pickups->render(m_spriteBatch, sf::FloatRect(view.getCenter() - view.getSize() / 2.0f, view.getSize()));
+
     for (Checkpoint* checkpoint : m_checkpoints) {
         if (checkpoint && checkpoint->isActive() && checkpoint->isVisible()) {
-            checkpoint->render(window);
+            checkpoint->render(m_spriteBatch);
         }
     }
+
+    m_spriteBatch.end(window);
+
+    m_lighting->render(window);
 }
 
 void Level::addEntity(Entity* entity) {
@@ -155,6 +244,7 @@ void Level::removeEntity(Entity* entity) {
     auto it = std::find(m_entities.begin(), m_entities.end(), entity);
     if (it != m_entities.end()) {
         m_entities.erase(it);
+        m_triggerVolumes->removeVolumesOf(entity);
     }
 }
 
@@ -173,11 +263,17 @@ void Level::clearEntities() {
     }
     m_entities.clear();
     m_checkpoints.clear();
+    m_triggerVolumes->clear();
+    m_pickups->clear();
 }
 
 void Level::setTilemap(Tilemap* tilemap) {
     if (tilemap) {
+        m_tileColliders->clear();
         m_tilemap.reset(tilemap);
+        m_terrain->setTilemap(tilemap);
+        m_lighting->clear();
+        m_playerLight = -1;
     }
 }
 
@@ -185,6 +281,30 @@ Tilemap* Level::getTilemap() const {
     return m_tilemap.get();
 }
 
+const TileColliderSet* Level::getTileColliders() const {
+    return m_tileColliders.get();
+}
+
+DestructibleTerrain* Level::getTerrain() const {
+    return m_terrain.get();
+}
+
+TileLightMap* Level::getLighting() const {
+    return m_lighting.get();
+}
+
+TriggerVolumeSystem* Level::getTriggerVolumes() const {
+    return m_triggerVolumes.get();
+}
+
+PickupField* Level::getPickups() const {
+    return m_pickups.get();
+}
+
+const SpriteBatch& Level::getSpriteBatch() const {
+    return m_spriteBatch;
+}
+
 void Level::setBackground(const std::string& texturePath) {
     std::string textureId = "bg_" + m_name;
     size_t lastSlash = texturePath.find_last_of("/\\");
@@ -273,6 +393,9 @@ sf::Vector2f Level::getPlayerStart() const {
 }
 
 void Level::setPlayer(Player* player) {
+    if (m_player) {
+        m_triggerVolumes->removeActivator(m_player);
+    }
     m_player = player;
 
     if (m_player) {
@@ -281,6 +404,7 @@ void Level::setPlayer(Player* player) {
         }
 
         m_player->setPosition(m_playerStartPosition);
+        m_triggerVolumes->addActivator(m_player);
     }
 }
 
@@ -384,14 +508,22 @@ void Level::setCameraBounds(const sf::FloatRect& bounds) {
 }
 
 sf::FloatRect Level::getCameraBounds() const {
-    return m_cameraBounds.width > 0.0f && m_cameraBounds.height > 0.0f ?
+    sf::FloatRect bounds = m_cameraBounds.width > 0.0f && m_cameraBounds.height > 0.0f ?
         m_cameraBounds :
         sf::FloatRect(0.0f, 0.0f, m_width, m_height);
+
+    if (m_worldStreamer) {
+        bounds = m_worldStreamer->extendBounds(bounds);
+    }
+    return bounds;
 }
 
 bool Level::checkCollision(const sf::FloatRect& rect) const {
-    if (m_tilemap) {
-        return m_tilemap->checkCollision(rect);
+    if (m_tilemap && m_tilemap->checkCollision(rect)) {
+        return true;
+    }
+    if (m_worldStreamer) {
+        return m_worldStreamer->checkCollision(rect);
     }
     return false;
 }
@@ -447,6 +579,39 @@ void Level::addTileLayer(std::unique_ptr<sf::Sprite> layer) {
     }
 }
 
+void Level::addTileMesh(std::unique_ptr<TileLayerMesh> mesh) {
+    if (mesh) {
+        m_terrain->addLayer(mesh.get());
+        m_tileMeshes.push_back(std::move(mesh));
+    }
+}
+
+const std::vector<std::unique_ptr<TileLayerMesh>>& Level::getTileMeshes() const {
+    return m_tileMeshes;
+}
+
+void Level::clearTileMeshes() {
+    m_terrain->clear();
+    m_terrain->setTilemap(m_tilemap.get());
+    m_tileMeshes.clear();
+}
+
+void Level::setAssets(AssetGroup assets) {
+    m_assets = std::move(assets);
+}
+
+const AssetGroup& Level::getAssets() const {
+    return m_assets;
+}
+
+void Level::setWorldStreamer(std::unique_ptr<WorldStreamer> streamer) {
+    m_worldStreamer = std::move(streamer);
+}
+
+WorldStreamer* Level::getWorldStreamer() const {
+    return m_worldStreamer.get();
+}
+
 void Level::setBackground(sf::Texture* texture) {
     if (texture) {
         m_background = std::make_unique<Background>(*texture);
@@ -1,6 +1,15 @@
 #include "LevelLoader.h"
 #include "Level.h"
 #include "Tilemap.h"
+#include "TileLayerMesh.h"
+#include "TileAnimationSet.h"
+#include "DestructibleTerrain.h"
+#include "TileLightMap.h"
+#include "PickupField.h"
+#include "CookedLevelFile.h"
+#include "LdtkStreamParser.h"
+#include "WorldStreamer.h"
+#include "BitUtils.h"
 #include "RessourceManager.h"
 #include "Player.h"
 #include "Objects.h"
@@ -8,9 +17,6 @@
 #include <filesystem>
 #include <fstream>
 #include <SFML/Graphics.hpp>
-#include <nlohmann/json.hpp>
-
-using json = nlohmann::json;
 
 bool LevelLoader::loadLevel(const std::string& jsonFilePath, Level* level) {
     if (!level) {
@@ -22,351 +28,407 @@ bool LevelLoader::loadLevel(const std::string& jsonFilePath, Level* level) {
         RessourceManager* resourceManager = RessourceManager::getInstance();
         std::filesystem::path fullJsonPath = resourceManager->getResourcePath(jsonFilePath + "\\allData.json");
 
+        std::filesystem::path animationsPath = fullJsonPath.parent_path() / "tileAnimations.json";
+        if (std::filesystem::exists(animationsPath)) {
+            TileAnimationSet::getInstance()->loadFromFile(animationsPath.string());
+        }
+
+        std::filesystem::path terrainRulesPath = fullJsonPath.parent_path() / "terrainRules.json";
+        if (std::filesystem::exists(terrainRulesPath)) {
+            level->getTerrain()->loadRules(terrainRulesPath.string());
+        }
+
+        std::filesystem::path cookedPath = fullJsonPath;
+        cookedPath.replace_extension(".cooked");
+        if (isCookedFileCurrent(cookedPath, fullJsonPath) && loadCookedLevel(cookedPath.string(), fullJsonPath, level)) {
+            return true;
+        }
+
         std::cout << "Loading LDtk level from: " << fullJsonPath << std::endl;
 
-        std::ifstream file(fullJsonPath);
+        std::ifstream file(fullJsonPath, std::ios::binary);
         if (!file.is_open()) {
             std::cerr << "Error: Could not open LDtk file: " << fullJsonPath << std::endl;
             return false;
         }
 
-        json projectData;
-        file >> projectData;
+        sf::Clock parseClock;
+        LdtkLevelData levelData;
+        if (!LdtkStreamParser::parse(file, "", levelData)) {
+            return false;
+        }
         file.close();
 
-        int defaultGridSize = projectData["defaultGridSize"];
-        int defaultLevelWidth = projectData["defaultLevelWidth"];
-        int defaultLevelHeight = projectData["defaultLevelHeight"];
+        std::cout << "Streamed LDtk level " << levelData.getLevel()->identifier << " in "
+            << parseClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
 
-        defaultLevelWidth = 2048;
-        defaultLevelHeight = 512;
+        loadParsedLevel(levelData, level);
+        enableWorldStreaming(level, fullJsonPath, levelData.levels, levelData.levelIndex);
 
-        std::cout << "Adjusted level dimensions: " << defaultLevelWidth << "x" << defaultLevelHeight
-            << ", Grid size: " << defaultGridSize << std::endl;
+        std::cout << "Basic level loaded successfully" << std::endl;
+        std::cout << "Actual rendering dimensions: " << level->getWidth() << "x" << level->getHeight() << std::endl;
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error loading level: " << e.what() << std::endl;
+        return false;
+    }
+}
 
-        level->setSize(defaultLevelWidth, defaultLevelHeight);
-        level->setTileSize(defaultGridSize, defaultGridSize);
+void LevelLoader::loadParsedLevel(const LdtkLevelData& data, Level* level) {
+    const LdtkLevelInfo* info = data.getLevel();
+    int gridSize = data.defaultGridSize;
+    int width = info->pxWidth > 0 ? info->pxWidth : data.defaultLevelWidth;
+    int height = info->pxHeight > 0 ? info->pxHeight : data.defaultLevelHeight;
 
-        Tilemap* tilemap = level->getTilemap();
-        if (!tilemap) {
-            tilemap = new Tilemap(defaultLevelWidth / defaultGridSize, defaultLevelHeight / defaultGridSize);
-            level->setTilemap(tilemap);
-        }
-        tilemap->setTileSize(defaultGridSize, defaultGridSize);
+    std::cout << "Level dimensions: " << width << "x" << height
+        << ", Grid size: " << gridSize << std::endl;
 
-        if (resourceManager->loadTexture("background", "Background.png")) {
-            sf::Texture* platformTexture = resourceManager->getTexture("background");
-            if (platformTexture) {
-                level->addPlatformLayer(platformTexture);
-                std::cout << "Added basic platform layer" << std::endl;
-            }
-        }
-        if (resourceManager->loadTexture("platform_base", "platform_base.png")) {
-            sf::Texture* platformTexture = resourceManager->getTexture("platform_base");
-            if (platformTexture) {
-                level->addPlatformLayer(platformTexture);
-                std::cout << "Added basic platform layer" << std::endl;
-            }
-        }
-        else {
-            sf::Image defaultImage;
-            defaultImage.create(defaultLevelWidth, defaultLevelHeight, sf::Color(200, 200, 200));
-
-            for (int y = 0; y < defaultLevelHeight; y += defaultGridSize * 5) {
-                for (int x = 0; x < defaultLevelWidth; x++) {
-                    defaultImage.setPixel(x, y, sf::Color::Black);
-                }
-            }
+    prepareLevel(level, width, height, gridSize);
 
-            std::unique_ptr<sf::Texture> defaultTexture = std::make_unique<sf::Texture>();
-            if (defaultTexture->loadFromImage(defaultImage)) {
-                sf::Texture* tex = resourceManager->getTexture("default_platform");
-                if (tex) {
-                    level->addPlatformLayer(tex);
-                    std::cout << "Added default platform layer" << std::endl;
-                }
-            }
-        }
+    int collisionCount = applyCollisionWords(level, data.collisionWords.data(),
+        data.collisionWordsPerRow, data.collisionCellsY);
+    std::cout << "Added " << collisionCount << " collision tiles" << std::endl;
 
-        if (projectData.contains("levels") && !projectData["levels"].empty()) {
-            const auto& firstLevel = projectData["levels"][0];
-            if (firstLevel.contains("layerInstances")) {
-                for (const auto& layer : firstLevel["layerInstances"]) {
-                    if (layer["__type"] == "IntGrid") {
-                        std::cout << "Processing collision layer: " << layer["__identifier"] << std::endl;
-                        loadCollisionsFromIntGrid(level, layer, defaultGridSize);
-                    }
-                }
-            }
+    // The tilesets decode on the loader threads while the meshes are built.
+    sf::Clock layerClock;
+    AssetManifest manifest;
+    for (const auto& tileset : data.tilesets) {
+        addTilesetToManifest(manifest, tileset.identifier, tileset.relPath);
+    }
+    RessourceManager::getInstance()->prefetch(manifest);
+
+    std::vector<std::unique_ptr<TileLayerMesh>> meshes;
+    std::vector<std::string> meshTilesets;
+    for (const auto& layer : data.tileLayers) {
+        const LdtkTilesetInfo* tileset = data.findTileset(layer.tilesetDefUid);
+        if (!tileset) {
+            std::cerr << "Tileset not found for UID: " << layer.tilesetDefUid << std::endl;
+            continue;
         }
 
-        sf::Vector2f playerStart(100, 100);
-        level->setPlayerStart(playerStart);
+        auto mesh = std::make_unique<TileLayerMesh>(layer.identifier, nullptr, tileset->tileGridSize, tileset->columns);
+        mesh->setOffset(sf::Vector2f(static_cast<float>(layer.offsetX), static_cast<float>(layer.offsetY)));
+        mesh->setOpacity(layer.opacity);
+        mesh->setAnimations(TileAnimationSet::getInstance()->find(tileset->identifier));
+        mesh->buildVertices(layer.tiles, layer.gridSize, layer.cellsX, layer.cellsY);
 
-        createDefaultEntities(level);
+        meshes.push_back(std::move(mesh));
+        meshTilesets.push_back(tileset->identifier);
+    }
 
-        level->initialize();
+    addTileMeshes(level, manifest, meshes, meshTilesets);
+    std::cout << "Built " << level->getTileMeshes().size() << " tile layer meshes in "
+        << layerClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
 
-        std::cout << "Basic level loaded successfully" << std::endl;
-        std::cout << "Actual rendering dimensions: " << level->getWidth() << "x" << level->getHeight() << std::endl;
-        return true;
+    if (level->getTileMeshes().empty()) {
+        addFallbackLayers(level, width, height, gridSize);
     }
-    catch (const std::exception& e) {
-        std::cerr << "Error loading level: " << e.what() << std::endl;
-        return false;
+
+    for (const auto& entityData : data.entities) {
+        if (addLevelLight(level, entityData.identifier, entityData.x, entityData.y, entityData.width, entityData.height) ||
+            addLevelPickup(level, entityData.identifier, entityData.x, entityData.y)) {
+            continue;
+        }
+
+        Entity* entity = createEntityByType(entityData.identifier, entityData.width, entityData.height);
+        if (entity) {
+            entity->setPosition(static_cast<float>(entityData.x), static_cast<float>(entityData.y));
+            level->addEntity(entity);
+
+            std::cout << "Added entity: " << entityData.identifier << " at position " << entityData.x << "," << entityData.y << std::endl;
+        }
     }
+
+    finishLevel(level);
 }
 
-void LevelLoader::loadCollisionsFromIntGrid(Level* level, const json& layerData, int gridSize) {
+int LevelLoader::applyCollisionWords(Level* level, const std::uint64_t* words, int wordsPerRow, int rows) {
     Tilemap* tilemap = level->getTilemap();
-    if (!tilemap) return;
-
-    int gridWidth = layerData["__cWid"];
-    int gridHeight = layerData["__cHei"];
-
-    if (layerData.contains("intGridCsv")) {
-        const auto& intGridValues = layerData["intGridCsv"];
-
-        int collisionCount = 0;
-
-        for (int y = 0; y < gridHeight; y++) {
-            for (int x = 0; x < gridWidth; x++) {
-                int idx = y * gridWidth + x;
-                if (idx < intGridValues.size()) {
-                    int value = intGridValues[idx];
-                    if (value > 0) { 
-                        tilemap->setTile(x, y, value);
-                        tilemap->setTileCollision(x, y, true);
-                        collisionCount++;
-                    }
-                }
+    if (!tilemap) return 0;
+
+    int collisionCount = 0;
+    for (int y = 0; y < rows; ++y) {
+        for (int w = 0; w < wordsPerRow; ++w) {
+            std::uint64_t bits = words[y * wordsPerRow + w];
+            while (bits) {
+                int x = w * 64 + BitUtils::countTrailingZeros(bits);
+                tilemap->setTile(x, y, 1);
+                tilemap->setTileCollision(x, y, true);
+                ++collisionCount;
+                bits &= bits - 1;
             }
         }
-
-        std::cout << "Added " << collisionCount << " collision tiles from layer " << (std::string)layerData["__identifier"] << std::endl;
     }
+    return collisionCount;
 }
 
-void LevelLoader::loadTileLayer(Level* level, const json& layerData, const json& project, const std::string& basePath) {
-    int tilesetDefUid = layerData["__tilesetDefUid"];
+void LevelLoader::prepareLevel(Level* level, int width, int height, int gridSize) {
+    // Tile size first: setSize derives the tilemap's cell count from it.
+    level->setTileSize(gridSize, gridSize);
+    level->setSize(width, height);
 
-    json tileset = findTileset(project, tilesetDefUid);
-    if (tileset.empty()) {
-        std::cerr << "Tileset not found for UID: " << tilesetDefUid << std::endl;
-        return;
+    Tilemap* tilemap = level->getTilemap();
+    if (!tilemap) {
+        tilemap = new Tilemap(width / gridSize, height / gridSize);
+        level->setTilemap(tilemap);
     }
+    tilemap->setTileSize(gridSize, gridSize);
 
-    std::string relPath = tileset["relPath"];
-    std::string tilesetId = tileset["identifier"];
-
-    std::filesystem::path relPathObj(relPath);
-    std::string fileName = relPathObj.filename().string();
+    level->clearTileMeshes();
+    level->setWorldStreamer(nullptr);
+}
 
-    sf::Texture* texture = nullptr;
+void LevelLoader::addFallbackLayers(Level* level, int width, int height, int gridSize) {
     RessourceManager* resourceManager = RessourceManager::getInstance();
 
-    if (resourceManager->loadTexture(tilesetId, fileName)) {
-        texture = resourceManager->getTexture(tilesetId);
-    }
-    else if (resourceManager->loadTexture(tilesetId, relPath)) {
-        texture = resourceManager->getTexture(tilesetId);
+    if (resourceManager->loadTexture("background", "Background.png")) {
+        sf::Texture* platformTexture = resourceManager->getTexture("background"_rid);
+        if (platformTexture) {
+            level->addPlatformLayer(platformTexture);
+            std::cout << "Added basic platform layer" << std::endl;
+        }
     }
-    else if (std::filesystem::exists(relPath)) {
-        if (resourceManager->loadTexture(tilesetId, relPath)) {
-            texture = resourceManager->getTexture(tilesetId);
+    if (resourceManager->loadTexture("platform_base", "platform_base.png")) {
+        sf::Texture* platformTexture = resourceManager->getTexture("platform_base"_rid);
+        if (platformTexture) {
+            level->addPlatformLayer(platformTexture);
+            std::cout << "Added basic platform layer" << std::endl;
         }
     }
     else {
-        std::vector<std::string> searchPaths = {
-            "Textures/" + fileName,
-            "tilesets/" + fileName,
-            fileName
-        };
-
-        for (const auto& path : searchPaths) {
-            if (resourceManager->loadTexture(tilesetId, path)) {
-                texture = resourceManager->getTexture(tilesetId);
-                std::cout << "Loaded tileset texture from: " << path << std::endl;
-                break;
+        sf::Image defaultImage;
+        defaultImage.create(width, height, sf::Color(200, 200, 200));
+
+        for (int y = 0; y < height; y += gridSize * 5) {
+            for (int x = 0; x < width; x++) {
+                defaultImage.setPixel(x, y, sf::Color::Black);
             }
         }
-    }
 
-    if (!texture) {
-        std::cerr << "Failed to load tileset texture: " << relPath << std::endl;
-        return;
+        std::unique_ptr<sf::Texture> defaultTexture = std::make_unique<sf::Texture>();
+        if (defaultTexture->loadFromImage(defaultImage)) {
+            sf::Texture* tex = resourceManager->getTexture("default_platform"_rid);
+            if (tex) {
+                level->addPlatformLayer(tex);
+                std::cout << "Added default platform layer" << std::endl;
+            }
+        }
     }
+}
 
-    std::cout << "Successfully loaded tileset: " << tilesetId << ", texture size: "
-        << texture->getSize().x << "x" << texture->getSize().y << std::endl;
-
-    std::unique_ptr<sf::Sprite> layerSprite = std::make_unique<sf::Sprite>();
+void LevelLoader::enableWorldStreaming(Level* level, const std::filesystem::path& projectPath, const std::vector<LdtkLevelInfo>& levels, int homeIndex) {
+    if (levels.size() < 2) return;
 
-    sf::RenderTexture renderTexture;
-    if (!renderTexture.create(level->getWidth(), level->getHeight())) {
-        std::cerr << "Failed to create render texture for layer" << std::endl;
-        return;
-    }
-    renderTexture.clear(sf::Color::Transparent);
+    level->setWorldStreamer(std::make_unique<WorldStreamer>(projectPath, levels, homeIndex));
+    std::cout << "World streaming enabled for " << levels.size() - 1 << " neighbouring level(s)" << std::endl;
+}
 
-    int tileSize = tileset["tileGridSize"];
-    int tilesetColumns = tileset["__cWid"];
+void LevelLoader::finishLevel(Level* level) {
+    sf::Vector2f playerStart(100, 100);
+    level->setPlayerStart(playerStart);
 
-    std::cout << "Tileset grid size: " << tileSize << ", columns: " << tilesetColumns << std::endl;
+    createDefaultEntities(level);
 
-    if (layerData.contains("gridTiles")) {
-        sf::Sprite tileSprite(*texture);
+    level->initialize();
+}
 
-        for (const auto& tile : layerData["gridTiles"]) {
-            int tileId = tile["t"];
+bool LevelLoader::isCookedFileCurrent(const std::filesystem::path& cookedPath, const std::filesystem::path& sourcePath) {
+    std::error_code error;
+    if (!std::filesystem::exists(cookedPath, error)) {
+        return false;
+    }
 
-            int destX = tile["px"][0];
-            int destY = tile["px"][1];
+    if (std::filesystem::exists(sourcePath, error) &&
+        std::filesystem::last_write_time(cookedPath, error) < std::filesystem::last_write_time(sourcePath, error)) {
+        std::cout << "Cooked level is older than " << sourcePath << ", falling back to JSON" << std::endl;
+        return false;
+    }
 
-            int srcX = (tileId % tilesetColumns) * tileSize;
-            int srcY = (tileId / tilesetColumns) * tileSize;
+    return true;
+}
 
-            tileSprite.setTextureRect(sf::IntRect(srcX, srcY, tileSize, tileSize));
-            tileSprite.setPosition(destX, destY);
+bool LevelLoader::loadCookedLevel(const std::string& cookedPath, const std::filesystem::path& projectPath, Level* level) {
+    sf::Clock loadClock;
 
-            bool flipX = false;
-            bool flipY = false;
-            if (tile.contains("f")) flipX = (tile["f"] == 1 || tile["f"] == 3);
-            if (tile.contains("f")) flipY = (tile["f"] == 2 || tile["f"] == 3);
+    CookedLevelFile cooked;
+    if (!cooked.open(cookedPath)) {
+        return false;
+    }
 
-            sf::Vector2f scale(1.0f, 1.0f);
-            if (flipX) scale.x = -1.0f;
-            if (flipY) scale.y = -1.0f;
+    const CookedLevelFormat::Level* data = cooked.getLevel(0);
+    if (!data) {
+        std::cerr << "Cooked file contains no level: " << cookedPath << std::endl;
+        return false;
+    }
 
-            tileSprite.setScale(scale);
+    int gridSize = static_cast<int>(data->gridSize);
+    prepareLevel(level, data->pxWidth, data->pxHeight, gridSize);
 
-            if (flipX || flipY) {
-                tileSprite.setOrigin(
-                    flipX ? tileSize : 0,
-                    flipY ? tileSize : 0
-                );
-            }
-            else {
-                tileSprite.setOrigin(0, 0);
-            }
+    applyCollisionWords(level, cooked.getCollisionWords(*data), data->collisionWordsPerRow, data->cellsY);
 
-            renderTexture.draw(tileSprite);
+    const CookedLevelFormat::Layer* layers = cooked.getLayers(*data);
 
-            tileSprite.setScale(1.0f, 1.0f);
-            tileSprite.setOrigin(0, 0);
-        }
+    AssetManifest manifest;
+    for (std::uint32_t i = 0; i < data->layerCount; ++i) {
+        const CookedLevelFormat::Tileset* tileset = cooked.getTileset(layers[i].tilesetIndex);
+        addTilesetToManifest(manifest, cooked.getString(tileset->identifier), cooked.getString(tileset->relPath));
     }
+    RessourceManager::getInstance()->prefetch(manifest);
+
+    std::vector<LayerTile> tiles;
+    std::vector<std::unique_ptr<TileLayerMesh>> meshes;
+    std::vector<std::string> meshTilesets;
+    for (std::uint32_t i = 0; i < data->layerCount; ++i) {
+        const CookedLevelFormat::Layer& layer = layers[i];
+        const CookedLevelFormat::Tileset* tileset = cooked.getTileset(layer.tilesetIndex);
+        std::string tilesetId = cooked.getString(tileset->identifier);
+
+        const CookedLevelFormat::Tile* cookedTiles = cooked.getTiles(layer);
+        tiles.clear();
+        tiles.reserve(layer.tileCount);
+        for (std::uint32_t t = 0; t < layer.tileCount; ++t) {
+            LayerTile tile;
+            tile.tileId = cookedTiles[t].tileId;
+            tile.x = cookedTiles[t].cellX * static_cast<int>(layer.gridSize);
+            tile.y = cookedTiles[t].cellY * static_cast<int>(layer.gridSize);
+            tile.flipX = (cookedTiles[t].flags & CookedLevelFormat::TileFlipX) != 0;
+            tile.flipY = (cookedTiles[t].flags & CookedLevelFormat::TileFlipY) != 0;
+            tiles.push_back(tile);
+        }
 
-    renderTexture.display();
-
-    layerSprite->setTexture(renderTexture.getTexture());
-
-    std::string layerId = layerData["__identifier"];
+        auto mesh = std::make_unique<TileLayerMesh>(cooked.getString(layer.identifier), nullptr, tileset->tileSize, tileset->columns);
+        mesh->setOffset(sf::Vector2f(static_cast<float>(layer.offsetX), static_cast<float>(layer.offsetY)));
+        mesh->setOpacity(layer.opacity);
+        mesh->setAnimations(TileAnimationSet::getInstance()->find(tilesetId));
+        mesh->buildVertices(tiles, layer.gridSize, layer.cellsX, layer.cellsY);
 
-    if (layerId == "RealBackground" || layerId == "Back") {
-        sf::Texture bgTexture = renderTexture.getTexture();
-        level->setBackground(texture);
-        std::cout << "Set layer as background: " << layerId << std::endl;
-    }
-    else {
-        level->addTileLayer(std::move(layerSprite));
-        std::cout << "Added layer as normal layer: " << layerId << std::endl;
+        meshes.push_back(std::move(mesh));
+        meshTilesets.push_back(tilesetId);
     }
-}
+    addTileMeshes(level, manifest, meshes, meshTilesets);
 
-void LevelLoader::loadEntities(Level* level, const json& layerData) {
-    if (!layerData.contains("entityInstances")) return;
+    if (level->getTileMeshes().empty()) {
+        addFallbackLayers(level, data->pxWidth, data->pxHeight, gridSize);
+    }
 
-    const auto& entities = layerData["entityInstances"];
+    const CookedLevelFormat::Entity* entities = cooked.getEntities(*data);
+    for (std::uint32_t i = 0; i < data->entityCount; ++i) {
+        std::string identifier = cooked.getString(entities[i].identifier);
+        if (addLevelLight(level, identifier, entities[i].x, entities[i].y, entities[i].width, entities[i].height) ||
+            addLevelPickup(level, identifier, entities[i].x, entities[i].y)) {
+            continue;
+        }
 
-    for (const auto& entityData : entities) {
-        std::string entityType = entityData["__identifier"];
+        Entity* entity = createEntityByType(identifier, entities[i].width, entities[i].height);
+        if (entity) {
+            entity->setPosition(static_cast<float>(entities[i].x), static_cast<float>(entities[i].y));
+            level->addEntity(entity);
+        }
+    }
 
-        Entity* entity = createEntityByType(entityType, entityData);
+    std::cout << "Loaded cooked level " << cooked.getString(data->identifier) << " in "
+        << loadClock.getElapsedTime().asMicroseconds() << " us" << std::endl;
 
-        if (entity) {
-            int gridSize = entityData["__gridSize"].get<int>();
-            int pixelX = entityData["__grid"][0].get<int>() * gridSize;
-            int pixelY = entityData["__grid"][1].get<int>() * gridSize;
-            entity->setPosition(pixelX, pixelY);
+    finishLevel(level);
 
-            level->addEntity(entity);
+    std::vector<LdtkLevelInfo> levels;
+    for (std::uint32_t i = 0; i < cooked.getLevelCount(); ++i) {
+        const CookedLevelFormat::Level* cookedLevel = cooked.getLevel(i);
 
-            std::cout << "Added entity: " << entityType << " at position " << pixelX << "," << pixelY << std::endl;
-        }
+        LdtkLevelInfo info;
+        info.identifier = cooked.getString(cookedLevel->identifier);
+        info.worldX = cookedLevel->worldX;
+        info.worldY = cookedLevel->worldY;
+        info.pxWidth = cookedLevel->pxWidth;
+        info.pxHeight = cookedLevel->pxHeight;
+        levels.push_back(info);
     }
+    enableWorldStreaming(level, projectPath, levels, 0);
+
+    return true;
 }
 
-json LevelLoader::findTileset(const json& project, int tilesetId) {
-    if (project.contains("defs") && project["defs"].contains("tilesets")) {
-        for (const auto& tileset : project["defs"]["tilesets"]) {
-            if (tileset["uid"] == tilesetId) {
-                return tileset;
-            }
+void LevelLoader::addTilesetToManifest(AssetManifest& manifest, const std::string& tilesetId, const std::string& relPath) {
+    RessourceManager* resourceManager = RessourceManager::getInstance();
+    if (resourceManager->hasTexture(tilesetId)) {
+        manifest.add(AssetType::Texture, tilesetId, relPath);
+        return;
+    }
+
+    std::string fileName = std::filesystem::path(relPath).filename().string();
+    std::vector<std::string> searchPaths = {
+        relPath,
+        fileName,
+        "Textures/" + fileName,
+        "tilesets/" + fileName
+    };
+
+    for (const auto& path : searchPaths) {
+        if (resourceManager->resourceExists(path)) {
+            manifest.add(AssetType::Texture, tilesetId, path);
+            return;
         }
     }
-    return json();
+
+    std::cerr << "Failed to load tileset texture: " << relPath << std::endl;
 }
 
-std::vector<LevelLoader::TileInfo> LevelLoader::decodeTiles(const json& layerData, int gridSize) {
-    std::vector<TileInfo> result;
+void LevelLoader::addTileMeshes(Level* level, const AssetManifest& manifest, std::vector<std::unique_ptr<TileLayerMesh>>& meshes, const std::vector<std::string>& tilesetIds) {
+    RessourceManager* resourceManager = RessourceManager::getInstance();
+    resourceManager->finishPendingLoads();
 
-    if (layerData.contains("gridTiles")) {
-        for (const auto& tile : layerData["gridTiles"]) {
-            TileInfo info;
-            info.tileId = tile["t"];
+    // The level holds the references: its tilesets stay resident until the
+    // next level replaces them, then fall back to the LRU cache.
+    level->setAssets(resourceManager->acquire(manifest));
 
-            info.x = tile["px"][0];
-            info.y = tile["px"][1];
+    for (std::size_t i = 0; i < meshes.size(); ++i) {
+        sf::Texture* texture = level->getAssets().findTexture(ResourceId(tilesetIds[i]));
+        if (!texture) continue;
 
-            info.flipped = false;
-            info.rotated = false;
-            if (tile.contains("f")) {
-                int f = tile["f"];
-                info.flipped = (f == 1 || f == 3);
-                info.flipY = (f == 2 || f == 3);
-            }
+        TileLayerMesh& mesh = *meshes[i];
+        mesh.setTexture(texture);
+        mesh.uploadChunks(mesh.getChunkCount());
 
-            result.push_back(info);
-        }
-    }
-    else if (layerData.contains("autoLayerTiles")) {
-        for (const auto& tile : layerData["autoLayerTiles"]) {
-            TileInfo info;
-            info.tileId = tile["t"];
-            info.x = tile["px"][0];
-            info.y = tile["px"][1];
-            info.flipped = false;
-            info.rotated = false;
+        std::cout << "Added tile layer: " << mesh.getName() << " (" << mesh.getTileCount() << " tiles, "
+            << mesh.getAnimatedTileCount() << " animated, "
+            << mesh.getMemoryUsage() / 1024 << " KB)" << std::endl;
 
-            result.push_back(info);
-        }
+        level->addTileMesh(std::move(meshes[i]));
     }
+}
 
-    return result;
+bool LevelLoader::addLevelLight(Level* level, const std::string& type, int x, int y, int width, int height) {
+    if (type != "Torch" && type != "Light") return false;
+
+    TileLightMap* lighting = level->getLighting();
+    lighting->addLight(sf::Vector2f(x + width / 2.0f, y + height / 2.0f), TileLightMap::MaxLevel);
+    lighting->setEnabled(true);
+    return true;
 }
 
-json LevelLoader::getCurrentLevel(const json& project) {
-    if (project.contains("levels") && !project["levels"].empty()) {
-        return project["levels"][0];
-    }
+bool LevelLoader::addLevelPickup(Level* level, const std::string& type, int x, int y) {
+    sf::Vector2f position(static_cast<float>(x), static_cast<float>(y));
 
-    return json();
+    if (type == "Coin" || type == "Bitcoin") {
+        level->getPickups()->add("Bitcoin", position);
+    }
+    else if (type == "Health") {
+        level->getPickups()->add("health", position);
+    }
+    else {
+        return false;
+    }
+    return true;
 }
 
-Entity* LevelLoader::createEntityByType(const std::string& type, const json& entityData) {
+Entity* LevelLoader::createEntityByType(const std::string& type, int width, int height) {
     Entity* entity = nullptr;
 
     if (type == "Player" || type == "PlayerStart") 
     {
         return nullptr;
     }
-    else if (type == "Coin" || type == "Bitcoin") {
-        entity = new Pickup("Bitcoin", 1);
-    }
-    else if (type == "Health") {
-        entity = new Pickup("health", 20);
-    }
     else if (type == "Checkpoint") {
         entity = new Checkpoint();
     }
@@ -377,8 +439,6 @@ Entity* LevelLoader::createEntityByType(const std::string& type, const json& ent
     }
 
     if (entity) {
-        int width = entityData.value("width", 16);
-        int height = entityData.value("height", 16);
         entity->setSize(sf::Vector2f(width, height));
     }
 
@@ -386,22 +446,16 @@ Entity* LevelLoader::createEntityByType(const std::string& type, const json& ent
 }
 
 void LevelLoader::createDefaultEntities(Level* level) {
+    PickupField* pickups = level->getPickups();
     for (int i = 0; i < 10; i++) {
         float x = 200 + i * 180;
         float y = 350;
 
-        Pickup* bitcoin = new Pickup("Bitcoin", 1);
-        bitcoin->setPosition(x, y);
-        level->addEntity(bitcoin);
+        pickups->add("Bitcoin", 1, sf::Vector2f(x, y));
     }
 
-    Pickup* health1 = new Pickup("health", 20);
-    health1->setPosition(800, 300);
-    level->addEntity(health1);
-
-    Pickup* health2 = new Pickup("health", 20);
-    health2->setPosition(1500, 300);
-    level->addEntity(health2);
+    pickups->add("health", 20, sf::Vector2f(800, 300));
+    pickups->add("health", 20, sf::Vector2f(1500, 300));
 
     Checkpoint* checkpoint1 = new Checkpoint();
     checkpoint1->setPosition(700, 400);
@@ -0,0 +1,351 @@
+#include "PickupField.h"
+#include "Player.h"
+#include "SpriteBatch.h"
+#include "RessourceManager.h"
+#include "EventSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+PickupField::PickupField()
+    : m_remaining(0),
+    m_gridOrigin(0, 0),
+    m_columns(0),
+    m_rows(0),
+    m_gridDirty(false),
+    m_maxHalfSize(0.0f, 0.0f),
+    m_time(0.0f),
+    m_bobHeight(5.0f),
+    m_bobSpeed(3.0f),
+    m_spinSpeed(40.0f),
+    m_lastTested(0),
+    m_lastDrawn(0)
+{
+}
+
+void PickupField::add(const std::string& type, int value, const sf::Vector2f& position) {
+    int kind = findKind(type);
+    if (kind < 0) return;
+
+    // Neighbouring pickups bob slightly out of step.
+    float phase = position.x * 0.02f + position.y * 0.01f;
+
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_phaseSin.push_back(std::sin(phase));
+    m_phaseCos.push_back(std::cos(phase));
+    m_bobOffset.push_back(0.0f);
+    m_kind.push_back(static_cast<std::uint8_t>(kind));
+    m_collected.push_back(0);
+    m_value.push_back(value);
+    m_remaining++;
+
+    m_gridDirty = true;
+}
+
+void PickupField::add(const std::string& type, const sf::Vector2f& position) {
+    int kind = findKind(type);
+    if (kind < 0) return;
+
+    add(type, m_kinds[kind].defaultValue, position);
+}
+
+void PickupField::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_phaseSin.clear();
+    m_phaseCos.clear();
+    m_bobOffset.clear();
+    m_kind.clear();
+    m_collected.clear();
+    m_value.clear();
+    m_remaining = 0;
+
+    m_cellStart.clear();
+    m_cellPickups.clear();
+    m_columns = 0;
+    m_rows = 0;
+    m_gridDirty = false;
+}
+
+void PickupField::setBob(float height, float speed) {
+    m_bobHeight = height;
+    m_bobSpeed = speed;
+}
+
+int PickupField::findKind(const std::string& type) {
+    for (std::size_t i = 0; i < m_kinds.size(); ++i) {
+        if (m_kinds[i].type == type) {
+            return static_cast<int>(i);
+        }
+    }
+    if (m_kinds.size() > 255) {
+        std::cerr << "Too many pickup types, ignoring " << type << std::endl;
+        return -1;
+    }
+
+    Kind kind;
+    kind.type = type;
+    kind.texture = nullptr;
+    kind.halfSize = sf::Vector2f(8.0f, 8.0f);
+    kind.color = sf::Color::White;
+    kind.defaultValue = 1;
+
+    if (type == "Bitcoin") {
+        kind.color = sf::Color::Yellow;
+    }
+    else if (type == "health") {
+        kind.color = sf::Color::Red;
+        kind.defaultValue = 20;
+    }
+    else if (type == "key") {
+        kind.color = sf::Color(200, 200, 255);
+    }
+
+    // Same texture and 0.05 scale as the Pickup entity.
+    RessourceManager* resourceManager = RessourceManager::getInstance();
+    std::string textureKey = "pickup_" + type;
+    AtlasRegion region = resourceManager->loadAtlasRegion(textureKey, textureKey + ".png");
+    if (region.isValid()) {
+        kind.texture = region.texture;
+        kind.textureRect = region.rect;
+    }
+    else if (resourceManager->loadTexture(textureKey, textureKey + ".png")) {
+        kind.texture = resourceManager->getTexture(ResourceId(textureKey));
+        kind.textureRect = sf::IntRect(0, 0, kind.texture->getSize().x, kind.texture->getSize().y);
+    }
+    if (kind.texture) {
+        kind.halfSize = sf::Vector2f(kind.textureRect.width * 0.025f, kind.textureRect.height * 0.025f);
+        kind.color = sf::Color::White;
+    }
+
+    m_maxHalfSize.x = std::max(m_maxHalfSize.x, kind.halfSize.x);
+    m_maxHalfSize.y = std::max(m_maxHalfSize.y, kind.halfSize.y);
+    m_kinds.push_back(kind);
+    return static_cast<int>(m_kinds.size()) - 1;
+}
+
+void PickupField::update(float dt, Player* player) {
+    m_time += dt;
+    m_lastTested = 0;
+    if (m_x.size() - m_remaining >= CompactThreshold) {
+        compact();
+    }
+    if (m_gridDirty) {
+        rebuildGrid();
+    }
+
+    float angle = m_time * m_bobSpeed;
+    float bobSin = std::sin(angle) * m_bobHeight;
+    float bobCos = std::cos(angle) * m_bobHeight;
+
+    const float* phaseSin = m_phaseSin.data();
+    const float* phaseCos = m_phaseCos.data();
+    float* offset = m_bobOffset.data();
+    std::size_t count = m_bobOffset.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        offset[i] = bobSin * phaseCos[i] + bobCos * phaseSin[i];
+    }
+
+    if (!player || !player->isActive() || m_remaining == 0) return;
+
+    sf::FloatRect bounds = player->getBounds();
+    sf::FloatRect area(bounds.left - m_maxHalfSize.x, bounds.top - m_maxHalfSize.y - m_bobHeight,
+        bounds.width + m_maxHalfSize.x * 2, bounds.height + (m_maxHalfSize.y + m_bobHeight) * 2);
+
+    sf::IntRect cells = getCellRange(area);
+    for (int y = cells.top; y < cells.top + cells.height; ++y) {
+        for (int x = cells.left; x < cells.left + cells.width; ++x) {
+            int cell = y * m_columns + x;
+            for (int c = m_cellStart[cell]; c < m_cellStart[cell + 1]; ++c) {
+                int i = m_cellPickups[c];
+                if (m_collected[i]) continue;
+
+                m_lastTested++;
+                const sf::Vector2f& halfSize = m_kinds[m_kind[i]].halfSize;
+                sf::FloatRect pickup(m_x[i] - halfSize.x, m_y[i] + m_bobOffset[i] - halfSize.y, halfSize.x * 2, halfSize.y * 2);
+                if (pickup.intersects(bounds)) {
+                    collect(i, player);
+                }
+            }
+        }
+    }
+}
+
+void PickupField::collect(int index, Player* player) {
+    m_collected[index] = 1;
+    m_remaining--;
+
+    const std::string& type = m_kinds[m_kind[index]].type;
+    int value = m_value[index];
+
+    if (type == "Bitcoin") {
+        player->addCoins(value);
+        player->addScore(100 * value);
+        player->playSound("coin_pickup", 1.0f);
+    }
+    else if (type == "health") {
+        player->heal(value);
+        player->playSound("health_pickup", 1.0f);
+    }
+
+    EventSystem::getInstance()->triggerEvent("PickupCollected", {
+        {"type", type},
+        {"value", value},
+        {"position", sf::Vector2f(m_x[index], m_y[index])}
+        });
+}
+
+void PickupField::compact() {
+    // Swap-remove: order does not matter, the grid is rebuilt afterwards.
+    std::size_t count = m_x.size();
+    for (std::size_t i = 0; i < count;) {
+        if (!m_collected[i]) {
+            ++i;
+            continue;
+        }
+
+        --count;
+        m_x[i] = m_x[count];
+        m_y[i] = m_y[count];
+        m_phaseSin[i] = m_phaseSin[count];
+        m_phaseCos[i] = m_phaseCos[count];
+        m_bobOffset[i] = m_bobOffset[count];
+        m_kind[i] = m_kind[count];
+        m_collected[i] = m_collected[count];
+        m_value[i] = m_value[count];
+    }
+
+    m_x.resize(count);
+    m_y.resize(count);
+    m_phaseSin.resize(count);
+    m_phaseCos.resize(count);
+    m_bobOffset.resize(count);
+    m_kind.resize(count);
+    m_collected.resize(count);
+    m_value.resize(count);
+
+    m_gridDirty = true;
+}
+
+void PickupField::render(SpriteBatch& batch, const sf::FloatRect& viewArea) {
+    m_lastDrawn = 0;
+    if (m_remaining == 0 || m_columns == 0) return;
+
+    // Every pickup spins by the same angle, so the rotated corners are
+    // computed once per kind rather than once per pickup.
+    float radians = m_time * m_spinSpeed * 3.14159265f / 180.0f;
+    float cosAngle = std::cos(radians);
+    float sinAngle = std::sin(radians);
+
+    struct KindQuad {
+        sf::Vector2f corners[4];
+        sf::Vector2f texCoords[4];
+    };
+    std::vector<KindQuad> quads(m_kinds.size());
+    for (std::size_t k = 0; k < m_kinds.size(); ++k) {
+        const Kind& kind = m_kinds[k];
+        const sf::Vector2f local[4] = {
+            sf::Vector2f(-kind.halfSize.x, -kind.halfSize.y),
+            sf::Vector2f(kind.halfSize.x, -kind.halfSize.y),
+            sf::Vector2f(kind.halfSize.x, kind.halfSize.y),
+            sf::Vector2f(-kind.halfSize.x, kind.halfSize.y)
+        };
+        float left = static_cast<float>(kind.textureRect.left);
+        float top = static_cast<float>(kind.textureRect.top);
+        float right = left + kind.textureRect.width;
+        float bottom = top + kind.textureRect.height;
+        const sf::Vector2f texCoords[4] = {
+            sf::Vector2f(left, top), sf::Vector2f(right, top),
+            sf::Vector2f(right, bottom), sf::Vector2f(left, bottom)
+        };
+        for (int c = 0; c < 4; ++c) {
+            quads[k].corners[c] = sf::Vector2f(local[c].x * cosAngle - local[c].y * sinAngle,
+                local[c].x * sinAngle + local[c].y * cosAngle);
+            quads[k].texCoords[c] = texCoords[c];
+        }
+    }
+
+    float margin = std::max(m_maxHalfSize.x, m_maxHalfSize.y) * 1.5f + m_bobHeight;
+    sf::FloatRect area(viewArea.left - margin, viewArea.top - margin, viewArea.width + margin * 2, viewArea.height + margin * 2);
+
+    sf::Vertex quad[4];
+    sf::IntRect cells = getCellRange(area);
+    for (int y = cells.top; y < cells.top + cells.height; ++y) {
+        for (int x = cells.left; x < cells.left + cells.width; ++x) {
+            int cell = y * m_columns + x;
+            for (int c = m_cellStart[cell]; c < m_cellStart[cell + 1]; ++c) {
+                int i = m_cellPickups[c];
+                if (m_collected[i]) continue;
+
+                const Kind& kind = m_kinds[m_kind[i]];
+                const KindQuad& kindQuad = quads[m_kind[i]];
+                sf::Vector2f center(m_x[i], m_y[i] + m_bobOffset[i]);
+                for (int v = 0; v < 4; ++v) {
+                    quad[v] = sf::Vertex(center + kindQuad.corners[v], kind.color, kindQuad.texCoords[v]);
+                }
+                batch.drawQuad(quad, kind.texture);
+                m_lastDrawn++;
+            }
+        }
+    }
+}
+
+void PickupField::rebuildGrid() {
+    m_gridDirty = false;
+    m_cellStart.clear();
+    m_cellPickups.clear();
+    m_columns = 0;
+    m_rows = 0;
+    if (m_x.empty()) return;
+
+    auto xRange = std::minmax_element(m_x.begin(), m_x.end());
+    auto yRange = std::minmax_element(m_y.begin(), m_y.end());
+    m_gridOrigin = sf::Vector2i(static_cast<int>(std::floor(*xRange.first / CellSize)),
+        static_cast<int>(std::floor(*yRange.first / CellSize)));
+    m_columns = static_cast<int>(std::floor(*xRange.second / CellSize)) - m_gridOrigin.x + 1;
+    m_rows = static_cast<int>(std::floor(*yRange.second / CellSize)) - m_gridOrigin.y + 1;
+
+    // Counting sort of the pickups by cell.
+    std::vector<int> cellOf(m_x.size());
+    m_cellStart.assign(static_cast<std::size_t>(m_columns) * m_rows + 1, 0);
+    for (std::size_t i = 0; i < m_x.size(); ++i) {
+        int x = static_cast<int>(std::floor(m_x[i] / CellSize)) - m_gridOrigin.x;
+        int y = static_cast<int>(std::floor(m_y[i] / CellSize)) - m_gridOrigin.y;
+        cellOf[i] = y * m_columns + x;
+        m_cellStart[cellOf[i] + 1]++;
+    }
+    for (std::size_t i = 1; i < m_cellStart.size(); ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    m_cellPickups.resize(m_x.size());
+    std::vector<int> next(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (std::size_t i = 0; i < m_x.size(); ++i) {
+        m_cellPickups[next[cellOf[i]]++] = static_cast<int>(i);
+    }
+}
+
+sf::IntRect PickupField::getCellRange(const sf::FloatRect& area) const {
+    int firstX = std::max(0, static_cast<int>(std::floor(area.left / CellSize)) - m_gridOrigin.x);
+    int firstY = std::max(0, static_cast<int>(std::floor(area.top / CellSize)) - m_gridOrigin.y);
+    int lastX = std::min(m_columns - 1, static_cast<int>(std::floor((area.left + area.width) / CellSize)) - m_gridOrigin.x);
+    int lastY = std::min(m_rows - 1, static_cast<int>(std::floor((area.top + area.height) / CellSize)) - m_gridOrigin.y);
+    return sf::IntRect(firstX, firstY, lastX - firstX + 1, lastY - firstY + 1);
+}
+
+std::size_t PickupField::getCount() const {
+    return m_x.size();
+}
+
+std::size_t PickupField::getRemainingCount() const {
+    return m_remaining;
+}
+
+std::size_t PickupField::getLastTestedCount() const {
+    return m_lastTested;
+}
+
+std::size_t PickupField::getLastDrawnCount() const {
+    return m_lastDrawn;
+}
@@ -0,0 +1,114 @@
+#include "TileAnimationSet.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+
+int TileAnimation::getFrame(float time) const {
+    long long index = static_cast<long long>(time / frameDuration);
+    return frames[static_cast<std::size_t>(index % static_cast<long long>(frames.size()))];
+}
+
+TileAnimationSet* TileAnimationSet::s_instance = nullptr;
+
+TileAnimationSet::TileAnimationSet()
+    : m_time(0.0f),
+    m_step(0)
+{
+}
+
+TileAnimationSet* TileAnimationSet::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new TileAnimationSet();
+    }
+    return s_instance;
+}
+
+void TileAnimationSet::cleanup() {
+    if (s_instance != nullptr) {
+        delete s_instance;
+        s_instance = nullptr;
+    }
+}
+
+bool TileAnimationSet::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Could not open tile animations: " << filename << std::endl;
+        return false;
+    }
+
+    try {
+        nlohmann::json root = nlohmann::json::parse(file);
+
+        int count = 0;
+        for (auto tileset = root.begin(); tileset != root.end(); ++tileset) {
+            for (const auto& entry : tileset.value()) {
+                if (addAnimation(tileset.key(), entry.at("tileId").get<int>(),
+                    entry.at("frames").get<std::vector<int>>(), entry.value("duration", 0.1f))) {
+                    count++;
+                }
+            }
+        }
+
+        std::cout << "Loaded " << count << " tile animations from " << filename << std::endl;
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error loading tile animations " << filename << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool TileAnimationSet::addAnimation(const std::string& tilesetId, int tileId, const std::vector<int>& frames, float frameDuration) {
+    if (tileId < 0 || frames.empty() || frameDuration <= 0.0f) {
+        std::cerr << "Invalid animation for tile " << tileId << " of tileset " << tilesetId << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TileAnimation& animation = m_tilesets[tilesetId][tileId];
+    animation.frames = frames;
+    animation.frameDuration = frameDuration;
+    return true;
+}
+
+const TilesetAnimations* TileAnimationSet::find(const std::string& tilesetId) const {
+    auto it = m_tilesets.find(tilesetId);
+    return it != m_tilesets.end() ? &it->second : nullptr;
+}
+
+std::unique_lock<std::mutex> TileAnimationSet::lock() const {
+    return std::unique_lock<std::mutex>(m_mutex);
+}
+
+std::size_t TileAnimationSet::getAnimationCount() const {
+    std::size_t count = 0;
+    for (const auto& tileset : m_tilesets) {
+        count += tileset.second.size();
+    }
+    return count;
+}
+
+void TileAnimationSet::update(float dt) {
+    float previous = m_time;
+    m_time += dt;
+
+    for (const auto& tileset : m_tilesets) {
+        for (const auto& entry : tileset.second) {
+            const TileAnimation& animation = entry.second;
+            if (static_cast<long long>(previous / animation.frameDuration) !=
+                static_cast<long long>(m_time / animation.frameDuration)) {
+                m_step++;
+                return;
+            }
+        }
+    }
+}
+
+float TileAnimationSet::getTime() const {
+    return m_time;
+}
+
+unsigned int TileAnimationSet::getStep() const {
+    return m_step;
+}
@@ -0,0 +1,172 @@
+#include "TileColliderSet.h"
+#include "Tilemap.h"
+#include "Collider.h"
+#include "CollisionManager.h"
+#include "BitUtils.h"
+#include <algorithm>
+
+namespace {
+    // Word-level helpers over one row of a band's working copy of the bitset.
+    bool isSpanSet(const std::uint64_t* row, int firstX, int lastX) {
+        for (int w = firstX >> 6; w <= (lastX >> 6); ++w) {
+            std::uint64_t mask = BitUtils::rangeMask(w == (firstX >> 6) ? (firstX & 63) : 0, w == (lastX >> 6) ? (lastX & 63) : 63);
+            if ((row[w] & mask) != mask) return false;
+        }
+        return true;
+    }
+
+    void clearSpan(std::uint64_t* row, int firstX, int lastX) {
+        for (int w = firstX >> 6; w <= (lastX >> 6); ++w) {
+            row[w] &= ~BitUtils::rangeMask(w == (firstX >> 6) ? (firstX & 63) : 0, w == (lastX >> 6) ? (lastX & 63) : 63);
+        }
+    }
+
+    // Last set bit of the run that starts at x.
+    int findRunEnd(const std::uint64_t* row, int wordsPerRow, int x) {
+        int w = x >> 6;
+        std::uint64_t gaps = ~row[w] & (~0ull << (x & 63));
+        while (gaps == 0 && w + 1 < wordsPerRow) {
+            gaps = ~row[++w];
+        }
+        if (gaps == 0) {
+            return wordsPerRow * 64 - 1;
+        }
+        return w * 64 + BitUtils::countTrailingZeros(gaps) - 1;
+    }
+}
+
+TileColliderSet::TileColliderSet()
+    : m_tilemap(nullptr),
+    m_colliderCount(0)
+{
+}
+
+TileColliderSet::~TileColliderSet() {
+    clear();
+}
+
+void TileColliderSet::build(Tilemap* tilemap) {
+    clear();
+    m_tilemap = tilemap;
+    if (!m_tilemap) return;
+
+    m_tilemap->setCollisionListener([this](int firstRow, int lastRow) {
+        markRowsDirty(firstRow, lastRow);
+        });
+
+    markRowsDirty(0, m_tilemap->getHeight() - 1);
+    update();
+}
+
+void TileColliderSet::clear() {
+    for (Band& band : m_bands) {
+        releaseBand(band);
+    }
+    m_bands.clear();
+    m_colliderCount = 0;
+
+    if (m_tilemap) {
+        m_tilemap->setCollisionListener(nullptr);
+        m_tilemap = nullptr;
+    }
+}
+
+void TileColliderSet::markRowsDirty(int firstRow, int lastRow) {
+    if (!m_tilemap) return;
+
+    // A resize can change the band count; bands past the new end go away.
+    int bandCount = (m_tilemap->getHeight() + BandHeight - 1) / BandHeight;
+    while (static_cast<int>(m_bands.size()) > bandCount) {
+        releaseBand(m_bands.back());
+        m_bands.pop_back();
+    }
+    m_bands.resize(bandCount);
+
+    int firstBand = std::max(0, firstRow / BandHeight);
+    int lastBand = std::min(bandCount - 1, lastRow / BandHeight);
+    for (int i = firstBand; i <= lastBand; ++i) {
+        m_bands[i].dirty = true;
+    }
+}
+
+void TileColliderSet::update() {
+    for (int i = 0; i < static_cast<int>(m_bands.size()); ++i) {
+        if (m_bands[i].dirty) {
+            rebuildBand(i);
+        }
+    }
+}
+
+std::size_t TileColliderSet::getColliderCount() const {
+    return m_colliderCount;
+}
+
+void TileColliderSet::rebuildBand(int index) {
+    Band& band = m_bands[index];
+    releaseBand(band);
+    band.dirty = false;
+
+    int firstRow = index * BandHeight;
+    int lastRow = std::min(m_tilemap->getHeight(), firstRow + BandHeight) - 1;
+
+    float tileWidth = static_cast<float>(m_tilemap->getTileWidth());
+    float tileHeight = static_cast<float>(m_tilemap->getTileHeight());
+
+    for (const sf::IntRect& rect : mergeRows(*m_tilemap, firstRow, lastRow)) {
+        // BoxCollider is centred on its offset when it has no owner.
+        sf::Vector2f size(rect.width * tileWidth, rect.height * tileHeight);
+        sf::Vector2f center(rect.left * tileWidth + size.x / 2.f, rect.top * tileHeight + size.y / 2.f);
+
+        auto collider = std::make_unique<BoxCollider>(nullptr, size, center);
+        collider->setCollisionLayer(static_cast<int>(CollisionLayer::Platform));
+        collider->setTag("terrain");
+        CollisionManager::getInstance()->registerStaticCollider(collider.get());
+        band.colliders.push_back(std::move(collider));
+    }
+    m_colliderCount += band.colliders.size();
+}
+
+void TileColliderSet::releaseBand(Band& band) {
+    for (auto& collider : band.colliders) {
+        CollisionManager::getInstance()->unregisterStaticCollider(collider.get());
+    }
+    m_colliderCount -= band.colliders.size();
+    band.colliders.clear();
+}
+
+std::vector<sf::IntRect> TileColliderSet::mergeRows(const Tilemap& tilemap, int firstRow, int lastRow) {
+    std::vector<sf::IntRect> rects;
+
+    int wordsPerRow = tilemap.getCollisionWordsPerRow();
+    int rows = lastRow - firstRow + 1;
+    if (wordsPerRow <= 0 || rows <= 0) return rects;
+
+    // Working copy; bits are cleared as rectangles claim them.
+    std::vector<std::uint64_t> bits(static_cast<std::size_t>(rows) * wordsPerRow);
+    for (int r = 0; r < rows; ++r) {
+        const std::uint64_t* source = tilemap.getCollisionRow(firstRow + r);
+        std::copy(source, source + wordsPerRow, bits.begin() + static_cast<std::size_t>(r) * wordsPerRow);
+    }
+
+    for (int r = 0; r < rows; ++r) {
+        std::uint64_t* row = &bits[static_cast<std::size_t>(r) * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; ++w) {
+            while (row[w]) {
+                int startX = w * 64 + BitUtils::countTrailingZeros(row[w]);
+                int endX = findRunEnd(row, wordsPerRow, startX);
+
+                int endRow = r;
+                while (endRow + 1 < rows && isSpanSet(&bits[static_cast<std::size_t>(endRow + 1) * wordsPerRow], startX, endX)) {
+                    ++endRow;
+                }
+                for (int clearRow = r; clearRow <= endRow; ++clearRow) {
+                    clearSpan(&bits[static_cast<std::size_t>(clearRow) * wordsPerRow], startX, endX);
+                }
+
+                rects.emplace_back(startX, firstRow + r, endX - startX + 1, endRow - r + 1);
+            }
+        }
+    }
+
+    return rects;
+}
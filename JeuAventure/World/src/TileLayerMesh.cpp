@@ -0,0 +1,550 @@
+#include "TileLayerMesh.h"
+#include "TileIndexMap.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+bool TileLayerMesh::s_shaderRenderingEnabled = true;
+
+TileLayerMesh::TileLayerMesh(const std::string& name, const sf::Texture* texture, int tilesetTileSize, int tilesetColumns)
+    : m_name(name),
+    m_texture(texture),
+    m_tilesetTileSize(tilesetTileSize),
+    m_tilesetColumns(tilesetColumns),
+    m_gridSize(tilesetTileSize),
+    m_offset(0.0f, 0.0f),
+    m_color(sf::Color::White),
+    m_chunksX(0),
+    m_chunksY(0),
+    m_useVertexBuffers(false),
+    m_uploadCursor(0),
+    m_widthInTiles(0),
+    m_heightInTiles(0),
+    m_indexedTileCount(0),
+    m_useShader(false),
+    m_animations(nullptr),
+    m_animatedTileCount(0),
+    m_tileCount(0),
+    m_lastDrawCalls(0)
+{
+}
+
+void TileLayerMesh::build(const std::vector<LayerTile>& tiles, int gridSize, int widthInTiles, int heightInTiles) {
+    buildVertices(tiles, gridSize, widthInTiles, heightInTiles);
+    uploadChunks(m_chunks.size());
+}
+
+void TileLayerMesh::buildVertices(const std::vector<LayerTile>& tiles, int gridSize, int widthInTiles, int heightInTiles) {
+    m_gridSize = gridSize;
+    m_chunksX = (widthInTiles + ChunkSize - 1) / ChunkSize;
+    m_chunksY = (heightInTiles + ChunkSize - 1) / ChunkSize;
+    m_widthInTiles = widthInTiles;
+    m_heightInTiles = heightInTiles;
+    m_tileCount = 0;
+    m_indexedTileCount = 0;
+    m_animatedTileCount = 0;
+    m_uploadCursor = 0;
+    m_useShader = false;
+
+    m_chunks.clear();
+    m_chunks.resize(static_cast<std::size_t>(m_chunksX) * m_chunksY);
+
+    float chunkPixels = static_cast<float>(ChunkSize * m_gridSize);
+    for (int cy = 0; cy < m_chunksY; ++cy) {
+        for (int cx = 0; cx < m_chunksX; ++cx) {
+            m_chunks[cy * m_chunksX + cx].bounds = sf::FloatRect(
+                m_offset.x + cx * chunkPixels, m_offset.y + cy * chunkPixels, chunkPixels, chunkPixels);
+        }
+    }
+
+    m_indexPixels.clear();
+    if (m_chunks.empty() || m_tilesetColumns <= 0) return;
+
+    // The first grid-aligned tile of each cell goes into the index; whether
+    // it ends up drawn by the shader or as vertices is decided at upload.
+    m_indexPixels.assign(static_cast<std::size_t>(widthInTiles) * heightInTiles * 4, 0);
+
+    for (const auto& tile : tiles) {
+        int cx = (tile.x / m_gridSize) / ChunkSize;
+        int cy = (tile.y / m_gridSize) / ChunkSize;
+        if (tile.tileId < 0 || cx < 0 || cy < 0 || cx >= m_chunksX || cy >= m_chunksY) continue;
+
+        m_tileCount++;
+        Chunk& chunk = m_chunks[cy * m_chunksX + cx];
+
+        if (m_animations) {
+            auto animation = m_animations->find(tile.tileId);
+            if (animation != m_animations->end()) {
+                chunk.animatedSlots.push_back({ static_cast<std::uint32_t>(chunk.vertices.size()),
+                    &animation->second, tile.tileId, tile.tileId, tile.flipX, tile.flipY });
+                appendTile(chunk, tile);
+                m_animatedTileCount++;
+                continue;
+            }
+        }
+
+        int tileX = tile.x / m_gridSize;
+        int tileY = tile.y / m_gridSize;
+        if (tile.x % m_gridSize == 0 && tile.y % m_gridSize == 0 && tileX < widthInTiles && tileY < heightInTiles) {
+            std::uint8_t* texel = &m_indexPixels[(static_cast<std::size_t>(tileY) * widthInTiles + tileX) * 4];
+            if (texel[3] == 0 && TileIndexMap::encode(tile.tileId, tile.flipX, tile.flipY, texel)) {
+                m_indexedTileCount++;
+                continue;
+            }
+        }
+
+        appendTile(chunk, tile);
+    }
+}
+
+std::size_t TileLayerMesh::uploadChunks(std::size_t maxChunks) {
+    if (m_uploadCursor == 0) {
+        m_useVertexBuffers = sf::VertexBuffer::isAvailable();
+
+        m_useShader = false;
+        if (m_indexedTileCount > 0 && s_shaderRenderingEnabled && m_texture && sf::Shader::isAvailable()) {
+            unsigned int maxSize = sf::Texture::getMaximumSize();
+            if (static_cast<unsigned int>(m_widthInTiles) <= maxSize && static_cast<unsigned int>(m_heightInTiles) <= maxSize &&
+                getIndexShader() && m_indexTexture.create(m_widthInTiles, m_heightInTiles)) {
+                m_indexTexture.update(m_indexPixels.data());
+                m_indexTexture.setSmooth(false);
+                m_useShader = true;
+            }
+        }
+    }
+
+    std::size_t uploaded = 0;
+    while (m_uploadCursor < m_chunks.size() && uploaded < maxChunks) {
+        std::size_t chunkIndex = m_uploadCursor++;
+        if (!m_useShader) {
+            appendIndexedTiles(chunkIndex);
+        }
+
+        Chunk& chunk = m_chunks[chunkIndex];
+        if (!m_useVertexBuffers || chunk.vertices.empty()) continue;
+
+        chunk.buffer.create(chunk.vertices.size());
+        chunk.buffer.update(chunk.vertices.data());
+        chunk.uploaded = true;
+        uploaded++;
+    }
+
+    // The shader path keeps the CPU copy of the index for setTile().
+    if (isUploaded() && !m_useShader) {
+        std::vector<std::uint8_t>().swap(m_indexPixels);
+    }
+    return uploaded;
+}
+
+void TileLayerMesh::appendIndexedTiles(std::size_t chunkIndex) {
+    if (m_indexPixels.empty()) return;
+
+    Chunk& chunk = m_chunks[chunkIndex];
+    int firstX = static_cast<int>(chunkIndex % m_chunksX) * ChunkSize;
+    int firstY = static_cast<int>(chunkIndex / m_chunksX) * ChunkSize;
+    int lastX = std::min(firstX + ChunkSize, m_widthInTiles);
+    int lastY = std::min(firstY + ChunkSize, m_heightInTiles);
+
+    // Indexed tiles sit under the ones that overflowed into the chunk.
+    std::vector<sf::Vertex> overflow;
+    overflow.swap(chunk.vertices);
+
+    for (int y = firstY; y < lastY; ++y) {
+        for (int x = firstX; x < lastX; ++x) {
+            LayerTile tile;
+            const std::uint8_t* texel = &m_indexPixels[(static_cast<std::size_t>(y) * m_widthInTiles + x) * 4];
+            if (!TileIndexMap::decode(texel, tile.tileId, tile.flipX, tile.flipY)) continue;
+
+            tile.x = x * m_gridSize;
+            tile.y = y * m_gridSize;
+            appendTile(chunk, tile);
+        }
+    }
+
+    for (auto& slot : chunk.animatedSlots) {
+        slot.vertex += static_cast<std::uint32_t>(chunk.vertices.size());
+    }
+    chunk.vertices.insert(chunk.vertices.end(), overflow.begin(), overflow.end());
+}
+
+sf::Shader* TileLayerMesh::getIndexShader() {
+    static std::unique_ptr<sf::Shader> shader;
+    static bool attempted = false;
+
+    if (!attempted) {
+        attempted = true;
+        shader = std::make_unique<sf::Shader>();
+        if (!shader->loadFromMemory(TileIndexMap::FragmentShader, sf::Shader::Fragment)) {
+            std::cerr << "Failed to compile tile index shader, using tile meshes" << std::endl;
+            shader.reset();
+        }
+    }
+    return shader.get();
+}
+
+bool TileLayerMesh::isUploaded() const {
+    return m_uploadCursor >= m_chunks.size();
+}
+
+bool TileLayerMesh::setTile(int cellX, int cellY, int tileId, bool flipX, bool flipY) {
+    if (!isUploaded() || m_tilesetColumns <= 0 ||
+        cellX < 0 || cellY < 0 || cellX >= m_widthInTiles || cellY >= m_heightInTiles) {
+        return false;
+    }
+
+    Chunk& chunk = m_chunks[(cellY / ChunkSize) * m_chunksX + cellX / ChunkSize];
+    std::size_t removed = removeChunkTiles(chunk, cellX, cellY);
+    m_tileCount -= removed;
+
+    std::uint8_t* texel = nullptr;
+    if (m_useShader) {
+        texel = &m_indexPixels[(static_cast<std::size_t>(cellY) * m_widthInTiles + cellX) * 4];
+        if (texel[3] != 0) {
+            texel[0] = texel[1] = texel[2] = texel[3] = 0;
+            m_indexedTileCount--;
+            m_tileCount--;
+        }
+    }
+
+    chunk.edited = chunk.edited || removed > 0;
+    if (tileId >= 0) {
+        LayerTile tile = { tileId, cellX * m_gridSize, cellY * m_gridSize, flipX, flipY };
+        auto animation = m_animations ? m_animations->find(tileId) : TilesetAnimations::const_iterator();
+
+        if (m_animations && animation != m_animations->end()) {
+            chunk.animatedSlots.push_back({ static_cast<std::uint32_t>(chunk.vertices.size()),
+                &animation->second, tileId, tileId, flipX, flipY });
+            chunk.animationStep = ~0u;
+            m_animatedTileCount++;
+            appendTile(chunk, tile);
+            chunk.edited = true;
+        }
+        else if (texel && TileIndexMap::encode(tileId, flipX, flipY, texel)) {
+            m_indexedTileCount++;
+        }
+        else {
+            appendTile(chunk, tile);
+            chunk.edited = true;
+        }
+        m_tileCount++;
+    }
+
+    if (texel) {
+        m_indexTexture.update(texel, 1, 1, cellX, cellY);
+    }
+    return true;
+}
+
+int TileLayerMesh::getTile(int cellX, int cellY) const {
+    if (m_tilesetColumns <= 0 || cellX < 0 || cellY < 0 || cellX >= m_widthInTiles || cellY >= m_heightInTiles) {
+        return -1;
+    }
+
+    std::size_t chunkIndex = static_cast<std::size_t>(cellY / ChunkSize) * m_chunksX + cellX / ChunkSize;
+    const Chunk& chunk = m_chunks[chunkIndex];
+
+    // Later quads are drawn on top.
+    float grid = static_cast<float>(m_gridSize);
+    for (std::size_t quad = chunk.vertices.size() / 4; quad-- > 0;) {
+        const sf::Vertex* vertices = &chunk.vertices[quad * 4];
+        sf::Vector2f local = vertices[0].position - m_offset;
+        if (static_cast<int>(std::floor(local.x / grid)) != cellX ||
+            static_cast<int>(std::floor(local.y / grid)) != cellY) {
+            continue;
+        }
+
+        for (const auto& animated : chunk.animatedSlots) {
+            if (animated.vertex == quad * 4) {
+                return animated.tileId;
+            }
+        }
+
+        float u = std::min(vertices[0].texCoords.x, vertices[1].texCoords.x);
+        float v = std::min(vertices[0].texCoords.y, vertices[2].texCoords.y);
+        return static_cast<int>(v) / m_tilesetTileSize * m_tilesetColumns + static_cast<int>(u) / m_tilesetTileSize;
+    }
+
+    // The index only still holds the cell if its chunk hasn't been turned
+    // into vertices by the upload.
+    if (!m_indexPixels.empty() && (m_useShader || chunkIndex >= m_uploadCursor)) {
+        const std::uint8_t* texel = &m_indexPixels[(static_cast<std::size_t>(cellY) * m_widthInTiles + cellX) * 4];
+        int tileId = -1;
+        bool flipX = false;
+        bool flipY = false;
+        if (TileIndexMap::decode(texel, tileId, flipX, flipY)) {
+            return tileId;
+        }
+    }
+    return -1;
+}
+
+std::size_t TileLayerMesh::removeChunkTiles(Chunk& chunk, int cellX, int cellY) {
+    // Quads are compacted in place so the rest of the chunk keeps its draw
+    // order; animated slots follow their quads.
+    std::size_t quadCount = chunk.vertices.size() / 4;
+    std::vector<std::uint32_t> remap(quadCount);
+    std::size_t kept = 0;
+
+    float grid = static_cast<float>(m_gridSize);
+    for (std::size_t quad = 0; quad < quadCount; ++quad) {
+        const sf::Vertex* vertices = &chunk.vertices[quad * 4];
+        sf::Vector2f local = vertices[0].position - m_offset;
+        bool inCell = static_cast<int>(std::floor(local.x / grid)) == cellX &&
+            static_cast<int>(std::floor(local.y / grid)) == cellY;
+
+        if (inCell) {
+            remap[quad] = ~0u;
+            continue;
+        }
+
+        remap[quad] = static_cast<std::uint32_t>(kept * 4);
+        if (kept != quad) {
+            std::copy(vertices, vertices + 4, &chunk.vertices[kept * 4]);
+        }
+        kept++;
+    }
+
+    std::size_t removed = quadCount - kept;
+    if (removed == 0) return 0;
+    chunk.vertices.resize(kept * 4);
+
+    std::size_t slot = 0;
+    for (const auto& animated : chunk.animatedSlots) {
+        std::uint32_t vertex = remap[animated.vertex / 4];
+        if (vertex == ~0u) {
+            m_animatedTileCount--;
+            continue;
+        }
+
+        chunk.animatedSlots[slot] = animated;
+        chunk.animatedSlots[slot].vertex = vertex;
+        slot++;
+    }
+    chunk.animatedSlots.resize(slot);
+    return removed;
+}
+
+void TileLayerMesh::reuploadChunk(Chunk& chunk) {
+    chunk.edited = false;
+    if (!m_useVertexBuffers) return;
+
+    if (chunk.vertices.empty()) {
+        chunk.uploaded = false;
+        return;
+    }
+
+    if (!chunk.uploaded || chunk.buffer.getVertexCount() != chunk.vertices.size()) {
+        chunk.buffer.create(chunk.vertices.size());
+    }
+    chunk.buffer.update(chunk.vertices.data());
+    chunk.uploaded = true;
+}
+
+void TileLayerMesh::appendTile(Chunk& chunk, const LayerTile& tile) {
+    float left = m_offset.x + tile.x;
+    float top = m_offset.y + tile.y;
+    float size = static_cast<float>(m_gridSize);
+
+    chunk.vertices.emplace_back(sf::Vector2f(left, top), m_color);
+    chunk.vertices.emplace_back(sf::Vector2f(left + size, top), m_color);
+    chunk.vertices.emplace_back(sf::Vector2f(left + size, top + size), m_color);
+    chunk.vertices.emplace_back(sf::Vector2f(left, top + size), m_color);
+    setTileTexCoords(&chunk.vertices[chunk.vertices.size() - 4], tile.tileId, tile.flipX, tile.flipY);
+}
+
+void TileLayerMesh::setTileTexCoords(sf::Vertex* quad, int tileId, bool flipX, bool flipY) const {
+    float u0 = static_cast<float>((tileId % m_tilesetColumns) * m_tilesetTileSize);
+    float v0 = static_cast<float>((tileId / m_tilesetColumns) * m_tilesetTileSize);
+    float u1 = u0 + m_tilesetTileSize;
+    float v1 = v0 + m_tilesetTileSize;
+
+    if (flipX) std::swap(u0, u1);
+    if (flipY) std::swap(v0, v1);
+
+    quad[0].texCoords = sf::Vector2f(u0, v0);
+    quad[1].texCoords = sf::Vector2f(u1, v0);
+    quad[2].texCoords = sf::Vector2f(u1, v1);
+    quad[3].texCoords = sf::Vector2f(u0, v1);
+}
+
+void TileLayerMesh::updateAnimatedSlots(Chunk& chunk) {
+    const TileAnimationSet* animations = TileAnimationSet::getInstance();
+    if (chunk.animationStep == animations->getStep()) return;
+    chunk.animationStep = animations->getStep();
+
+    float time = animations->getTime();
+    std::size_t first = chunk.vertices.size();
+    std::size_t last = 0;
+
+    for (auto& slot : chunk.animatedSlots) {
+        int frame = slot.animation->getFrame(time);
+        if (frame == slot.frame) continue;
+
+        slot.frame = frame;
+        setTileTexCoords(&chunk.vertices[slot.vertex], frame, slot.flipX, slot.flipY);
+        first = std::min<std::size_t>(first, slot.vertex);
+        last = std::max<std::size_t>(last, slot.vertex + 4);
+    }
+
+    // One upload spanning the changed quads of the chunk.
+    if (chunk.uploaded && first < last) {
+        chunk.buffer.update(&chunk.vertices[first], last - first, static_cast<unsigned int>(first));
+    }
+}
+
+void TileLayerMesh::render(sf::RenderTarget& target) {
+    m_lastDrawCalls = 0;
+    if (!m_texture || m_tileCount == 0) return;
+
+    const sf::View& view = target.getView();
+    sf::FloatRect viewRect(
+        view.getCenter().x - view.getSize().x / 2.0f,
+        view.getCenter().y - view.getSize().y / 2.0f,
+        view.getSize().x,
+        view.getSize().y);
+
+    if (m_useShader) {
+        renderIndexed(target, viewRect);
+    }
+
+    sf::RenderStates states;
+    states.texture = m_texture;
+
+    for (auto& chunk : m_chunks) {
+        if (chunk.edited && chunk.bounds.intersects(viewRect)) {
+            reuploadChunk(chunk);
+        }
+        if (chunk.vertices.empty() || !chunk.bounds.intersects(viewRect)) continue;
+
+        if (!chunk.animatedSlots.empty()) {
+            updateAnimatedSlots(chunk);
+        }
+
+        if (chunk.uploaded) {
+            target.draw(chunk.buffer, states);
+        }
+        else {
+            target.draw(chunk.vertices.data(), chunk.vertices.size(), sf::Quads, states);
+        }
+        m_lastDrawCalls++;
+    }
+}
+
+void TileLayerMesh::renderIndexed(sf::RenderTarget& target, const sf::FloatRect& viewRect) {
+    sf::FloatRect layerRect(m_offset.x, m_offset.y,
+        static_cast<float>(m_widthInTiles * m_gridSize), static_cast<float>(m_heightInTiles * m_gridSize));
+
+    sf::FloatRect visible;
+    if (!layerRect.intersects(viewRect, visible)) return;
+
+    sf::Shader* shader = getIndexShader();
+    sf::Vector2u tilesetSize = m_texture->getSize();
+    shader->setUniform("tileset", *m_texture);
+    shader->setUniform("indexMap", m_indexTexture);
+    shader->setUniform("mapSize", sf::Glsl::Vec2(static_cast<float>(m_widthInTiles), static_cast<float>(m_heightInTiles)));
+    shader->setUniform("tilesetSize", sf::Glsl::Vec2(static_cast<float>(tilesetSize.x), static_cast<float>(tilesetSize.y)));
+    shader->setUniform("tilesetTileSize", static_cast<float>(m_tilesetTileSize));
+    shader->setUniform("tilesetColumns", static_cast<float>(m_tilesetColumns));
+
+    // Texture coordinates in cells; no texture is bound so SFML leaves them
+    // unnormalised.
+    float grid = static_cast<float>(m_gridSize);
+    sf::Vector2f corners[4] = {
+        sf::Vector2f(visible.left, visible.top),
+        sf::Vector2f(visible.left + visible.width, visible.top),
+        sf::Vector2f(visible.left + visible.width, visible.top + visible.height),
+        sf::Vector2f(visible.left, visible.top + visible.height)
+    };
+
+    sf::Vertex quad[4];
+    for (int i = 0; i < 4; ++i) {
+        quad[i] = sf::Vertex(corners[i], m_color, (corners[i] - m_offset) / grid);
+    }
+
+    sf::RenderStates states;
+    states.shader = shader;
+    target.draw(quad, 4, sf::Quads, states);
+    m_lastDrawCalls++;
+}
+
+void TileLayerMesh::setOffset(const sf::Vector2f& offset) {
+    m_offset = offset;
+}
+
+const sf::Vector2f& TileLayerMesh::getOffset() const {
+    return m_offset;
+}
+
+int TileLayerMesh::getGridSize() const {
+    return m_gridSize;
+}
+
+int TileLayerMesh::getWidthInTiles() const {
+    return m_widthInTiles;
+}
+
+int TileLayerMesh::getHeightInTiles() const {
+    return m_heightInTiles;
+}
+
+void TileLayerMesh::setOpacity(float opacity) {
+    opacity = std::max(0.0f, std::min(1.0f, opacity));
+    m_color.a = static_cast<sf::Uint8>(opacity * 255.0f);
+}
+
+void TileLayerMesh::setAnimations(const TilesetAnimations* animations) {
+    m_animations = animations;
+}
+
+void TileLayerMesh::setTexture(const sf::Texture* texture) {
+    m_texture = texture;
+}
+
+const std::string& TileLayerMesh::getName() const {
+    return m_name;
+}
+
+const sf::Texture* TileLayerMesh::getTexture() const {
+    return m_texture;
+}
+
+std::size_t TileLayerMesh::getTileCount() const {
+    return m_tileCount;
+}
+
+std::size_t TileLayerMesh::getAnimatedTileCount() const {
+    return m_animatedTileCount;
+}
+
+std::size_t TileLayerMesh::getChunkCount() const {
+    return m_chunks.size();
+}
+
+std::size_t TileLayerMesh::getMemoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& chunk : m_chunks) {
+        bytes += chunk.vertices.capacity() * sizeof(sf::Vertex);
+    }
+    bytes += m_indexPixels.capacity();
+    if (m_useShader) {
+        bytes += static_cast<std::size_t>(m_widthInTiles) * m_heightInTiles * 4;
+    }
+    return bytes;
+}
+
+std::size_t TileLayerMesh::getLastDrawCallCount() const {
+    return m_lastDrawCalls;
+}
+
+bool TileLayerMesh::isShaderRendered() const {
+    return m_useShader;
+}
+
+void TileLayerMesh::setShaderRenderingEnabled(bool enabled) {
+    s_shaderRenderingEnabled = enabled;
+}
+
+bool TileLayerMesh::isShaderRenderingEnabled() {
+    return s_shaderRenderingEnabled;
+}
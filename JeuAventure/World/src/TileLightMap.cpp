@@ -0,0 +1,399 @@
+#include "TileLightMap.h"
+#include "Tilemap.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+const int TileLightMap::MaxLevel;
+
+TileLightMap::TileLightMap()
+    : m_tilemap(nullptr),
+    m_width(0),
+    m_height(0),
+    m_textureReady(false),
+    m_dirtyMinX(0),
+    m_dirtyMinY(0),
+    m_dirtyMaxX(-1),
+    m_dirtyMaxY(-1),
+    m_ambientColor(70, 75, 100),
+    m_lightColor(255, 235, 190),
+    m_enabled(false),
+    m_updatedTiles(0),
+    m_lastUpdatedTiles(0),
+    m_lastUploadedTiles(0)
+{
+}
+
+void TileLightMap::build(const Tilemap* tilemap) {
+    m_tilemap = tilemap;
+    m_width = tilemap ? tilemap->getWidth() : 0;
+    m_height = tilemap ? tilemap->getHeight() : 0;
+    m_levels.assign(static_cast<std::size_t>(m_width) * m_height, 0);
+    m_sourceLevels.assign(m_levels.size(), 0);
+    m_textureReady = false;
+
+    for (auto& light : m_lights) {
+        light.tile = worldToTile(light.position);
+        if (light.active) {
+            addSource(light.tile, light.level);
+        }
+    }
+    propagate();
+    markAllDirty();
+}
+
+void TileLightMap::clear() {
+    m_tilemap = nullptr;
+    m_width = 0;
+    m_height = 0;
+    m_levels.clear();
+    m_sourceLevels.clear();
+    m_lights.clear();
+    m_textureReady = false;
+}
+
+int TileLightMap::addLight(const sf::Vector2f& position, int level) {
+    level = std::max(0, std::min(MaxLevel, level));
+
+    std::size_t id = 0;
+    while (id < m_lights.size() && m_lights[id].active) {
+        id++;
+    }
+    if (id == m_lights.size()) {
+        m_lights.push_back(Light());
+    }
+
+    Light& light = m_lights[id];
+    light.position = position;
+    light.tile = worldToTile(position);
+    light.level = level;
+    light.active = true;
+
+    addSource(light.tile, level);
+    propagate();
+    return static_cast<int>(id);
+}
+
+void TileLightMap::moveLight(int id, const sf::Vector2f& position) {
+    if (id < 0 || id >= static_cast<int>(m_lights.size()) || !m_lights[id].active) return;
+
+    Light& light = m_lights[id];
+    light.position = position;
+
+    sf::Vector2i tile = worldToTile(position);
+    if (tile == light.tile) return;
+
+    sf::Vector2i previous = light.tile;
+    light.tile = tile;
+    removeSource(previous);
+    addSource(tile, light.level);
+    propagate();
+}
+
+void TileLightMap::setLightLevel(int id, int level) {
+    if (id < 0 || id >= static_cast<int>(m_lights.size()) || !m_lights[id].active) return;
+
+    Light& light = m_lights[id];
+    level = std::max(0, std::min(MaxLevel, level));
+    if (level == light.level) return;
+
+    light.level = level;
+    removeSource(light.tile);
+    addSource(light.tile, level);
+    propagate();
+}
+
+void TileLightMap::removeLight(int id) {
+    if (id < 0 || id >= static_cast<int>(m_lights.size()) || !m_lights[id].active) return;
+
+    m_lights[id].active = false;
+    removeSource(m_lights[id].tile);
+    propagate();
+}
+
+void TileLightMap::onTilesChanged(const sf::IntRect& cells) {
+    if (!m_tilemap || m_width == 0) return;
+
+    int firstX = std::max(0, cells.left);
+    int firstY = std::max(0, cells.top);
+    int lastX = std::min(m_width - 1, cells.left + cells.width - 1);
+    int lastY = std::min(m_height - 1, cells.top + cells.height - 1);
+
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            int index = y * m_width + x;
+
+            if (isOpaque(index)) {
+                // A tile that turned solid stops passing light: clear what
+                // it may have fed and let the surroundings light it again.
+                int level = m_levels[index];
+                setLevel(index, m_sourceLevels[index]);
+                m_decreaseQueue.push_back({ index, level, true });
+            }
+            else {
+                // A tile that opened up: its lit neighbours spread into it.
+                m_increaseQueue.push_back(index);
+                if (x > 0) m_increaseQueue.push_back(index - 1);
+                if (x < m_width - 1) m_increaseQueue.push_back(index + 1);
+                if (y > 0) m_increaseQueue.push_back(index - m_width);
+                if (y < m_height - 1) m_increaseQueue.push_back(index + m_width);
+            }
+        }
+    }
+    propagate();
+}
+
+int TileLightMap::getLevel(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return 0;
+    return m_levels[static_cast<std::size_t>(y) * m_width + x];
+}
+
+void TileLightMap::setAmbientColor(const sf::Color& color) {
+    m_ambientColor = color;
+    markAllDirty();
+}
+
+void TileLightMap::setLightColor(const sf::Color& color) {
+    m_lightColor = color;
+    markAllDirty();
+}
+
+void TileLightMap::setEnabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+bool TileLightMap::isEnabled() const {
+    return m_enabled;
+}
+
+void TileLightMap::update() {
+    m_lastUpdatedTiles = m_updatedTiles;
+    m_updatedTiles = 0;
+}
+
+void TileLightMap::render(sf::RenderTarget& target) {
+    m_lastUploadedTiles = 0;
+    if (!m_enabled || m_width == 0 || m_height == 0) return;
+
+    if (!m_textureReady) {
+        unsigned int maxSize = sf::Texture::getMaximumSize();
+        if (static_cast<unsigned int>(m_width) > maxSize || static_cast<unsigned int>(m_height) > maxSize ||
+            !m_texture.create(m_width, m_height)) {
+            std::cerr << "Light map of " << m_width << "x" << m_height << " tiles exceeds the texture size, lighting disabled" << std::endl;
+            m_enabled = false;
+            return;
+        }
+        m_texture.setSmooth(true);
+        m_textureReady = true;
+        markAllDirty();
+    }
+    uploadDirty();
+
+    float tileWidth = static_cast<float>(m_tilemap->getTileWidth());
+    float tileHeight = static_cast<float>(m_tilemap->getTileHeight());
+    const sf::View& view = target.getView();
+    sf::FloatRect viewRect(
+        view.getCenter().x - view.getSize().x / 2.0f,
+        view.getCenter().y - view.getSize().y / 2.0f,
+        view.getSize().x,
+        view.getSize().y);
+
+    sf::FloatRect visible;
+    if (!viewRect.intersects(sf::FloatRect(0.f, 0.f, m_width * tileWidth, m_height * tileHeight), visible)) return;
+
+    // Texture coordinates in texels: tile centres land on texel centres, so
+    // the filtering blends neighbouring tiles' light.
+    sf::Vertex quad[4];
+    sf::Vector2f corners[4] = {
+        sf::Vector2f(visible.left, visible.top),
+        sf::Vector2f(visible.left + visible.width, visible.top),
+        sf::Vector2f(visible.left + visible.width, visible.top + visible.height),
+        sf::Vector2f(visible.left, visible.top + visible.height)
+    };
+    for (int i = 0; i < 4; ++i) {
+        quad[i] = sf::Vertex(corners[i], sf::Color::White, sf::Vector2f(corners[i].x / tileWidth, corners[i].y / tileHeight));
+    }
+
+    sf::RenderStates states;
+    states.texture = &m_texture;
+    states.blendMode = sf::BlendMultiply;
+    target.draw(quad, 4, sf::Quads, states);
+}
+
+std::size_t TileLightMap::getLightCount() const {
+    return static_cast<std::size_t>(std::count_if(m_lights.begin(), m_lights.end(),
+        [](const Light& light) { return light.active; }));
+}
+
+std::size_t TileLightMap::getLastUpdatedTileCount() const {
+    return m_lastUpdatedTiles;
+}
+
+std::size_t TileLightMap::getLastUploadedTileCount() const {
+    return m_lastUploadedTiles;
+}
+
+bool TileLightMap::isOpaque(int index) const {
+    return m_tilemap->isTileCollidable(index % m_width, index / m_width);
+}
+
+sf::Vector2i TileLightMap::worldToTile(const sf::Vector2f& position) const {
+    if (!m_tilemap) return sf::Vector2i(NoTile, NoTile);
+
+    return sf::Vector2i(static_cast<int>(std::floor(position.x / m_tilemap->getTileWidth())),
+        static_cast<int>(std::floor(position.y / m_tilemap->getTileHeight())));
+}
+
+void TileLightMap::setLevel(int index, int level) {
+    m_levels[index] = static_cast<std::uint8_t>(level);
+    m_updatedTiles++;
+
+    int x = index % m_width;
+    int y = index / m_width;
+    m_dirtyMinX = std::min(m_dirtyMinX, x);
+    m_dirtyMinY = std::min(m_dirtyMinY, y);
+    m_dirtyMaxX = std::max(m_dirtyMaxX, x);
+    m_dirtyMaxY = std::max(m_dirtyMaxY, y);
+}
+
+void TileLightMap::markAllDirty() {
+    m_dirtyMinX = 0;
+    m_dirtyMinY = 0;
+    m_dirtyMaxX = m_width - 1;
+    m_dirtyMaxY = m_height - 1;
+}
+
+void TileLightMap::refreshSource(const sf::Vector2i& tile) {
+    int strongest = 0;
+    for (const auto& light : m_lights) {
+        if (light.active && light.tile == tile) {
+            strongest = std::max(strongest, light.level);
+        }
+    }
+    m_sourceLevels[tile.y * m_width + tile.x] = static_cast<std::uint8_t>(strongest);
+}
+
+void TileLightMap::addSource(const sf::Vector2i& tile, int level) {
+    if (tile.x < 0 || tile.y < 0 || tile.x >= m_width || tile.y >= m_height) return;
+
+    int index = tile.y * m_width + tile.x;
+    m_sourceLevels[index] = static_cast<std::uint8_t>(std::max<int>(m_sourceLevels[index], level));
+    if (level > m_levels[index]) {
+        setLevel(index, level);
+        m_increaseQueue.push_back(index);
+    }
+}
+
+void TileLightMap::removeSource(const sf::Vector2i& tile) {
+    if (tile.x < 0 || tile.y < 0 || tile.x >= m_width || tile.y >= m_height) return;
+
+    int index = tile.y * m_width + tile.x;
+    refreshSource(tile);
+
+    int level = m_levels[index];
+    if (level > m_sourceLevels[index]) {
+        setLevel(index, m_sourceLevels[index]);
+        m_decreaseQueue.push_back({ index, level, !isOpaque(index) });
+        if (m_sourceLevels[index] > 0) {
+            m_increaseQueue.push_back(index);
+        }
+    }
+}
+
+// Two passes over queues that persist between calls. The decrease pass
+// clears every tile that was lit through a removed level and queues the lit
+// tiles bordering the cleared area; the increase pass then spreads light
+// from those and from new sources.
+void TileLightMap::propagate() {
+    const int offsets[4] = { -1, 1, -m_width, m_width };
+
+    for (std::size_t head = 0; head < m_decreaseQueue.size(); ++head) {
+        Removal removal = m_decreaseQueue[head];
+        int x = removal.index % m_width;
+
+        for (int direction = 0; direction < 4; ++direction) {
+            if ((direction == 0 && x == 0) || (direction == 1 && x == m_width - 1)) continue;
+
+            int neighbour = removal.index + offsets[direction];
+            if (neighbour < 0 || neighbour >= static_cast<int>(m_levels.size())) continue;
+
+            int level = m_levels[neighbour];
+            if (level == 0) continue;
+
+            if (removal.emitted && level < removal.level) {
+                int source = m_sourceLevels[neighbour];
+                setLevel(neighbour, source);
+                m_decreaseQueue.push_back({ neighbour, level, !isOpaque(neighbour) });
+                if (source > 0) {
+                    m_increaseQueue.push_back(neighbour);
+                }
+            }
+            else {
+                m_increaseQueue.push_back(neighbour);
+            }
+        }
+    }
+    m_decreaseQueue.clear();
+
+    for (std::size_t head = 0; head < m_increaseQueue.size(); ++head) {
+        int index = m_increaseQueue[head];
+        int level = m_levels[index];
+        if (level <= 1 || isOpaque(index)) continue;
+
+        int x = index % m_width;
+        for (int direction = 0; direction < 4; ++direction) {
+            if ((direction == 0 && x == 0) || (direction == 1 && x == m_width - 1)) continue;
+
+            int neighbour = index + offsets[direction];
+            if (neighbour < 0 || neighbour >= static_cast<int>(m_levels.size())) continue;
+
+            if (m_levels[neighbour] < level - 1) {
+                setLevel(neighbour, level - 1);
+                m_increaseQueue.push_back(neighbour);
+            }
+        }
+    }
+    m_increaseQueue.clear();
+}
+
+sf::Color TileLightMap::levelColor(int level) const {
+    float t = static_cast<float>(level) / MaxLevel;
+    auto mix = [t](sf::Uint8 from, sf::Uint8 to) {
+        return static_cast<sf::Uint8>(from + (to - from) * t);
+    };
+    return sf::Color(mix(m_ambientColor.r, m_lightColor.r), mix(m_ambientColor.g, m_lightColor.g),
+        mix(m_ambientColor.b, m_lightColor.b));
+}
+
+void TileLightMap::uploadDirty() {
+    if (m_dirtyMaxX < m_dirtyMinX || m_dirtyMaxY < m_dirtyMinY) return;
+
+    int width = m_dirtyMaxX - m_dirtyMinX + 1;
+    int height = m_dirtyMaxY - m_dirtyMinY + 1;
+
+    sf::Color palette[MaxLevel + 1];
+    for (int level = 0; level <= MaxLevel; ++level) {
+        palette[level] = levelColor(level);
+    }
+
+    m_pixels.resize(static_cast<std::size_t>(width) * height * 4);
+    std::uint8_t* pixel = m_pixels.data();
+    for (int y = m_dirtyMinY; y <= m_dirtyMaxY; ++y) {
+        const std::uint8_t* levels = &m_levels[static_cast<std::size_t>(y) * m_width + m_dirtyMinX];
+        for (int x = 0; x < width; ++x) {
+            const sf::Color& color = palette[levels[x]];
+            *pixel++ = color.r;
+            *pixel++ = color.g;
+            *pixel++ = color.b;
+            *pixel++ = 255;
+        }
+    }
+
+    m_texture.update(m_pixels.data(), width, height, m_dirtyMinX, m_dirtyMinY);
+    m_lastUploadedTiles = static_cast<std::size_t>(width) * height;
+
+    m_dirtyMinX = m_width;
+    m_dirtyMinY = m_height;
+    m_dirtyMaxX = -1;
+    m_dirtyMaxY = -1;
+}
@@ -1,46 +1,58 @@
 #include "Tilemap.h"
 #include "RessourceManager.h"
+#include "BitUtils.h"
 #include <iostream>
 #include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <limits>
 
 Tilemap::Tilemap(int width, int height)
     : m_width(width),
     m_height(height),
     m_tileWidth(32),
     m_tileHeight(32),
+    m_storageChunksX(0),
+    m_storageChunksY(0),
     m_tilesetTexture(nullptr),
     m_tilesetColumns(0),
     m_tilesetRows(0),
-    m_vertices(sf::Quads) {
-    m_tiles.resize(m_height, std::vector<TileInfo>(m_width));
-    m_vertices.resize(m_width * m_height * 4);
-
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            m_tiles[y][x].id = -1;
-            m_tiles[y][x].collidable = false;
-        }
-    }
-
-    m_lastViewRect = sf::FloatRect(0.0f, 0.0f, 800.0f, 600.0f);
+    m_chunksX(0),
+    m_chunksY(0),
+    m_useVertexBuffers(sf::VertexBuffer::isAvailable()),
+    m_collisionWordsPerRow(0),
+    m_collisionBoxesDirty(true),
+    m_lineOfSightGeneration(1),
+    m_lineOfSightQueries(0),
+    m_lineOfSightCacheHits(0),
+    m_lastLineOfSightQueries(0),
+    m_lastLineOfSightCacheHits(0),
+    m_showCollisionOverlay(false),
+    m_lastDrawCalls(0),
+    m_lastVisibleChunks(0) {
+    m_lineOfSightCache.fill({ 0, 0, false });
+    resizeStorage(m_width, m_height);
+    rebuildCollisionBits();
+    resetChunks();
 }
 
 Tilemap::~Tilemap() {}
 
+
 bool Tilemap::loadTileset(const std::string& texturePath, int tileWidth, int tileHeight) {
     if (!RessourceManager::getInstance()->loadTexture("tileset", texturePath)) {
         std::cerr << "Failed to load tileset texture: " << texturePath << std::endl;
         return false;
     }
 
-    m_tilesetTexture = RessourceManager::getInstance()->getTexture("tileset");
+    m_tilesetTexture = RessourceManager::getInstance()->getTexture("tileset"_rid);
     m_tileWidth = tileWidth;
     m_tileHeight = tileHeight;
 
     if (m_tilesetTexture) {
         m_tilesetColumns = m_tilesetTexture->getSize().x / m_tileWidth;
         m_tilesetRows = m_tilesetTexture->getSize().y / m_tileHeight;
-        rebuildVertexArray();
+        markAllChunksDirty();
         return true;
     }
 
@@ -48,133 +60,124 @@ bool Tilemap::loadTileset(const std::string& texturePath, int tileWidth, int til
 }
 
 void Tilemap::setTile(int x, int y, int id) {
-    if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        m_tiles[y][x].id = id;
-        int index = (y * m_width + x) * 4;
-
-        if (index + 3 < m_vertices.getVertexCount()) {
-            m_vertices[index].position = sf::Vector2f(x * m_tileWidth, y * m_tileHeight);
-            m_vertices[index + 1].position = sf::Vector2f((x + 1) * m_tileWidth, y * m_tileHeight);
-            m_vertices[index + 2].position = sf::Vector2f((x + 1) * m_tileWidth, (y + 1) * m_tileHeight);
-            m_vertices[index + 3].position = sf::Vector2f(x * m_tileWidth, (y + 1) * m_tileHeight);
-
-            if (id >= 0 && m_tilesetTexture) {
-                sf::Vector2i texCoords = getTilesetCoords(id);
-
-                m_vertices[index].texCoords = sf::Vector2f(texCoords.x, texCoords.y);
-                m_vertices[index + 1].texCoords = sf::Vector2f(texCoords.x + m_tileWidth, texCoords.y);
-                m_vertices[index + 2].texCoords = sf::Vector2f(texCoords.x + m_tileWidth, texCoords.y + m_tileHeight);
-                m_vertices[index + 3].texCoords = sf::Vector2f(texCoords.x, texCoords.y + m_tileHeight);
-            }
-            else {
-                m_vertices[index].texCoords = sf::Vector2f(0, 0);
-                m_vertices[index + 1].texCoords = sf::Vector2f(0, 0);
-                m_vertices[index + 2].texCoords = sf::Vector2f(0, 0);
-                m_vertices[index + 3].texCoords = sf::Vector2f(0, 0);
-            }
-        }
+    if (!inBounds(x, y)) return;
 
-        if (m_tiles[y][x].collidable) {
-            sf::FloatRect collisionBox(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
-            auto it = std::find(m_collisionBoxes.begin(), m_collisionBoxes.end(), collisionBox);
-            if (it == m_collisionBoxes.end()) {
-                m_collisionBoxes.push_back(collisionBox);
-            }
-        }
-        else {
-            sf::FloatRect collisionBox(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
-            auto it = std::find(m_collisionBoxes.begin(), m_collisionBoxes.end(), collisionBox);
-            if (it != m_collisionBoxes.end()) {
-                m_collisionBoxes.erase(it);
-            }
-        }
+    if (id >= EmptyTileId) {
+        std::cerr << "Tile id out of range: " << id << std::endl;
+        return;
+    }
+
+    if (getTile(x, y) != id) {
+        std::uint16_t packedId = id < 0 ? EmptyTileId : static_cast<std::uint16_t>(id);
+        int cell = 0;
+        TileStorageChunk* chunk = findOrCreateStorage(x, y, cell);
+
+        bool wasUsed = chunk->ids[cell] != EmptyTileId || chunk->flags[cell] != 0;
+        chunk->ids[cell] = packedId;
+        bool isUsed = packedId != EmptyTileId || chunk->flags[cell] != 0;
+        chunk->usedCount += static_cast<int>(isUsed) - static_cast<int>(wasUsed);
+
+        releaseStorageIfUnused(x, y);
+        markChunkDirty(x, y, false);
     }
 }
 
 int Tilemap::getTile(int x, int y) const {
-    if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        return m_tiles[y][x].id;
+    if (!inBounds(x, y)) return -1;
+
+    int cell = 0;
+    const TileStorageChunk* chunk = findStorage(x, y, cell);
+    if (!chunk || chunk->ids[cell] == EmptyTileId) {
+        return -1;
     }
-    return -1;
+    return chunk->ids[cell];
 }
 
 void Tilemap::setTileCollision(int x, int y, bool collidable) {
-    if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        m_tiles[y][x].collidable = collidable;
-        sf::FloatRect collisionBox(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
+    if (!inBounds(x, y)) return;
+
+    if (isTileCollidable(x, y) != collidable) {
+        int cell = 0;
+        TileStorageChunk* chunk = findOrCreateStorage(x, y, cell);
 
+        bool wasUsed = chunk->ids[cell] != EmptyTileId || chunk->flags[cell] != 0;
         if (collidable) {
-            auto it = std::find(m_collisionBoxes.begin(), m_collisionBoxes.end(), collisionBox);
-            if (it == m_collisionBoxes.end()) {
-                m_collisionBoxes.push_back(collisionBox);
-            }
+            chunk->flags[cell] |= TileCollidable;
         }
         else {
-            auto it = std::find(m_collisionBoxes.begin(), m_collisionBoxes.end(), collisionBox);
-            if (it != m_collisionBoxes.end()) {
-                m_collisionBoxes.erase(it);
-            }
+            chunk->flags[cell] &= static_cast<std::uint8_t>(~TileCollidable);
+        }
+        bool isUsed = chunk->ids[cell] != EmptyTileId || chunk->flags[cell] != 0;
+        chunk->usedCount += static_cast<int>(isUsed) - static_cast<int>(wasUsed);
+
+        releaseStorageIfUnused(x, y);
+        setCollisionBit(x, y, collidable);
+        markChunkDirty(x, y, true);
+
+        if (m_collisionListener) {
+            m_collisionListener(y, y);
         }
     }
 }
 
 bool Tilemap::isTileCollidable(int x, int y) const {
-    if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        return m_tiles[y][x].collidable;
-    }
-    return false;
+    return inBounds(x, y) && isCollisionBitSet(x, y);
+}
+
+bool Tilemap::isCollisionBitSet(int x, int y) const {
+    std::uint64_t word = m_collisionBits[static_cast<std::size_t>(y) * m_collisionWordsPerRow + (x >> 6)];
+    return (word >> (x & 63)) & 1u;
 }
 
 void Tilemap::setTileType(int x, int y, const std::string& type) {
-    if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        m_tiles[y][x].type = type;
+    if (!inBounds(x, y)) return;
+
+    if (!type.empty()) {
+        m_tileProperties[propertyKey(x, y)].type = type;
+        return;
+    }
+
+    auto it = m_tileProperties.find(propertyKey(x, y));
+    if (it != m_tileProperties.end()) {
+        it->second.type.clear();
+        if (it->second.properties.empty()) {
+            m_tileProperties.erase(it);
+        }
     }
 }
 
 std::string Tilemap::getTileType(int x, int y) const {
-    if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        return m_tiles[y][x].type;
+    if (!inBounds(x, y)) return "";
+
+    auto it = m_tileProperties.find(propertyKey(x, y));
+    return it != m_tileProperties.end() ? it->second.type : "";
+}
+
+void Tilemap::addTileProperty(int x, int y, const std::string& property) {
+    if (inBounds(x, y)) {
+        m_tileProperties[propertyKey(x, y)].properties.push_back(property);
     }
-    return "";
+}
+
+std::vector<std::string> Tilemap::getTileProperties(int x, int y) const {
+    if (!inBounds(x, y)) return {};
+
+    auto it = m_tileProperties.find(propertyKey(x, y));
+    return it != m_tileProperties.end() ? it->second.properties : std::vector<std::string>();
 }
 
 void Tilemap::resize(int width, int height) {
     if (width <= 0 || height <= 0) return;
 
-    auto oldTiles = m_tiles;
-    int oldWidth = m_width;
-    int oldHeight = m_height;
-
     m_width = width;
     m_height = height;
-    m_tiles.resize(m_height, std::vector<TileInfo>(m_width));
 
-    for (int y = 0; y < std::min(oldHeight, m_height); ++y) {
-        for (int x = 0; x < std::min(oldWidth, m_width); ++x) {
-            m_tiles[y][x] = oldTiles[y][x];
-        }
-    }
-
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (y >= oldHeight || x >= oldWidth) {
-                m_tiles[y][x].id = -1;
-                m_tiles[y][x].collidable = false;
-            }
-        }
-    }
+    resizeStorage(m_width, m_height);
+    rebuildCollisionBits();
+    resetChunks();
 
-    m_vertices.resize(m_width * m_height * 4);
-    rebuildVertexArray();
-
-    m_collisionBoxes.clear();
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (m_tiles[y][x].collidable) {
-                sf::FloatRect collisionBox(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
-                m_collisionBoxes.push_back(collisionBox);
-            }
-        }
+    if (m_collisionListener) {
+        m_collisionListener(0, m_height - 1);
     }
 }
 
@@ -197,16 +200,12 @@ void Tilemap::setTileSize(int width, int height) {
         m_tilesetRows = m_tilesetTexture->getSize().y / m_tileHeight;
     }
 
-    rebuildVertexArray();
+    markAllChunksDirty();
+    m_collisionBoxesDirty = true;
+    m_lineOfSightGeneration++;
 
-    m_collisionBoxes.clear();
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (m_tiles[y][x].collidable) {
-                sf::FloatRect collisionBox(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
-                m_collisionBoxes.push_back(collisionBox);
-            }
-        }
+    if (m_collisionListener) {
+        m_collisionListener(0, m_height - 1);
     }
 }
 
@@ -226,166 +225,587 @@ sf::Vector2i Tilemap::worldToTile(float x, float y) const {
     return sf::Vector2i(static_cast<int>(x / m_tileWidth), static_cast<int>(y / m_tileHeight));
 }
 
-bool Tilemap::checkCollision(const sf::FloatRect& rect) const {
-    sf::Vector2i topLeft = worldToTile(rect.left, rect.top);
-    sf::Vector2i bottomRight = worldToTile(rect.left + rect.width, rect.top + rect.height);
-
-    topLeft.x = std::max(0, topLeft.x);
-    topLeft.y = std::max(0, topLeft.y);
-    bottomRight.x = std::min(m_width - 1, bottomRight.x);
-    bottomRight.y = std::min(m_height - 1, bottomRight.y);
-
-    for (int y = topLeft.y; y <= bottomRight.y; ++y) {
-        for (int x = topLeft.x; x <= bottomRight.x; ++x) {
-            if (m_tiles[y][x].collidable) {
-                sf::FloatRect tileRect(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
-                if (rect.intersects(tileRect)) {
+// Tiles that overlap `area` with a non-zero intersection, which is what
+// sf::FloatRect::intersects reports; false if there are none.
+bool Tilemap::getTileRange(const sf::FloatRect& area, int& firstX, int& firstY, int& lastX, int& lastY) const {
+    if (area.width <= 0.f || area.height <= 0.f || m_tileWidth <= 0 || m_tileHeight <= 0) {
+        return false;
+    }
+
+    firstX = std::max(0, static_cast<int>(std::floor(area.left / m_tileWidth)));
+    firstY = std::max(0, static_cast<int>(std::floor(area.top / m_tileHeight)));
+    lastX = std::min(m_width - 1, static_cast<int>(std::ceil((area.left + area.width) / m_tileWidth)) - 1);
+    lastY = std::min(m_height - 1, static_cast<int>(std::ceil((area.top + area.height) / m_tileHeight)) - 1);
+    return firstX <= lastX && firstY <= lastY;
+}
+
+// Calls visitor(x, y) for each collidable tile in the area, row by row,
+// until it returns true. Whole words of empty tiles are skipped at once.
+template <typename Visitor>
+bool Tilemap::forEachCollidableTile(const sf::FloatRect& area, Visitor visitor) const {
+    int firstX, firstY, lastX, lastY;
+    if (!getTileRange(area, firstX, firstY, lastX, lastY)) {
+        return false;
+    }
+
+    int firstWord = firstX >> 6;
+    int lastWord = lastX >> 6;
+
+    for (int y = firstY; y <= lastY; ++y) {
+        const std::uint64_t* row = &m_collisionBits[static_cast<std::size_t>(y) * m_collisionWordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w) {
+            std::uint64_t bits = row[w] & BitUtils::rangeMask(w == firstWord ? (firstX & 63) : 0, w == lastWord ? (lastX & 63) : 63);
+            while (bits) {
+                if (visitor(w * 64 + BitUtils::countTrailingZeros(bits), y)) {
                     return true;
                 }
+                bits &= bits - 1;
             }
         }
     }
-
     return false;
 }
 
+bool Tilemap::checkCollision(const sf::FloatRect& rect) const {
+    return forEachCollidableTile(rect, [](int, int) { return true; });
+}
+
 std::vector<sf::FloatRect> Tilemap::getCollisionsInArea(const sf::FloatRect& area) const {
     std::vector<sf::FloatRect> collisions;
+    forEachCollidableTile(area, [&](int x, int y) {
+        collisions.emplace_back(static_cast<float>(x * m_tileWidth), static_cast<float>(y * m_tileHeight),
+            static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
+        return false;
+        });
+    return collisions;
+}
 
-    sf::Vector2i topLeft = worldToTile(area.left, area.top);
-    sf::Vector2i bottomRight = worldToTile(area.left + area.width, area.top + area.height);
+int Tilemap::countCollisionsInArea(const sf::FloatRect& area) const {
+    int firstX, firstY, lastX, lastY;
+    if (!getTileRange(area, firstX, firstY, lastX, lastY)) {
+        return 0;
+    }
+
+    int firstWord = firstX >> 6;
+    int lastWord = lastX >> 6;
+    int count = 0;
 
-    topLeft.x = std::max(0, topLeft.x);
-    topLeft.y = std::max(0, topLeft.y);
-    bottomRight.x = std::min(m_width - 1, bottomRight.x);
-    bottomRight.y = std::min(m_height - 1, bottomRight.y);
+    for (int y = firstY; y <= lastY; ++y) {
+        const std::uint64_t* row = &m_collisionBits[static_cast<std::size_t>(y) * m_collisionWordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w) {
+            count += BitUtils::popCount(row[w] & BitUtils::rangeMask(w == firstWord ? (firstX & 63) : 0, w == lastWord ? (lastX & 63) : 63));
+        }
+    }
+    return count;
+}
 
-    for (int y = topLeft.y; y <= bottomRight.y; ++y) {
-        for (int x = topLeft.x; x <= bottomRight.x; ++x) {
-            if (m_tiles[y][x].collidable) {
-                sf::FloatRect tileRect(x * m_tileWidth, y * m_tileHeight, m_tileWidth, m_tileHeight);
-                if (area.intersects(tileRect)) {
-                    collisions.push_back(tileRect);
+const std::vector<sf::FloatRect>& Tilemap::getCollisionBoxes() const {
+    if (m_collisionBoxesDirty) {
+        m_collisionBoxes.clear();
+        for (int y = 0; y < m_height; ++y) {
+            const std::uint64_t* row = &m_collisionBits[static_cast<std::size_t>(y) * m_collisionWordsPerRow];
+            for (int w = 0; w < m_collisionWordsPerRow; ++w) {
+                std::uint64_t bits = row[w];
+                while (bits) {
+                    int x = w * 64 + BitUtils::countTrailingZeros(bits);
+                    m_collisionBoxes.emplace_back(static_cast<float>(x * m_tileWidth), static_cast<float>(y * m_tileHeight),
+                        static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
+                    bits &= bits - 1;
                 }
             }
         }
+        m_collisionBoxesDirty = false;
     }
+    return m_collisionBoxes;
+}
 
-    return collisions;
+int Tilemap::getCollisionWordsPerRow() const {
+    return m_collisionWordsPerRow;
 }
 
-void Tilemap::update(float dt) {}
+const std::uint64_t* Tilemap::getCollisionRow(int y) const {
+    return &m_collisionBits[static_cast<std::size_t>(y) * m_collisionWordsPerRow];
+}
 
-void Tilemap::render(sf::RenderWindow& window) {
-    sf::FloatRect viewRect = window.getView().getViewport();
-    viewRect.left = window.getView().getCenter().x - window.getView().getSize().x / 2.0f;
-    viewRect.top = window.getView().getCenter().y - window.getView().getSize().y / 2.0f;
-    viewRect.width = window.getView().getSize().x;
-    viewRect.height = window.getView().getSize().y;
+void Tilemap::setCollisionListener(const CollisionListener& listener) {
+    m_collisionListener = listener;
+}
+
+// Walks the tiles the ray crosses, in order, calling visitor(x, y, t, normal)
+// with the distance t at which the ray enters each one, until it returns
+// true. The ray is first clipped to the map so it never steps outside it.
+template <typename Visitor>
+bool Tilemap::traverseRay(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance, Visitor visitor) const {
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length <= 0.f || maxDistance < 0.f || m_width <= 0 || m_height <= 0) return false;
+
+    float dir[2] = { direction.x / length, direction.y / length };
+    float start[2] = { origin.x, origin.y };
+    float extent[2] = { static_cast<float>(m_width * m_tileWidth), static_cast<float>(m_height * m_tileHeight) };
+
+    float tEnter = 0.f;
+    float tExit = maxDistance;
+    int enterAxis = -1;
+    for (int axis = 0; axis < 2; ++axis) {
+        if (dir[axis] == 0.f) {
+            if (start[axis] < 0.f || start[axis] >= extent[axis]) return false;
+            continue;
+        }
 
-    if (viewRect != m_lastViewRect) {
-        updateVisibleTiles(viewRect);
-        m_lastViewRect = viewRect;
+        float t0 = -start[axis] / dir[axis];
+        float t1 = (extent[axis] - start[axis]) / dir[axis];
+        if (std::min(t0, t1) > tEnter) {
+            tEnter = std::min(t0, t1);
+            enterAxis = axis;
+        }
+        tExit = std::min(tExit, std::max(t0, t1));
+    }
+    if (tEnter > tExit) return false;
+
+    float size[2] = { static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight) };
+    int limit[2] = { m_width, m_height };
+    int cell[2];
+    int step[2];
+    float tMax[2];
+    float tDelta[2];
+
+    for (int axis = 0; axis < 2; ++axis) {
+        float entry = start[axis] + dir[axis] * tEnter;
+        cell[axis] = std::max(0, std::min(limit[axis] - 1, static_cast<int>(std::floor(entry / size[axis]))));
+
+        if (dir[axis] > 0.f) {
+            step[axis] = 1;
+            tMax[axis] = ((cell[axis] + 1) * size[axis] - start[axis]) / dir[axis];
+            tDelta[axis] = size[axis] / dir[axis];
+        }
+        else if (dir[axis] < 0.f) {
+            step[axis] = -1;
+            tMax[axis] = (cell[axis] * size[axis] - start[axis]) / dir[axis];
+            tDelta[axis] = -size[axis] / dir[axis];
+        }
+        else {
+            step[axis] = 0;
+            tMax[axis] = std::numeric_limits<float>::infinity();
+            tDelta[axis] = std::numeric_limits<float>::infinity();
+        }
     }
 
-    if (m_tilesetTexture) {
-        sf::VertexArray visibleVertices(sf::Quads);
+    // A ray starting outside the map enters through the face it was clipped on.
+    sf::Vector2i normal(0, 0);
+    if (enterAxis == 0) normal.x = -step[0];
+    if (enterAxis == 1) normal.y = -step[1];
 
-        for (const auto& tilePos : m_visibleTiles) {
-            int x = tilePos.x;
-            int y = tilePos.y;
-            int tileId = m_tiles[y][x].id;
+    float t = tEnter;
+    while (true) {
+        if (visitor(cell[0], cell[1], t, normal)) {
+            return true;
+        }
 
-            if (tileId >= 0) {
-                int index = (y * m_width + x) * 4;
+        int axis = tMax[0] < tMax[1] ? 0 : 1;
+        t = tMax[axis];
+        if (t > tExit) return false;
 
-                visibleVertices.append(m_vertices[index]);
-                visibleVertices.append(m_vertices[index + 1]);
-                visibleVertices.append(m_vertices[index + 2]);
-                visibleVertices.append(m_vertices[index + 3]);
-            }
+        cell[axis] += step[axis];
+        if (cell[axis] < 0 || cell[axis] >= limit[axis]) return false;
+
+        tMax[axis] += tDelta[axis];
+        normal = axis == 0 ? sf::Vector2i(-step[0], 0) : sf::Vector2i(0, -step[1]);
+    }
+}
+
+bool Tilemap::raycast(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance, RaycastHit* hit) const {
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+
+    return traverseRay(origin, direction, maxDistance, [&](int x, int y, float t, const sf::Vector2i& normal) {
+        if (!isCollisionBitSet(x, y)) return false;
+
+        if (hit) {
+            hit->tile = sf::Vector2i(x, y);
+            hit->point = origin + direction * (t / length);
+            hit->normal = normal;
+            hit->distance = t;
         }
+        return true;
+        });
+}
+
+bool Tilemap::hasLineOfSight(const sf::Vector2f& from, const sf::Vector2f& to) const {
+    m_lineOfSightQueries++;
 
-        sf::RenderStates states;
-        states.texture = m_tilesetTexture;
-        window.draw(visibleVertices, states);
+    sf::Vector2i a(static_cast<int>(std::floor(from.x / m_tileWidth)), static_cast<int>(std::floor(from.y / m_tileHeight)));
+    sf::Vector2i b(static_cast<int>(std::floor(to.x / m_tileWidth)), static_cast<int>(std::floor(to.y / m_tileHeight)));
+    if (a == b) return true;
+
+    // The pair is ordered so that a->b and b->a share an entry and a result.
+    auto packTile = [](const sf::Vector2i& tile) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint16_t>(tile.y)) << 16) | static_cast<std::uint16_t>(tile.x);
+    };
+    if (packTile(b) < packTile(a)) std::swap(a, b);
+    std::uint64_t key = (packTile(a) << 32) | packTile(b);
+
+    LineOfSightEntry& entry = m_lineOfSightCache[(key * 0x9E3779B97F4A7C15ull) >> (64 - LineOfSightCacheBits)];
+    if (entry.generation == m_lineOfSightGeneration && entry.key == key) {
+        m_lineOfSightCacheHits++;
+        return entry.visible;
+    }
 
-        sf::RectangleShape collisionTile;
-        collisionTile.setSize(sf::Vector2f(m_tileWidth, m_tileHeight));
-        collisionTile.setFillColor(sf::Color(255, 0, 0, 100));
+    sf::Vector2f start((a.x + 0.5f) * m_tileWidth, (a.y + 0.5f) * m_tileHeight);
+    sf::Vector2f end((b.x + 0.5f) * m_tileWidth, (b.y + 0.5f) * m_tileHeight);
+    sf::Vector2f delta = end - start;
+    float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
 
-        for (int y = 0; y < m_height; y++) {
-            for (int x = 0; x < m_width; x++) {
-                if (isTileCollidable(x, y)) {
-                    collisionTile.setPosition(x * m_tileWidth, y * m_tileHeight);
-                    window.draw(collisionTile);
+    bool blocked = traverseRay(start, delta, distance, [&](int x, int y, float, const sf::Vector2i&) {
+        if ((x == a.x && y == a.y) || (x == b.x && y == b.y)) return false;
+        return isCollisionBitSet(x, y);
+        });
+
+    entry.key = key;
+    entry.generation = m_lineOfSightGeneration;
+    entry.visible = !blocked;
+    return entry.visible;
+}
+
+std::size_t Tilemap::getLastLineOfSightQueryCount() const {
+    return m_lastLineOfSightQueries;
+}
+
+std::size_t Tilemap::getLastLineOfSightCacheHits() const {
+    return m_lastLineOfSightCacheHits;
+}
+
+void Tilemap::update(float dt) {
+    m_lastLineOfSightQueries = m_lineOfSightQueries;
+    m_lastLineOfSightCacheHits = m_lineOfSightCacheHits;
+    m_lineOfSightQueries = 0;
+    m_lineOfSightCacheHits = 0;
+    m_lineOfSightGeneration++;
+}
+
+void Tilemap::render(sf::RenderWindow& window) {
+    const sf::View& view = window.getView();
+    sf::FloatRect viewRect(
+        view.getCenter().x - view.getSize().x / 2.0f,
+        view.getCenter().y - view.getSize().y / 2.0f,
+        view.getSize().x,
+        view.getSize().y);
+
+    m_lastDrawCalls = 0;
+    m_lastVisibleChunks = 0;
+
+    if (m_chunks.empty() || m_tileWidth <= 0 || m_tileHeight <= 0) return;
+
+    float chunkPixelWidth = static_cast<float>(ChunkSize * m_tileWidth);
+    float chunkPixelHeight = static_cast<float>(ChunkSize * m_tileHeight);
+
+    int firstX = std::max(0, static_cast<int>(std::floor(viewRect.left / chunkPixelWidth)));
+    int firstY = std::max(0, static_cast<int>(std::floor(viewRect.top / chunkPixelHeight)));
+    int lastX = std::min(m_chunksX - 1, static_cast<int>(std::floor((viewRect.left + viewRect.width) / chunkPixelWidth)));
+    int lastY = std::min(m_chunksY - 1, static_cast<int>(std::floor((viewRect.top + viewRect.height) / chunkPixelHeight)));
+
+    sf::RenderStates tileStates;
+    tileStates.texture = m_tilesetTexture;
+
+    for (int cy = firstY; cy <= lastY; ++cy) {
+        for (int cx = firstX; cx <= lastX; ++cx) {
+            TileChunk& chunk = m_chunks[cy * m_chunksX + cx];
+            m_lastVisibleChunks++;
+
+            if (m_tilesetTexture) {
+                if (chunk.dirty) {
+                    rebuildChunk(chunk, cx, cy);
                 }
+                drawChunk(window, chunk.vertices, chunk.buffer, tileStates);
+            }
+        }
+    }
+
+    if (!m_showCollisionOverlay) return;
+
+    for (int cy = firstY; cy <= lastY; ++cy) {
+        for (int cx = firstX; cx <= lastX; ++cx) {
+            TileChunk& chunk = m_chunks[cy * m_chunksX + cx];
+            if (chunk.overlayDirty) {
+                rebuildChunkOverlay(chunk, cx, cy);
             }
+            drawChunk(window, chunk.overlayVertices, chunk.overlayBuffer, sf::RenderStates::Default);
         }
     }
 }
 
-void Tilemap::clear() {
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            m_tiles[y][x].id = -1;
-            m_tiles[y][x].collidable = false;
-            m_tiles[y][x].type = "";
-            m_tiles[y][x].properties.clear();
+void Tilemap::setShowCollisionOverlay(bool show) {
+    m_showCollisionOverlay = show;
+}
+
+bool Tilemap::isShowingCollisionOverlay() const {
+    return m_showCollisionOverlay;
+}
+
+std::size_t Tilemap::getLastDrawCallCount() const {
+    return m_lastDrawCalls;
+}
+
+std::size_t Tilemap::getLastVisibleChunkCount() const {
+    return m_lastVisibleChunks;
+}
+
+std::size_t Tilemap::getChunkCount() const {
+    return m_chunks.size();
+}
+
+std::size_t Tilemap::getStorageChunkCount() const {
+    return m_storage.size();
+}
+
+std::size_t Tilemap::getAllocatedStorageChunkCount() const {
+    return static_cast<std::size_t>(std::count_if(m_storage.begin(), m_storage.end(),
+        [](const std::unique_ptr<TileStorageChunk>& chunk) { return chunk != nullptr; }));
+}
+
+std::size_t Tilemap::getStorageBytes() const {
+    std::size_t bytes = m_storage.capacity() * sizeof(std::unique_ptr<TileStorageChunk>) +
+        getAllocatedStorageChunkCount() * sizeof(TileStorageChunk);
+    for (const auto& entry : m_tileProperties) {
+        bytes += sizeof(entry) + entry.second.type.capacity();
+        for (const auto& property : entry.second.properties) {
+            bytes += sizeof(property) + property.capacity();
         }
     }
+    return bytes;
+}
+
+void Tilemap::clear() {
+    for (auto& chunk : m_storage) {
+        chunk.reset();
+    }
+    m_tileProperties.clear();
+
+    std::fill(m_collisionBits.begin(), m_collisionBits.end(), 0);
+    m_collisionBoxesDirty = true;
+    m_lineOfSightGeneration++;
+    markAllChunksDirty();
+
+    if (m_collisionListener) {
+        m_collisionListener(0, m_height - 1);
+    }
+}
+
+bool Tilemap::inBounds(int x, int y) const {
+    return x >= 0 && x < m_width && y >= 0 && y < m_height;
+}
+
+std::uint64_t Tilemap::propertyKey(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32) | static_cast<std::uint32_t>(x);
+}
 
-    m_collisionBoxes.clear();
-    rebuildVertexArray();
+const Tilemap::TileStorageChunk* Tilemap::findStorage(int x, int y, int& cell) const {
+    cell = (y % StorageChunkSize) * StorageChunkSize + (x % StorageChunkSize);
+    return m_storage[(y / StorageChunkSize) * m_storageChunksX + (x / StorageChunkSize)].get();
 }
 
-void Tilemap::rebuildVertexArray() {
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            int tileId = m_tiles[y][x].id;
-            int index = (y * m_width + x) * 4;
+Tilemap::TileStorageChunk* Tilemap::findOrCreateStorage(int x, int y, int& cell) {
+    cell = (y % StorageChunkSize) * StorageChunkSize + (x % StorageChunkSize);
 
-            m_vertices[index].position = sf::Vector2f(x * m_tileWidth, y * m_tileHeight);
-            m_vertices[index + 1].position = sf::Vector2f((x + 1) * m_tileWidth, y * m_tileHeight);
-            m_vertices[index + 2].position = sf::Vector2f((x + 1) * m_tileWidth, (y + 1) * m_tileHeight);
-            m_vertices[index + 3].position = sf::Vector2f(x * m_tileWidth, (y + 1) * m_tileHeight);
+    std::unique_ptr<TileStorageChunk>& chunk = m_storage[(y / StorageChunkSize) * m_storageChunksX + (x / StorageChunkSize)];
+    if (!chunk) {
+        chunk = std::make_unique<TileStorageChunk>();
+    }
+    return chunk.get();
+}
 
-            if (tileId >= 0 && m_tilesetTexture) {
-                sf::Vector2i texCoords = getTilesetCoords(tileId);
+void Tilemap::releaseStorageIfUnused(int x, int y) {
+    std::unique_ptr<TileStorageChunk>& chunk = m_storage[(y / StorageChunkSize) * m_storageChunksX + (x / StorageChunkSize)];
+    if (chunk && chunk->usedCount == 0) {
+        chunk.reset();
+    }
+}
 
-                m_vertices[index].texCoords = sf::Vector2f(texCoords.x, texCoords.y);
-                m_vertices[index + 1].texCoords = sf::Vector2f(texCoords.x + m_tileWidth, texCoords.y);
-                m_vertices[index + 2].texCoords = sf::Vector2f(texCoords.x + m_tileWidth, texCoords.y + m_tileHeight);
-                m_vertices[index + 3].texCoords = sf::Vector2f(texCoords.x, texCoords.y + m_tileHeight);
+// Blocks are moved into the new grid as they are; tiles are only visited in
+// the blocks that straddle the new edge, to clear what fell outside it.
+void Tilemap::resizeStorage(int width, int height) {
+    int chunksX = (width + StorageChunkSize - 1) / StorageChunkSize;
+    int chunksY = (height + StorageChunkSize - 1) / StorageChunkSize;
+
+    std::vector<std::unique_ptr<TileStorageChunk>> storage(static_cast<std::size_t>(chunksX) * chunksY);
+    for (int cy = 0; cy < std::min(chunksY, m_storageChunksY); ++cy) {
+        for (int cx = 0; cx < std::min(chunksX, m_storageChunksX); ++cx) {
+            std::unique_ptr<TileStorageChunk> chunk = std::move(m_storage[cy * m_storageChunksX + cx]);
+            if (!chunk) continue;
+
+            int endX = width - cx * StorageChunkSize;
+            int endY = height - cy * StorageChunkSize;
+            if (endX < StorageChunkSize || endY < StorageChunkSize) {
+                for (int y = 0; y < StorageChunkSize; ++y) {
+                    for (int x = 0; x < StorageChunkSize; ++x) {
+                        int cell = y * StorageChunkSize + x;
+                        bool used = chunk->ids[cell] != EmptyTileId || chunk->flags[cell] != 0;
+                        if (used && (x >= endX || y >= endY)) {
+                            chunk->ids[cell] = EmptyTileId;
+                            chunk->flags[cell] = 0;
+                            chunk->usedCount--;
+                        }
+                    }
+                }
+                if (chunk->usedCount == 0) continue;
             }
-            else {
-                m_vertices[index].texCoords = sf::Vector2f(0, 0);
-                m_vertices[index + 1].texCoords = sf::Vector2f(0, 0);
-                m_vertices[index + 2].texCoords = sf::Vector2f(0, 0);
-                m_vertices[index + 3].texCoords = sf::Vector2f(0, 0);
+            storage[cy * chunksX + cx] = std::move(chunk);
+        }
+    }
+
+    m_storage = std::move(storage);
+    m_storageChunksX = chunksX;
+    m_storageChunksY = chunksY;
+
+    for (auto it = m_tileProperties.begin(); it != m_tileProperties.end();) {
+        int x = static_cast<int>(it->first & 0xFFFFFFFFu);
+        int y = static_cast<int>(it->first >> 32);
+        it = (x < width && y < height) ? std::next(it) : m_tileProperties.erase(it);
+    }
+}
+
+void Tilemap::setCollisionBit(int x, int y, bool collidable) {
+    std::uint64_t& word = m_collisionBits[static_cast<std::size_t>(y) * m_collisionWordsPerRow + (x >> 6)];
+    std::uint64_t bit = 1ull << (x & 63);
+    word = collidable ? (word | bit) : (word & ~bit);
+    m_collisionBoxesDirty = true;
+    m_lineOfSightGeneration++;
+}
+
+// The bitset's row stride depends on the width, so it is laid out again
+// from the storage blocks' flags whenever the map is resized.
+void Tilemap::rebuildCollisionBits() {
+    m_collisionWordsPerRow = (m_width + 63) / 64;
+    m_collisionBits.assign(static_cast<std::size_t>(m_collisionWordsPerRow) * m_height, 0);
+    m_collisionBoxesDirty = true;
+    m_lineOfSightGeneration++;
+
+    for (int cy = 0; cy < m_storageChunksY; ++cy) {
+        for (int cx = 0; cx < m_storageChunksX; ++cx) {
+            const TileStorageChunk* chunk = m_storage[cy * m_storageChunksX + cx].get();
+            if (!chunk) continue;
+
+            for (int cell = 0; cell < StorageChunkArea; ++cell) {
+                if (chunk->flags[cell] & TileCollidable) {
+                    setCollisionBit(cx * StorageChunkSize + cell % StorageChunkSize,
+                        cy * StorageChunkSize + cell / StorageChunkSize, true);
+                }
             }
         }
     }
 }
 
-void Tilemap::updateVisibleTiles(const sf::FloatRect& viewRect) {
-    m_visibleTiles.clear();
+void Tilemap::resetChunks() {
+    m_chunksX = (m_width + ChunkSize - 1) / ChunkSize;
+    m_chunksY = (m_height + ChunkSize - 1) / ChunkSize;
 
-    sf::Vector2i topLeft = worldToTile(viewRect.left, viewRect.top);
-    sf::Vector2i bottomRight = worldToTile(viewRect.left + viewRect.width, viewRect.top + viewRect.height);
+    m_chunks.clear();
+    m_chunks.resize(static_cast<std::size_t>(m_chunksX) * m_chunksY);
+}
 
-    topLeft.x = std::max(0, topLeft.x - 1);
-    topLeft.y = std::max(0, topLeft.y - 1);
-    bottomRight.x = std::min(m_width - 1, bottomRight.x + 1);
-    bottomRight.y = std::min(m_height - 1, bottomRight.y + 1);
+void Tilemap::markAllChunksDirty() {
+    for (auto& chunk : m_chunks) {
+        chunk.dirty = true;
+        chunk.overlayDirty = true;
+    }
+}
 
-    for (int y = topLeft.y; y <= bottomRight.y; ++y) {
-        for (int x = topLeft.x; x <= bottomRight.x; ++x) {
-            if (m_tiles[y][x].id >= 0) {
-                m_visibleTiles.emplace_back(x, y);
-            }
+void Tilemap::markChunkDirty(int x, int y, bool overlay) {
+    int index = (y / ChunkSize) * m_chunksX + (x / ChunkSize);
+    if (index < 0 || index >= static_cast<int>(m_chunks.size())) return;
+
+    if (overlay) {
+        m_chunks[index].overlayDirty = true;
+    }
+    else {
+        m_chunks[index].dirty = true;
+    }
+}
+
+void Tilemap::rebuildChunk(TileChunk& chunk, int chunkX, int chunkY) {
+    chunk.vertices.clear();
+
+    int startX = chunkX * ChunkSize;
+    int startY = chunkY * ChunkSize;
+    int endX = std::min(startX + ChunkSize, m_width);
+    int endY = std::min(startY + ChunkSize, m_height);
+
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            int tileId = getTile(x, y);
+            if (tileId < 0) continue;
+
+            sf::Vector2i texCoords = getTilesetCoords(tileId);
+            float left = static_cast<float>(x * m_tileWidth);
+            float top = static_cast<float>(y * m_tileHeight);
+            float u = static_cast<float>(texCoords.x);
+            float v = static_cast<float>(texCoords.y);
+
+            chunk.vertices.emplace_back(sf::Vector2f(left, top), sf::Vector2f(u, v));
+            chunk.vertices.emplace_back(sf::Vector2f(left + m_tileWidth, top), sf::Vector2f(u + m_tileWidth, v));
+            chunk.vertices.emplace_back(sf::Vector2f(left + m_tileWidth, top + m_tileHeight), sf::Vector2f(u + m_tileWidth, v + m_tileHeight));
+            chunk.vertices.emplace_back(sf::Vector2f(left, top + m_tileHeight), sf::Vector2f(u, v + m_tileHeight));
         }
     }
+
+    if (m_useVertexBuffers) {
+        if (chunk.buffer.getVertexCount() != chunk.vertices.size()) {
+            chunk.buffer.create(chunk.vertices.size());
+        }
+        if (!chunk.vertices.empty()) {
+            chunk.buffer.update(chunk.vertices.data());
+        }
+    }
+
+    chunk.dirty = false;
+}
+
+void Tilemap::rebuildChunkOverlay(TileChunk& chunk, int chunkX, int chunkY) {
+    chunk.overlayVertices.clear();
+
+    const sf::Color overlayColor(255, 0, 0, 100);
+
+    int startX = chunkX * ChunkSize;
+    int startY = chunkY * ChunkSize;
+    int endX = std::min(startX + ChunkSize, m_width);
+    int endY = std::min(startY + ChunkSize, m_height);
+
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            if (!isTileCollidable(x, y)) continue;
+
+            float left = static_cast<float>(x * m_tileWidth);
+            float top = static_cast<float>(y * m_tileHeight);
+
+            chunk.overlayVertices.emplace_back(sf::Vector2f(left, top), overlayColor);
+            chunk.overlayVertices.emplace_back(sf::Vector2f(left + m_tileWidth, top), overlayColor);
+            chunk.overlayVertices.emplace_back(sf::Vector2f(left + m_tileWidth, top + m_tileHeight), overlayColor);
+            chunk.overlayVertices.emplace_back(sf::Vector2f(left, top + m_tileHeight), overlayColor);
+        }
+    }
+
+    if (m_useVertexBuffers) {
+        if (chunk.overlayBuffer.getVertexCount() != chunk.overlayVertices.size()) {
+            chunk.overlayBuffer.create(chunk.overlayVertices.size());
+        }
+        if (!chunk.overlayVertices.empty()) {
+            chunk.overlayBuffer.update(chunk.overlayVertices.data());
+        }
+    }
+
+    chunk.overlayDirty = false;
+}
+
+void Tilemap::drawChunk(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices,
+    const sf::VertexBuffer& buffer, const sf::RenderStates& states) {
+    if (vertices.empty()) return;
+
+    if (m_useVertexBuffers) {
+        target.draw(buffer, states);
+    }
+    else {
+        target.draw(vertices.data(), vertices.size(), sf::Quads, states);
+    }
+
+    m_lastDrawCalls++;
 }
 
 sf::Vector2i Tilemap::getTilesetCoords(int id) const {
@@ -0,0 +1,293 @@
+#include "TriggerVolumeSystem.h"
+#include "Entity.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Grid cells a rectangle spans, before any clamping to the grid.
+    sf::IntRect spannedCells(const sf::FloatRect& bounds, int cellSize) {
+        int left = static_cast<int>(std::floor(bounds.left / cellSize));
+        int top = static_cast<int>(std::floor(bounds.top / cellSize));
+        int right = static_cast<int>(std::floor((bounds.left + bounds.width) / cellSize));
+        int bottom = static_cast<int>(std::floor((bounds.top + bounds.height) / cellSize));
+        return sf::IntRect(left, top, right - left + 1, bottom - top + 1);
+    }
+}
+
+TriggerVolumeSystem::TriggerVolumeSystem()
+    : m_gridOrigin(0, 0),
+    m_columns(0),
+    m_rows(0),
+    m_gridDirty(false),
+    m_visitStamp(0),
+    m_lastTestedCount(0)
+{
+}
+
+int TriggerVolumeSystem::addVolume(Entity* owner, const sf::FloatRect& bounds) {
+    if (!owner) return -1;
+
+    int id;
+    if (!m_freeVolumes.empty()) {
+        id = m_freeVolumes.back();
+        m_freeVolumes.pop_back();
+        m_volumes[id] = { bounds, owner };
+    }
+    else {
+        id = static_cast<int>(m_volumes.size());
+        m_volumes.push_back({ bounds, owner });
+    }
+
+    m_gridDirty = true;
+    return id;
+}
+
+void TriggerVolumeSystem::removeVolume(int id) {
+    if (id < 0 || id >= static_cast<int>(m_volumes.size()) || !m_volumes[id].owner) return;
+
+    m_volumes[id].owner = nullptr;
+    m_freeVolumes.push_back(id);
+    m_gridDirty = true;
+
+    for (auto& activator : m_activators) {
+        auto it = std::lower_bound(activator.inside.begin(), activator.inside.end(), id);
+        if (it != activator.inside.end() && *it == id) {
+            activator.inside.erase(it);
+        }
+    }
+}
+
+void TriggerVolumeSystem::moveVolume(int id, const sf::FloatRect& bounds) {
+    if (id < 0 || id >= static_cast<int>(m_volumes.size()) || !m_volumes[id].owner) return;
+
+    // Activators keep the volume in their inside lists; the next update()
+    // reports an exit if it moved away from them.
+    Volume& volume = m_volumes[id];
+    if (spannedCells(volume.bounds, CellSize) != spannedCells(bounds, CellSize)) {
+        m_gridDirty = true;
+    }
+    volume.bounds = bounds;
+}
+
+void TriggerVolumeSystem::removeVolumesOf(Entity* owner) {
+    if (!owner) return;
+
+    for (int id = 0; id < static_cast<int>(m_volumes.size()); ++id) {
+        if (m_volumes[id].owner == owner) {
+            removeVolume(id);
+        }
+    }
+    removeActivator(owner);
+}
+
+void TriggerVolumeSystem::addActivator(Entity* entity) {
+    if (!entity) return;
+
+    for (const auto& activator : m_activators) {
+        if (activator.entity == entity) return;
+    }
+    m_activators.push_back({ entity, {} });
+}
+
+void TriggerVolumeSystem::removeActivator(Entity* entity) {
+    auto it = std::find_if(m_activators.begin(), m_activators.end(),
+        [entity](const Activator& activator) { return activator.entity == entity; });
+    if (it == m_activators.end()) return;
+
+    // Taken out before the callbacks so they cannot see it half removed.
+    std::vector<int> inside;
+    inside.swap(it->inside);
+    m_activators.erase(it);
+
+    for (int id : inside) {
+        if (Entity* owner = m_volumes[id].owner) {
+            owner->onTriggerExit(entity);
+        }
+    }
+}
+
+void TriggerVolumeSystem::build() {
+    rebuildGrid();
+}
+
+void TriggerVolumeSystem::clear() {
+    m_volumes.clear();
+    m_freeVolumes.clear();
+    m_activators.clear();
+    m_cellStart.clear();
+    m_cellVolumes.clear();
+    m_columns = 0;
+    m_rows = 0;
+    m_gridDirty = false;
+}
+
+void TriggerVolumeSystem::update() {
+    if (m_gridDirty) {
+        rebuildGrid();
+    }
+
+    m_lastTestedCount = 0;
+    m_entered.clear();
+    m_exited.clear();
+
+    for (auto& activator : m_activators) {
+        std::vector<int>& inside = activator.inside;
+        if (!activator.entity->isActive()) {
+            for (int id : inside) {
+                m_exited.push_back({ id, m_volumes[id].owner, activator.entity });
+            }
+            inside.clear();
+            continue;
+        }
+
+        queryOverlaps(activator.entity->getBounds());
+        std::sort(m_overlaps.begin(), m_overlaps.end());
+
+        std::size_t i = 0, j = 0;
+        while (i < m_overlaps.size() || j < inside.size()) {
+            if (j == inside.size() || (i < m_overlaps.size() && m_overlaps[i] < inside[j])) {
+                int id = m_overlaps[i++];
+                m_entered.push_back({ id, m_volumes[id].owner, activator.entity });
+            }
+            else if (i == m_overlaps.size() || inside[j] < m_overlaps[i]) {
+                int id = inside[j++];
+                m_exited.push_back({ id, m_volumes[id].owner, activator.entity });
+            }
+            else {
+                ++i;
+                ++j;
+            }
+        }
+        inside.swap(m_overlaps);
+    }
+
+    // Dispatched after the scan: a callback may add or remove volumes and
+    // activators, so each event is checked again before it is sent.
+    for (const auto& exit : m_exited) {
+        if (isLive(exit)) {
+            exit.owner->onTriggerExit(exit.activator);
+        }
+    }
+    for (const auto& enter : m_entered) {
+        if (isLive(enter)) {
+            enter.owner->onTriggerEnter(enter.activator);
+        }
+    }
+}
+
+bool TriggerVolumeSystem::isLive(const TriggerEvent& event) const {
+    if (event.volume >= static_cast<int>(m_volumes.size()) || m_volumes[event.volume].owner != event.owner) return false;
+
+    for (const auto& activator : m_activators) {
+        if (activator.entity == event.activator) return true;
+    }
+    return false;
+}
+
+void TriggerVolumeSystem::rebuildGrid() {
+    m_gridDirty = false;
+    m_cellStart.clear();
+    m_cellVolumes.clear();
+    m_columns = 0;
+    m_rows = 0;
+
+    bool empty = true;
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    for (const auto& volume : m_volumes) {
+        if (!volume.owner) continue;
+
+        const sf::FloatRect& b = volume.bounds;
+        if (empty) {
+            minX = b.left;
+            minY = b.top;
+            maxX = b.left + b.width;
+            maxY = b.top + b.height;
+            empty = false;
+        }
+        else {
+            minX = std::min(minX, b.left);
+            minY = std::min(minY, b.top);
+            maxX = std::max(maxX, b.left + b.width);
+            maxY = std::max(maxY, b.top + b.height);
+        }
+    }
+    if (empty) return;
+
+    m_gridOrigin = sf::Vector2i(static_cast<int>(std::floor(minX / CellSize)), static_cast<int>(std::floor(minY / CellSize)));
+    m_columns = static_cast<int>(std::floor(maxX / CellSize)) - m_gridOrigin.x + 1;
+    m_rows = static_cast<int>(std::floor(maxY / CellSize)) - m_gridOrigin.y + 1;
+
+    // Count, prefix-sum, then fill: two passes over the volumes.
+    m_cellStart.assign(static_cast<std::size_t>(m_columns) * m_rows + 1, 0);
+    for (const auto& volume : m_volumes) {
+        if (!volume.owner) continue;
+
+        sf::IntRect cells = getCellRange(volume.bounds);
+        for (int y = cells.top; y < cells.top + cells.height; ++y) {
+            for (int x = cells.left; x < cells.left + cells.width; ++x) {
+                m_cellStart[y * m_columns + x + 1]++;
+            }
+        }
+    }
+    for (std::size_t i = 1; i < m_cellStart.size(); ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    m_cellVolumes.resize(m_cellStart.back());
+    std::vector<int> next(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int id = 0; id < static_cast<int>(m_volumes.size()); ++id) {
+        if (!m_volumes[id].owner) continue;
+
+        sf::IntRect cells = getCellRange(m_volumes[id].bounds);
+        for (int y = cells.top; y < cells.top + cells.height; ++y) {
+            for (int x = cells.left; x < cells.left + cells.width; ++x) {
+                m_cellVolumes[next[y * m_columns + x]++] = id;
+            }
+        }
+    }
+
+    m_visitStamps.assign(m_volumes.size(), m_visitStamp);
+}
+
+sf::IntRect TriggerVolumeSystem::getCellRange(const sf::FloatRect& bounds) const {
+    int firstX = std::max(0, static_cast<int>(std::floor(bounds.left / CellSize)) - m_gridOrigin.x);
+    int firstY = std::max(0, static_cast<int>(std::floor(bounds.top / CellSize)) - m_gridOrigin.y);
+    int lastX = std::min(m_columns - 1, static_cast<int>(std::floor((bounds.left + bounds.width) / CellSize)) - m_gridOrigin.x);
+    int lastY = std::min(m_rows - 1, static_cast<int>(std::floor((bounds.top + bounds.height) / CellSize)) - m_gridOrigin.y);
+    return sf::IntRect(firstX, firstY, lastX - firstX + 1, lastY - firstY + 1);
+}
+
+void TriggerVolumeSystem::queryOverlaps(const sf::FloatRect& bounds) {
+    m_overlaps.clear();
+    if (m_columns == 0) return;
+
+    m_visitStamp++;
+    sf::IntRect cells = getCellRange(bounds);
+    for (int y = cells.top; y < cells.top + cells.height; ++y) {
+        for (int x = cells.left; x < cells.left + cells.width; ++x) {
+            int cell = y * m_columns + x;
+            for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                int id = m_cellVolumes[i];
+                if (m_visitStamps[id] == m_visitStamp) continue;
+                m_visitStamps[id] = m_visitStamp;
+
+                m_lastTestedCount++;
+                if (m_volumes[id].owner && m_volumes[id].bounds.intersects(bounds)) {
+                    m_overlaps.push_back(id);
+                }
+            }
+        }
+    }
+}
+
+std::size_t TriggerVolumeSystem::getVolumeCount() const {
+    return m_volumes.size() - m_freeVolumes.size();
+}
+
+std::size_t TriggerVolumeSystem::getCellCount() const {
+    return static_cast<std::size_t>(m_columns) * m_rows;
+}
+
+std::size_t TriggerVolumeSystem::getLastTestedCount() const {
+    return m_lastTestedCount;
+}
@@ -0,0 +1,399 @@
+#include "WorldStreamer.h"
+#include "TileLayerMesh.h"
+#include "TileAnimationSet.h"
+#include "RessourceManager.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    float distanceToRect(const sf::Vector2f& point, const sf::FloatRect& rect) {
+        float dx = std::max({ rect.left - point.x, 0.0f, point.x - (rect.left + rect.width) });
+        float dy = std::max({ rect.top - point.y, 0.0f, point.y - (rect.top + rect.height) });
+        return std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+WorldStreamer::StreamedLevel::StreamedLevel()
+    : success(false),
+    gridSize(0),
+    cellsX(0),
+    cellsY(0),
+    wordsPerRow(0)
+{
+}
+
+WorldStreamer::StreamedLevel::~StreamedLevel() = default;
+
+sf::FloatRect WorldStreamer::Section::getBounds() const {
+    return sf::FloatRect(offset.x, offset.y, static_cast<float>(info.pxWidth), static_cast<float>(info.pxHeight));
+}
+
+WorldStreamer::WorldStreamer(const std::filesystem::path& projectPath, const std::vector<LdtkLevelInfo>& levels, int homeIndex)
+    : m_projectPath(projectPath),
+    m_levels(levels),
+    m_homeIndex(homeIndex),
+    m_prefetchDistance(1280.0f),
+    m_loadDistance(640.0f),
+    m_evictDistance(1920.0f),
+    m_uploadBudget(sf::milliseconds(2)),
+    m_lastUploadTime(sf::Time::Zero),
+    m_evictedCount(0),
+    m_stopping(false)
+{
+    // Create the singleton here so the worker never races to construct it.
+    TileAnimationSet::getInstance();
+    m_worker = std::thread(&WorldStreamer::workerLoop, this);
+}
+
+WorldStreamer::~WorldStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_condition.notify_all();
+
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void WorldStreamer::update(const sf::Vector2f& focus) {
+    if (m_homeIndex < 0 || m_homeIndex >= static_cast<int>(m_levels.size())) return;
+
+    const LdtkLevelInfo& home = m_levels[m_homeIndex];
+
+    receiveCompleted();
+
+    for (int i = 0; i < static_cast<int>(m_levels.size()); ++i) {
+        if (i == m_homeIndex) continue;
+
+        const LdtkLevelInfo& info = m_levels[i];
+        sf::Vector2f offset(static_cast<float>(info.worldX - home.worldX), static_cast<float>(info.worldY - home.worldY));
+        sf::FloatRect bounds(offset.x, offset.y, static_cast<float>(info.pxWidth), static_cast<float>(info.pxHeight));
+        float distance = distanceToRect(focus, bounds);
+
+        Section* section = findSection(info.identifier);
+        if (!section && distance < m_prefetchDistance) {
+            requestSection(info, offset);
+        }
+        else if (section && distance > m_evictDistance) {
+            evictSection(section - m_sections.data());
+        }
+        else if (section && section->state == SectionState::Prefetched && distance < m_loadDistance) {
+            section->state = SectionState::Uploading;
+        }
+    }
+
+    uploadPending();
+}
+
+void WorldStreamer::render(sf::RenderTarget& target) {
+    for (auto& section : m_sections) {
+        if (section.state != SectionState::Ready) continue;
+
+        for (auto& mesh : section.data->meshes) {
+            mesh->render(target);
+        }
+    }
+}
+
+bool WorldStreamer::checkCollision(const sf::FloatRect& rect) const {
+    for (const auto& section : m_sections) {
+        // Only once the section is drawn, so nothing collides with unseen terrain.
+        if (section.state != SectionState::Ready || section.data->collision.empty()) continue;
+
+        const StreamedLevel& data = *section.data;
+        sf::FloatRect local(rect.left - section.offset.x, rect.top - section.offset.y, rect.width, rect.height);
+
+        int startX = std::max(0, static_cast<int>(local.left / data.gridSize));
+        int startY = std::max(0, static_cast<int>(local.top / data.gridSize));
+        int endX = std::min(data.cellsX - 1, static_cast<int>((local.left + local.width) / data.gridSize));
+        int endY = std::min(data.cellsY - 1, static_cast<int>((local.top + local.height) / data.gridSize));
+
+        for (int y = startY; y <= endY; ++y) {
+            const std::uint64_t* row = &data.collision[static_cast<std::size_t>(y) * data.wordsPerRow];
+            for (int x = startX; x <= endX; ++x) {
+                if (row[x / 64] & (std::uint64_t(1) << (x % 64))) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+sf::FloatRect WorldStreamer::extendBounds(const sf::FloatRect& bounds) const {
+    float left = bounds.left;
+    float top = bounds.top;
+    float right = bounds.left + bounds.width;
+    float bottom = bounds.top + bounds.height;
+
+    for (const auto& section : m_sections) {
+        if (section.state != SectionState::Ready) continue;
+
+        sf::FloatRect sectionBounds = section.getBounds();
+        left = std::min(left, sectionBounds.left);
+        top = std::min(top, sectionBounds.top);
+        right = std::max(right, sectionBounds.left + sectionBounds.width);
+        bottom = std::max(bottom, sectionBounds.top + sectionBounds.height);
+    }
+
+    return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+void WorldStreamer::requestSection(const LdtkLevelInfo& info, const sf::Vector2f& offset) {
+    Section section;
+    section.info = info;
+    section.offset = offset;
+    section.state = SectionState::Loading;
+    section.assetsAcquired = false;
+    section.nextMesh = 0;
+    section.uploadTime = sf::Time::Zero;
+    m_sections.push_back(std::move(section));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({ info.identifier, offset });
+    }
+    m_condition.notify_one();
+
+    std::cout << "Streaming in level " << info.identifier << std::endl;
+}
+
+void WorldStreamer::evictSection(std::size_t index) {
+    const std::string& identifier = m_sections[index].info.identifier;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+            [&identifier](const Job& job) { return job.identifier == identifier; }), m_jobs.end());
+    }
+
+    std::cout << "Evicting streamed level " << identifier << std::endl;
+
+    m_sections.erase(m_sections.begin() + index);
+    m_evictedCount++;
+}
+
+void WorldStreamer::receiveCompleted() {
+    std::vector<std::unique_ptr<StreamedLevel>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+    }
+
+    for (auto& result : completed) {
+        Section* section = findSection(result->identifier);
+
+        // Evicted (or already satisfied by an earlier request) while the
+        // worker was busy.
+        if (!section || section->state != SectionState::Loading) continue;
+
+        if (!result->success) {
+            std::cerr << "Failed to stream level " << result->identifier << std::endl;
+            section->state = SectionState::Failed;
+            continue;
+        }
+
+        std::cout << "Streamed level " << result->identifier << " decoded in "
+            << result->loadTime.asMilliseconds() << " ms" << std::endl;
+
+        section->pendingAssets = RessourceManager::getInstance()->prefetch(result->manifest);
+        section->data = std::move(result);
+        section->state = SectionState::Prefetched;
+    }
+}
+
+void WorldStreamer::uploadPending() {
+    sf::Clock budgetClock;
+
+    for (auto& section : m_sections) {
+        if (section.state != SectionState::Uploading || !acquireAssets(section)) continue;
+
+        while (budgetClock.getElapsedTime() < m_uploadBudget) {
+            sf::Clock stepClock;
+            bool more = uploadStep(section);
+            section.uploadTime += stepClock.getElapsedTime();
+
+            if (!more) {
+                std::cout << "Streamed level " << section.info.identifier << " ready, "
+                    << section.uploadTime.asMicroseconds() << " us of main-thread upload" << std::endl;
+                break;
+            }
+        }
+
+        if (budgetClock.getElapsedTime() >= m_uploadBudget) break;
+    }
+
+    m_lastUploadTime = budgetClock.getElapsedTime();
+}
+
+// Waits for the prefetched tilesets, then takes references to them so they
+// stay resident for as long as the section does.
+bool WorldStreamer::acquireAssets(Section& section) {
+    if (section.assetsAcquired) return true;
+
+    for (const auto& pending : section.pendingAssets) {
+        if (pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+    }
+
+    section.assets = RessourceManager::getInstance()->acquire(section.data->manifest);
+    section.pendingAssets.clear();
+    section.assetsAcquired = true;
+    return true;
+}
+
+bool WorldStreamer::uploadStep(Section& section) {
+    StreamedLevel& data = *section.data;
+
+    if (section.nextMesh < data.meshes.size()) {
+        TileLayerMesh& mesh = *data.meshes[section.nextMesh];
+        if (!mesh.getTexture()) {
+            mesh.setTexture(section.assets.findTexture(data.meshTilesets[section.nextMesh]));
+        }
+
+        mesh.uploadChunks(4);
+        if (mesh.isUploaded()) {
+            section.nextMesh++;
+        }
+        return true;
+    }
+
+    section.state = SectionState::Ready;
+    return false;
+}
+
+WorldStreamer::Section* WorldStreamer::findSection(const std::string& identifier) {
+    for (auto& section : m_sections) {
+        if (section.info.identifier == identifier) {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+
+void WorldStreamer::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        std::unique_ptr<StreamedLevel> result = loadLevel(job);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completed.push_back(std::move(result));
+    }
+}
+
+// Runs on the worker thread: no OpenGL, nothing from RessourceManager
+// beyond resourceExists(), and tile animations only under their lock.
+std::unique_ptr<WorldStreamer::StreamedLevel> WorldStreamer::loadLevel(const Job& job) const {
+    sf::Clock loadClock;
+
+    auto result = std::make_unique<StreamedLevel>();
+    result->identifier = job.identifier;
+
+    std::ifstream file(m_projectPath, std::ios::binary);
+    LdtkLevelData levelData;
+    if (!file.is_open() || !LdtkStreamParser::parse(file, job.identifier, levelData)) {
+        return result;
+    }
+
+    result->gridSize = levelData.collisionGridSize;
+    result->cellsX = levelData.collisionCellsX;
+    result->cellsY = levelData.collisionCellsY;
+    result->wordsPerRow = levelData.collisionWordsPerRow;
+    result->collision = std::move(levelData.collisionWords);
+
+    for (auto& layer : levelData.tileLayers) {
+        const LdtkTilesetInfo* tileset = levelData.findTileset(layer.tilesetDefUid);
+        if (!tileset) continue;
+
+        auto mesh = std::make_unique<TileLayerMesh>(layer.identifier, nullptr, tileset->tileGridSize, tileset->columns);
+        mesh->setOffset(job.offset + sf::Vector2f(static_cast<float>(layer.offsetX), static_cast<float>(layer.offsetY)));
+        mesh->setOpacity(layer.opacity);
+        {
+            const TileAnimationSet* animations = TileAnimationSet::getInstance();
+            std::unique_lock<std::mutex> animationsLock = animations->lock();
+            mesh->setAnimations(animations->find(tileset->identifier));
+            mesh->buildVertices(layer.tiles, layer.gridSize, layer.cellsX, layer.cellsY);
+        }
+
+        result->meshes.push_back(std::move(mesh));
+        result->meshTilesets.push_back(ResourceId(tileset->identifier));
+    }
+
+    for (const auto& tileset : levelData.tilesets) {
+        std::string path = resolveTilesetPath(tileset.relPath);
+        if (!path.empty()) {
+            result->manifest.add(AssetType::Texture, tileset.identifier, path);
+        }
+        else {
+            std::cerr << "Failed to load tileset texture: " << tileset.relPath << std::endl;
+        }
+    }
+
+    result->success = true;
+    result->loadTime = loadClock.getElapsedTime();
+    return result;
+}
+
+// Same lookup order as LevelLoader::addTilesetToManifest. resourceExists()
+// only reads state fixed at startup, so it is safe from the worker.
+std::string WorldStreamer::resolveTilesetPath(const std::string& relPath) const {
+    RessourceManager* resourceManager = RessourceManager::getInstance();
+    std::string fileName = std::filesystem::path(relPath).filename().string();
+    std::vector<std::string> searchPaths = {
+        relPath,
+        fileName,
+        "Textures/" + fileName,
+        "tilesets/" + fileName
+    };
+
+    for (const auto& path : searchPaths) {
+        if (resourceManager->resourceExists(path)) {
+            return path;
+        }
+    }
+    return std::string();
+}
+
+void WorldStreamer::setPrefetchDistance(float distance) {
+    m_prefetchDistance = distance;
+}
+
+void WorldStreamer::setLoadDistance(float distance) {
+    m_loadDistance = distance;
+}
+
+void WorldStreamer::setEvictDistance(float distance) {
+    m_evictDistance = distance;
+}
+
+void WorldStreamer::setUploadBudget(sf::Time budget) {
+    m_uploadBudget = budget;
+}
+
+std::size_t WorldStreamer::getSectionCount(SectionState state) const {
+    return std::count_if(m_sections.begin(), m_sections.end(),
+        [state](const Section& section) { return section.state == state; });
+}
+
+std::size_t WorldStreamer::getEvictedCount() const {
+    return m_evictedCount;
+}
+
+sf::Time WorldStreamer::getLastUploadTime() const {
+    return m_lastUploadTime;
+}
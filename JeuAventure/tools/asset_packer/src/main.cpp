@@ -0,0 +1,188 @@
+// asset_packer: packs every file under Ressources/ into one archive in the
+// format described in AssetArchiveFormat.h, storing identical files once.
+// RessourceManager maps the archive and loads assets from memory.
+//
+//     asset_packer <Ressources directory> [output.pak]
+
+#include "AssetArchiveFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    class StringTable {
+    private:
+        std::string m_data;
+
+    public:
+        std::uint32_t add(const std::string& value) {
+            std::uint32_t offset = static_cast<std::uint32_t>(m_data.size());
+            m_data.append(value);
+            m_data.push_back('\0');
+            return offset;
+        }
+
+        const std::string& getData() const { return m_data; }
+    };
+
+    struct SourceFile {
+        std::string path;
+        std::vector<std::uint8_t> contents;
+    };
+
+    bool readFile(const std::filesystem::path& path, std::vector<std::uint8_t>& contents) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input.is_open()) {
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: asset_packer <Ressources directory> [output.pak]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path inputDir = argv[1];
+    std::filesystem::path outputPath = (argc > 2) ? std::filesystem::path(argv[2])
+        : inputDir.lexically_normal().parent_path() / "Ressources.pak";
+
+    if (!std::filesystem::is_directory(inputDir)) {
+        std::cerr << "Not a directory: " << inputDir << std::endl;
+        return 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<AssetArchiveFormat::Entry> entries;
+    std::vector<AssetArchiveFormat::Blob> blobs;
+    std::vector<std::vector<std::uint8_t>> blobContents;
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> blobsByHash;
+    std::unordered_map<std::string, std::string> seenPaths;
+    StringTable strings;
+    std::uint64_t sourceBytes = 0;
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(inputDir)) {
+        if (item.is_regular_file() && item.path().extension() != ".pak") {
+            files.push_back(item.path());
+        }
+    }
+    // Deterministic output regardless of directory iteration order.
+    std::sort(files.begin(), files.end());
+
+    for (const auto& file : files) {
+        std::string relative = std::filesystem::relative(file, inputDir).generic_string();
+        std::string path = AssetArchiveFormat::normalizePath(relative);
+
+        auto seen = seenPaths.find(path);
+        if (seen != seenPaths.end()) {
+            std::cerr << "Skipping " << relative << ": same archive path as " << seen->second << std::endl;
+            continue;
+        }
+        seenPaths[path] = relative;
+
+        std::vector<std::uint8_t> contents;
+        if (!readFile(file, contents)) {
+            std::cerr << "Could not read " << file << std::endl;
+            return 1;
+        }
+        sourceBytes += contents.size();
+
+        std::uint64_t contentHash = AssetArchiveFormat::hashContent(contents.data(), contents.size());
+
+        std::uint32_t blobIndex = static_cast<std::uint32_t>(blobs.size());
+        bool duplicate = false;
+        for (std::uint32_t candidate : blobsByHash[contentHash]) {
+            if (blobContents[candidate] == contents) {
+                blobIndex = candidate;
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (!duplicate) {
+            AssetArchiveFormat::Blob blob;
+            blob.offset = 0;
+            blob.size = contents.size();
+            blob.contentHash = contentHash;
+            blobs.push_back(blob);
+            blobContents.push_back(std::move(contents));
+            blobsByHash[contentHash].push_back(blobIndex);
+        }
+
+        AssetArchiveFormat::Entry entry;
+        entry.pathHash = AssetArchiveFormat::hashPath(path);
+        entry.path = strings.add(path);
+        entry.blobIndex = blobIndex;
+        entry.reserved = 0;
+        entries.push_back(entry);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const AssetArchiveFormat::Entry& a, const AssetArchiveFormat::Entry& b) { return a.pathHash < b.pathHash; });
+
+    AssetArchiveFormat::Header header;
+    std::memcpy(header.magic, AssetArchiveFormat::Magic, sizeof(header.magic));
+    header.version = AssetArchiveFormat::Version;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+    header.entryTableOffset = static_cast<std::uint32_t>(alignUp(sizeof(header), 8));
+    header.blobCount = static_cast<std::uint32_t>(blobs.size());
+    header.blobTableOffset = static_cast<std::uint32_t>(alignUp(header.entryTableOffset + entries.size() * sizeof(AssetArchiveFormat::Entry), 8));
+    header.stringTableOffset = static_cast<std::uint32_t>(header.blobTableOffset + blobs.size() * sizeof(AssetArchiveFormat::Blob));
+    header.stringTableSize = static_cast<std::uint32_t>(strings.getData().size());
+
+    std::uint64_t offset = header.stringTableOffset + header.stringTableSize;
+    for (auto& blob : blobs) {
+        offset = alignUp(static_cast<std::size_t>(offset), AssetArchiveFormat::BlobAlignment);
+        blob.offset = offset;
+        offset += blob.size;
+    }
+    header.fileSize = offset;
+
+    std::vector<std::uint8_t> output(static_cast<std::size_t>(header.fileSize), 0);
+    std::memcpy(output.data(), &header, sizeof(header));
+    if (!entries.empty()) {
+        std::memcpy(output.data() + header.entryTableOffset, entries.data(), entries.size() * sizeof(AssetArchiveFormat::Entry));
+    }
+    if (!blobs.empty()) {
+        std::memcpy(output.data() + header.blobTableOffset, blobs.data(), blobs.size() * sizeof(AssetArchiveFormat::Blob));
+    }
+    std::memcpy(output.data() + header.stringTableOffset, strings.getData().data(), strings.getData().size());
+    for (std::size_t i = 0; i < blobs.size(); ++i) {
+        if (!blobContents[i].empty()) {
+            std::memcpy(output.data() + blobs[i].offset, blobContents[i].data(), blobContents[i].size());
+        }
+    }
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Could not write " << outputPath << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(output.data()), static_cast<std::streamsize>(output.size()));
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    std::uint64_t savedBytes = sourceBytes > header.fileSize ? sourceBytes - header.fileSize : 0;
+
+    std::cout << "Packed " << entries.size() << " files into " << blobs.size() << " unique blobs" << std::endl;
+    std::cout << "Source: " << sourceBytes / 1024 << " KB, archive: " << header.fileSize / 1024
+        << " KB (" << savedBytes / 1024 << " KB saved by deduplication)" << std::endl;
+    std::cout << "Wrote " << outputPath << " in " << elapsed.count() << " ms" << std::endl;
+    return 0;
+}
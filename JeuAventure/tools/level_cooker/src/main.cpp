@@ -0,0 +1,328 @@
+// level_cooker: converts an LDtk project (allData.json) into the binary
+// format described in CookedLevelFormat.h, which LevelLoader maps directly.
+//
+//     level_cooker <allData.json> [output.cooked]
+
+#include "CookedLevelFormat.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+    class StringTable {
+    private:
+        std::string m_data;
+        std::unordered_map<std::string, std::uint32_t> m_offsets;
+
+    public:
+        std::uint32_t add(const std::string& value) {
+            auto it = m_offsets.find(value);
+            if (it != m_offsets.end()) {
+                return it->second;
+            }
+
+            std::uint32_t offset = static_cast<std::uint32_t>(m_data.size());
+            m_data.append(value);
+            m_data.push_back('\0');
+            m_offsets[value] = offset;
+            return offset;
+        }
+
+        const std::string& getData() const { return m_data; }
+    };
+
+    class BinaryWriter {
+    private:
+        std::vector<std::uint8_t> m_data;
+
+    public:
+        std::uint32_t align(std::size_t alignment = 8) {
+            while (m_data.size() % alignment != 0) {
+                m_data.push_back(0);
+            }
+            return static_cast<std::uint32_t>(m_data.size());
+        }
+
+        std::uint32_t reserve(std::size_t bytes) {
+            std::uint32_t offset = align();
+            m_data.resize(m_data.size() + bytes, 0);
+            return offset;
+        }
+
+        std::uint32_t append(const void* source, std::size_t bytes) {
+            std::uint32_t offset = align();
+            const std::uint8_t* begin = static_cast<const std::uint8_t*>(source);
+            m_data.insert(m_data.end(), begin, begin + bytes);
+            return offset;
+        }
+
+        template <typename T>
+        std::uint32_t appendArray(const std::vector<T>& items) {
+            if (items.empty()) {
+                return align();
+            }
+            return append(items.data(), items.size() * sizeof(T));
+        }
+
+        template <typename T>
+        void write(std::uint32_t offset, const T& value) {
+            std::memcpy(m_data.data() + offset, &value, sizeof(T));
+        }
+
+        const std::vector<std::uint8_t>& getData() const { return m_data; }
+    };
+
+    struct CookStats {
+        std::size_t tiles = 0;
+        std::size_t solidCells = 0;
+        std::size_t entities = 0;
+    };
+
+    bool cookLevel(const json& levelData, int defaultGridSize,
+        const std::unordered_map<int, std::uint32_t>& tilesetIndices,
+        StringTable& strings, BinaryWriter& writer, CookedLevelFormat::Level& record, CookStats& stats) {
+        int gridSize = defaultGridSize;
+        int pxWidth = levelData["pxWid"];
+        int pxHeight = levelData["pxHei"];
+        int cellsX = (pxWidth + gridSize - 1) / gridSize;
+        int cellsY = (pxHeight + gridSize - 1) / gridSize;
+        int wordsPerRow = (cellsX + 63) / 64;
+
+        std::vector<std::uint64_t> collision(static_cast<std::size_t>(wordsPerRow) * cellsY, 0);
+        std::vector<CookedLevelFormat::Layer> layers;
+        std::vector<CookedLevelFormat::Entity> entities;
+
+        const json& layerInstances = levelData["layerInstances"];
+
+        for (const auto& layer : layerInstances) {
+            if (layer["__type"] != "IntGrid" || !layer.contains("intGridCsv")) continue;
+
+            int layerWidth = layer["__cWid"];
+            int layerHeight = layer["__cHei"];
+            const auto& values = layer["intGridCsv"];
+
+            for (int y = 0; y < layerHeight && y < cellsY; ++y) {
+                for (int x = 0; x < layerWidth && x < cellsX; ++x) {
+                    std::size_t idx = static_cast<std::size_t>(y) * layerWidth + x;
+                    if (idx < values.size() && values[idx].get<int>() > 0) {
+                        collision[static_cast<std::size_t>(y) * wordsPerRow + x / 64] |= (std::uint64_t(1) << (x % 64));
+                    }
+                }
+            }
+        }
+
+        for (auto word : collision) {
+            std::uint64_t bits = word;
+            while (bits) {
+                bits &= bits - 1;
+                stats.solidCells++;
+            }
+        }
+
+        // Bottom-up, matching the draw order LevelLoader uses for JSON.
+        for (auto it = layerInstances.rbegin(); it != layerInstances.rend(); ++it) {
+            const json& layer = *it;
+
+            if (layer["__type"] == "Entities") {
+                for (const auto& entity : layer["entityInstances"]) {
+                    CookedLevelFormat::Entity cookedEntity;
+                    int entityGrid = entity["__gridSize"];
+                    cookedEntity.identifier = strings.add(entity["__identifier"].get<std::string>());
+                    cookedEntity.x = entity["__grid"][0].get<int>() * entityGrid;
+                    cookedEntity.y = entity["__grid"][1].get<int>() * entityGrid;
+                    cookedEntity.width = entity.value("width", 16);
+                    cookedEntity.height = entity.value("height", 16);
+                    entities.push_back(cookedEntity);
+                }
+                continue;
+            }
+
+            if (layer["__type"] != "Tiles" || layer["__tilesetDefUid"].is_null()) continue;
+
+            const char* key = (layer.contains("gridTiles") && !layer["gridTiles"].empty()) ? "gridTiles" : "autoLayerTiles";
+            if (!layer.contains(key) || layer[key].empty()) continue;
+
+            auto tileset = tilesetIndices.find(layer["__tilesetDefUid"].get<int>());
+            if (tileset == tilesetIndices.end()) {
+                std::cerr << "Unknown tileset uid " << layer["__tilesetDefUid"] << " in layer "
+                    << layer["__identifier"] << std::endl;
+                return false;
+            }
+
+            int layerGrid = layer["__gridSize"];
+            std::vector<CookedLevelFormat::Tile> tiles;
+            tiles.reserve(layer[key].size());
+
+            for (const auto& tile : layer[key]) {
+                int tileId = tile["t"];
+                int cellX = tile["px"][0].get<int>() / layerGrid;
+                int cellY = tile["px"][1].get<int>() / layerGrid;
+
+                if (tileId < 0 || tileId > 0xFFFF || cellX < 0 || cellX > 0xFFFF || cellY < 0 || cellY > 0xFFFF) {
+                    std::cerr << "Tile out of range in layer " << layer["__identifier"] << std::endl;
+                    return false;
+                }
+
+                int f = tile.value("f", 0);
+
+                CookedLevelFormat::Tile cookedTile;
+                cookedTile.tileId = static_cast<std::uint16_t>(tileId);
+                cookedTile.cellX = static_cast<std::uint16_t>(cellX);
+                cookedTile.cellY = static_cast<std::uint16_t>(cellY);
+                cookedTile.flags = static_cast<std::uint8_t>(
+                    ((f & 1) ? CookedLevelFormat::TileFlipX : 0) | ((f & 2) ? CookedLevelFormat::TileFlipY : 0));
+                cookedTile.reserved = 0;
+                tiles.push_back(cookedTile);
+            }
+
+            CookedLevelFormat::Layer cookedLayer;
+            cookedLayer.identifier = strings.add(layer["__identifier"].get<std::string>());
+            cookedLayer.tilesetIndex = tileset->second;
+            cookedLayer.offsetX = layer.value("__pxTotalOffsetX", 0);
+            cookedLayer.offsetY = layer.value("__pxTotalOffsetY", 0);
+            cookedLayer.opacity = layer.value("__opacity", 1.0f);
+            cookedLayer.gridSize = layerGrid;
+            cookedLayer.cellsX = layer["__cWid"];
+            cookedLayer.cellsY = layer["__cHei"];
+            cookedLayer.tileOffset = writer.appendArray(tiles);
+            cookedLayer.tileCount = static_cast<std::uint32_t>(tiles.size());
+            layers.push_back(cookedLayer);
+
+            stats.tiles += tiles.size();
+        }
+
+        stats.entities += entities.size();
+
+        record.identifier = strings.add(levelData["identifier"].get<std::string>());
+        record.worldX = levelData.value("worldX", 0);
+        record.worldY = levelData.value("worldY", 0);
+        record.pxWidth = pxWidth;
+        record.pxHeight = pxHeight;
+        record.gridSize = gridSize;
+        record.cellsX = cellsX;
+        record.cellsY = cellsY;
+        record.collisionOffset = writer.appendArray(collision);
+        record.collisionWordsPerRow = wordsPerRow;
+        record.layerOffset = writer.appendArray(layers);
+        record.layerCount = static_cast<std::uint32_t>(layers.size());
+        record.entityOffset = writer.appendArray(entities);
+        record.entityCount = static_cast<std::uint32_t>(entities.size());
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: level_cooker <allData.json> [output.cooked]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path inputPath = argv[1];
+    std::filesystem::path outputPath = (argc > 2) ? std::filesystem::path(argv[2]) : inputPath;
+    if (argc <= 2) {
+        outputPath.replace_extension(".cooked");
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    json project;
+    try {
+        std::ifstream input(inputPath);
+        if (!input.is_open()) {
+            std::cerr << "Could not open " << inputPath << std::endl;
+            return 1;
+        }
+        input >> project;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to parse " << inputPath << ": " << e.what() << std::endl;
+        return 1;
+    }
+
+    StringTable strings;
+    BinaryWriter writer;
+    CookStats stats;
+
+    std::uint32_t headerOffset = writer.reserve(sizeof(CookedLevelFormat::Header));
+
+    try {
+        std::vector<CookedLevelFormat::Tileset> tilesets;
+        std::unordered_map<int, std::uint32_t> tilesetIndices;
+
+        for (const auto& tileset : project["defs"]["tilesets"]) {
+            if (tileset["relPath"].is_null()) continue;
+
+            CookedLevelFormat::Tileset cookedTileset;
+            cookedTileset.uid = tileset["uid"];
+            cookedTileset.identifier = strings.add(tileset["identifier"].get<std::string>());
+            cookedTileset.relPath = strings.add(tileset["relPath"].get<std::string>());
+            cookedTileset.tileSize = tileset["tileGridSize"];
+            cookedTileset.columns = tileset["__cWid"];
+
+            tilesetIndices[tileset["uid"].get<int>()] = static_cast<std::uint32_t>(tilesets.size());
+            tilesets.push_back(cookedTileset);
+        }
+
+        const json& levels = project["levels"];
+        int defaultGridSize = project["defaultGridSize"];
+
+        std::uint32_t tilesetTableOffset = writer.appendArray(tilesets);
+        std::uint32_t levelTableOffset = writer.reserve(levels.size() * sizeof(CookedLevelFormat::Level));
+
+        for (std::size_t i = 0; i < levels.size(); ++i) {
+            CookedLevelFormat::Level record;
+            if (!cookLevel(levels[i], defaultGridSize, tilesetIndices, strings, writer, record, stats)) {
+                return 1;
+            }
+            writer.write(levelTableOffset + static_cast<std::uint32_t>(i * sizeof(CookedLevelFormat::Level)), record);
+        }
+
+        std::string stringData = strings.getData();
+        if (stringData.empty()) {
+            stringData.push_back('\0');
+        }
+        std::uint32_t stringTableOffset = writer.append(stringData.data(), stringData.size());
+        writer.align();
+
+        CookedLevelFormat::Header header;
+        std::memcpy(header.magic, CookedLevelFormat::Magic, sizeof(header.magic));
+        header.version = CookedLevelFormat::Version;
+        header.fileSize = static_cast<std::uint32_t>(writer.getData().size());
+        header.defaultGridSize = defaultGridSize;
+        header.levelCount = static_cast<std::uint32_t>(levels.size());
+        header.levelTableOffset = levelTableOffset;
+        header.tilesetCount = static_cast<std::uint32_t>(tilesets.size());
+        header.tilesetTableOffset = tilesetTableOffset;
+        header.stringTableOffset = stringTableOffset;
+        header.stringTableSize = static_cast<std::uint32_t>(stringData.size());
+        writer.write(headerOffset, header);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected LDtk data in " << inputPath << ": " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream output(outputPath, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Could not write " << outputPath << std::endl;
+        return 1;
+    }
+    output.write(reinterpret_cast<const char*>(writer.getData().data()), writer.getData().size());
+    output.close();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "Cooked " << project["levels"].size() << " levels, " << stats.tiles << " tiles, "
+        << stats.solidCells << " solid cells, " << stats.entities << " entities -> " << outputPath
+        << " (" << writer.getData().size() << " bytes, " << elapsed.count() << " ms)" << std::endl;
+    return 0;
+}
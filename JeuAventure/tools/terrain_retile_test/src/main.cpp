@@ -0,0 +1,143 @@
+// terrain_retile_test: drives DestructibleTerrain over a small Tilemap and
+// two TileLayerMesh layers, then checks the tile IDs the 4-neighbour
+// auto-tiling left in each cell. "Ground" maps every mask to 200 + mask;
+// "Decor" has only -1 rules, so it must keep its tiles and lose only the
+// destroyed cells. Exits with 1 if any check fails.
+//
+//     terrain_retile_test
+
+#include "DestructibleTerrain.h"
+#include "TileLayerMesh.h"
+#include "Tilemap.h"
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+    const int MapSize = 8;
+    const int TileSize = 16;
+    const int GroundTop = 4;
+    const int PlacedTile = 100;
+    const int RuleBase = 200;
+
+    int failures = 0;
+    int checked = 0;
+
+    void expectTile(const TileLayerMesh& mesh, int x, int y, int expected, const std::string& step) {
+        checked++;
+        int tileId = mesh.getTile(x, y);
+        if (tileId != expected) {
+            std::cerr << "FAIL " << step << ": " << mesh.getName() << " (" << x << ", " << y << ") is "
+                << tileId << ", expected " << expected << std::endl;
+            failures++;
+        }
+    }
+
+    void expectCount(int count, int expected, const std::string& step) {
+        checked++;
+        if (count != expected) {
+            std::cerr << "FAIL " << step << ": changed " << count << " cells, expected " << expected << std::endl;
+            failures++;
+        }
+    }
+
+    void expectSolid(const Tilemap& tilemap, int x, int y, bool expected, const std::string& step) {
+        checked++;
+        if (tilemap.isTileCollidable(x, y) != expected) {
+            std::cerr << "FAIL " << step << ": collision at (" << x << ", " << y << ") is "
+                << !expected << ", expected " << expected << std::endl;
+            failures++;
+        }
+    }
+
+    sf::Vector2f cellCenter(int x, int y) {
+        return sf::Vector2f((x + 0.5f) * TileSize, (y + 0.5f) * TileSize);
+    }
+}
+
+int main() {
+    Tilemap tilemap(MapSize, MapSize);
+    tilemap.setTileSize(TileSize, TileSize);
+
+    std::vector<LayerTile> tiles;
+    for (int y = GroundTop; y < MapSize; ++y) {
+        for (int x = 0; x < MapSize; ++x) {
+            tilemap.setTileCollision(x, y, true);
+            tilemap.setTile(x, y, PlacedTile);
+            tiles.push_back({ PlacedTile, x * TileSize, y * TileSize, false, false });
+        }
+    }
+
+    TileLayerMesh ground("Ground", nullptr, TileSize, 16);
+    TileLayerMesh decor("Decor", nullptr, TileSize, 16);
+    for (TileLayerMesh* mesh : { &ground, &decor }) {
+        mesh->buildVertices(tiles, TileSize, MapSize, MapSize);
+        mesh->uploadChunks(std::numeric_limits<std::size_t>::max());
+    }
+
+    DestructibleTerrain::AutoTileRules groundRules;
+    DestructibleTerrain::AutoTileRules decorRules;
+    for (int mask = 0; mask < 16; ++mask) {
+        groundRules[mask] = RuleBase + mask;
+        decorRules[mask] = -1;
+    }
+
+    DestructibleTerrain terrain;
+    terrain.setRules("Ground", groundRules);
+    terrain.setRules("Decor", decorRules);
+    terrain.setTilemap(&tilemap);
+    if (!terrain.addLayer(&ground) || !terrain.addLayer(&decor)) {
+        std::cerr << "FAIL layers with rules were not registered" << std::endl;
+        return 1;
+    }
+
+    using N = DestructibleTerrain::Neighbour;
+
+    // A hole in the top row: its neighbours pick up the open sides, cells
+    // two away keep the tile they were placed with.
+    std::string step = "hole in the surface";
+    expectCount(terrain.destroyCircle(cellCenter(3, 4), TileSize * 0.5f), 1, step);
+    expectSolid(tilemap, 3, 4, false, step);
+    expectTile(ground, 3, 4, -1, step);
+    expectTile(ground, 2, 4, RuleBase + (N::South | N::West), step);
+    expectTile(ground, 4, 4, RuleBase + (N::East | N::South), step);
+    expectTile(ground, 3, 5, RuleBase + (N::East | N::South | N::West), step);
+    expectTile(ground, 1, 4, PlacedTile, step);
+    expectTile(ground, 3, 6, PlacedTile, step);
+    expectTile(decor, 3, 4, -1, step);
+    expectTile(decor, 2, 4, PlacedTile, step);
+    expectTile(decor, 3, 5, PlacedTile, step);
+
+    // On the map border the outside counts as solid.
+    step = "hole on the border";
+    expectCount(terrain.destroyCircle(cellCenter(6, 7), TileSize * 0.5f), 1, step);
+    expectTile(ground, 6, 7, -1, step);
+    expectTile(ground, 6, 6, RuleBase + (N::North | N::East | N::West), step);
+    expectTile(ground, 7, 7, RuleBase + (N::North | N::East | N::South), step);
+    expectTile(ground, 5, 7, RuleBase + (N::North | N::South | N::West), step);
+
+    // Refilling the first hole retiles it and its neighbours again.
+    step = "refilled hole";
+    expectCount(terrain.fillArea(sf::FloatRect(3.f * TileSize, 4.f * TileSize, TileSize, TileSize)), 1, step);
+    expectSolid(tilemap, 3, 4, true, step);
+    expectTile(ground, 3, 4, RuleBase + (N::East | N::South | N::West), step);
+    expectTile(ground, 2, 4, RuleBase + (N::East | N::South | N::West), step);
+    expectTile(ground, 4, 4, RuleBase + (N::East | N::South | N::West), step);
+    expectTile(ground, 3, 5, RuleBase + (N::North | N::East | N::South | N::West), step);
+    expectTile(decor, 3, 4, -1, step);
+
+    // Nothing solid left to destroy in the sky.
+    step = "empty area";
+    expectCount(terrain.destroyCircle(cellCenter(3, 1), TileSize * 2.0f), 0, step);
+
+    if (failures > 0) {
+        std::cerr << failures << " of " << checked << " terrain checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All " << checked << " terrain checks passed" << std::endl;
+    return 0;
+}
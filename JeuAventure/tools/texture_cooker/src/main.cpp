@@ -0,0 +1,135 @@
+// texture_cooker: fills the texture cache RessourceManager reads at startup
+// (see TextureCache.h) and reports, per image, how long decoding takes
+// compared with mapping the cached pixels.
+//
+//     texture_cooker <Ressources directory> [cache directory]
+
+#include "AssetArchiveFormat.h"
+#include "MappedFile.h"
+#include "TextureCache.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    bool isImage(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" ||
+            extension == ".bmp" || extension == ".tga";
+    }
+
+    bool readFile(const std::filesystem::path& path, std::vector<std::uint8_t>& contents) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input.is_open()) {
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: texture_cooker <Ressources directory> [cache directory]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path inputDir = argv[1];
+    if (!std::filesystem::is_directory(inputDir)) {
+        std::cerr << "Not a directory: " << inputDir << std::endl;
+        return 1;
+    }
+
+    TextureCache cache;
+    cache.setDirectory((argc > 2) ? std::filesystem::path(argv[2])
+        : inputDir.lexically_normal().parent_path() / "TextureCache");
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(inputDir)) {
+        if (item.is_regular_file() && isImage(item.path())) {
+            files.push_back(item.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    double totalDecode = 0.0;
+    double totalCached = 0.0;
+    std::size_t cooked = 0;
+    std::uint64_t cacheBytes = 0;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& file : files) {
+        std::string relative = std::filesystem::relative(file, inputDir).generic_string();
+
+        std::vector<std::uint8_t> contents;
+        if (!readFile(file, contents) || contents.empty()) {
+            std::cerr << "Could not read " << file << std::endl;
+            continue;
+        }
+        std::uint64_t sourceHash = AssetArchiveFormat::hashContent(contents.data(), contents.size());
+
+        // What loadTexture pays on a cache miss.
+        sf::Image image;
+        Clock::time_point start = Clock::now();
+        bool decoded = image.loadFromMemory(contents.data(), contents.size());
+        double decodeTime = millisecondsSince(start);
+        if (!decoded) {
+            std::cerr << "Could not decode " << relative << std::endl;
+            continue;
+        }
+
+        if (!cache.store(sourceHash, image)) {
+            std::cerr << "Could not write cache entry for " << relative << std::endl;
+            return 1;
+        }
+
+        // What it pays on a hit: map the entry and touch every pixel, as the
+        // upload would.
+        MappedFile mapping;
+        sf::Vector2u size;
+        const std::uint8_t* pixels = nullptr;
+        std::vector<std::uint8_t> upload;
+        start = Clock::now();
+        bool loaded = cache.load(sourceHash, mapping, size, pixels);
+        if (loaded) {
+            upload.assign(pixels, pixels + static_cast<std::size_t>(size.x) * size.y * 4);
+        }
+        double cachedTime = millisecondsSince(start);
+        if (!loaded || size != image.getSize() ||
+            std::memcmp(upload.data(), image.getPixelsPtr(), upload.size()) != 0) {
+            std::cerr << "Cache entry for " << relative << " does not match the decoded image" << std::endl;
+            return 1;
+        }
+
+        cooked++;
+        cacheBytes += mapping.getSize();
+        totalDecode += decodeTime;
+        totalCached += cachedTime;
+
+        std::cout << relative << ": " << size.x << "x" << size.y << ", decode " << decodeTime
+            << " ms, cache " << cachedTime << " ms, saved " << decodeTime - cachedTime << " ms" << std::endl;
+    }
+
+    std::cout << "Cooked " << cooked << " of " << files.size() << " images into " << cache.getDirectory()
+        << " (" << cacheBytes / 1024 << " KB)" << std::endl;
+    std::cout << "Decode " << totalDecode << " ms, cache " << totalCached << " ms, saved "
+        << totalDecode - totalCached << " ms per cold start" << std::endl;
+    return 0;
+}
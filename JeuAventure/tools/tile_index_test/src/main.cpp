@@ -0,0 +1,103 @@
+// tile_index_test: checks that a tile drawn through the index texture
+// (TileIndexMap::encode, then the shader arithmetic mirrored by lookup)
+// samples the same tileset pixels as its quad built by
+// TileLayerMesh::setTileTexCoords, including the flip bits and MaxTileId.
+// Exits with 1 on the first mismatch.
+//
+//     tile_index_test
+
+#include "TileIndexMap.h"
+#include "TileLayerMesh.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    int failures = 0;
+
+    void fail(const std::string& what, int tileId, bool flipX, bool flipY) {
+        std::cerr << "FAIL " << what << " (tile " << tileId << ", flipX " << flipX << ", flipY " << flipY << ")" << std::endl;
+        failures++;
+    }
+
+    void checkTile(const TileLayerMesh& mesh, int columns, int tileSize, int tileId, bool flipX, bool flipY) {
+        std::uint8_t texel[4] = {};
+        if (!TileIndexMap::encode(tileId, flipX, flipY, texel)) {
+            fail("encode rejected a valid tile", tileId, flipX, flipY);
+            return;
+        }
+
+        int decodedId = -1;
+        bool decodedFlipX = false;
+        bool decodedFlipY = false;
+        if (!TileIndexMap::decode(texel, decodedId, decodedFlipX, decodedFlipY) ||
+            decodedId != tileId || decodedFlipX != flipX || decodedFlipY != flipY) {
+            fail("decode does not round-trip", tileId, flipX, flipY);
+            return;
+        }
+
+        sf::Vertex quad[4];
+        mesh.setTileTexCoords(quad, tileId, flipX, flipY);
+
+        // Quad corners, clockwise from the top left, as cell-local points.
+        const sf::Vector2f corners[4] = {
+            sf::Vector2f(0.f, 0.f), sf::Vector2f(1.f, 0.f),
+            sf::Vector2f(1.f, 1.f), sf::Vector2f(0.f, 1.f)
+        };
+        for (int i = 0; i < 4; ++i) {
+            sf::Vector2f pixel;
+            if (!TileIndexMap::lookup(texel, corners[i], columns, tileSize, pixel) || pixel != quad[i].texCoords) {
+                fail("lookup differs from the quad at corner " + std::to_string(i), tileId, flipX, flipY);
+                return;
+            }
+        }
+    }
+}
+
+int main() {
+    const int columns = 16;
+    const int tileSize = 16;
+    TileLayerMesh mesh("tile_index_test", nullptr, tileSize, columns);
+
+    const std::vector<int> tileIds = {
+        0, 1, columns - 1, columns, columns + 1, 255, 256, 1000,
+        TileIndexMap::MaxTileId - 1, TileIndexMap::MaxTileId
+    };
+
+    int checked = 0;
+    for (int tileId : tileIds) {
+        for (int flags = 0; flags < 4; ++flags) {
+            checkTile(mesh, columns, tileSize, tileId, (flags & 1) != 0, (flags & 2) != 0);
+            checked++;
+        }
+    }
+
+    std::uint8_t texel[4] = {};
+    if (TileIndexMap::encode(TileIndexMap::MaxTileId + 1, false, false, texel)) {
+        fail("encode accepted MaxTileId + 1", TileIndexMap::MaxTileId + 1, false, false);
+    }
+    if (TileIndexMap::encode(-1, false, false, texel)) {
+        fail("encode accepted a negative tile", -1, false, false);
+    }
+
+    std::uint8_t empty[4] = { 0, 0, 0, 0 };
+    int tileId = 0;
+    bool flipX = false;
+    bool flipY = false;
+    sf::Vector2f pixel;
+    if (TileIndexMap::decode(empty, tileId, flipX, flipY) ||
+        TileIndexMap::lookup(empty, sf::Vector2f(0.5f, 0.5f), columns, tileSize, pixel)) {
+        fail("empty texel decoded as a tile", 0, false, false);
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " of " << checked << " tile checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All " << checked << " tile checks passed" << std::endl;
+    return 0;
+}